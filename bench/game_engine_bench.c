@@ -0,0 +1,139 @@
+// bench/game_engine_bench.c
+// 터미널 없이 게임 엔진만 가상 시계로 돌려 스텝 처리 속도를 측정
+//
+//   $ make bench && ./bin/game_engine_bench [스텝 수] [시드]
+//
+// -Wl,--wrap=malloc,--wrap=pthread_mutex_lock 으로 링크하여
+// 엔진이 스텝마다 하는 메모리 할당 / 락 획득 횟수를 센다.
+// 같은 시드면 항상 같은 결과(점수 합계)가 나와야 한다.
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "game_engine.h"
+
+#define DEFAULT_TICK_COUNT 5000000L
+#define DEFAULT_SEED 12345u
+#define DICTIONARY_SIZE 256
+#define AREA_WIDTH 78
+#define AREA_HEIGHT 22
+#define KEY_INTERVAL_TICKS 15 /* 자동 입력: 150ms 마다 한 글자 */
+
+static unsigned long malloc_calls = 0;
+static unsigned long lock_calls = 0;
+
+void* __real_malloc(size_t size);
+int __real_pthread_mutex_lock(pthread_mutex_t* mutex);
+
+void* __wrap_malloc(size_t size) {
+  malloc_calls++;
+  return __real_malloc(size);
+}
+
+int __wrap_pthread_mutex_lock(pthread_mutex_t* mutex) {
+  lock_calls++;
+  return __real_pthread_mutex_lock(mutex);
+}
+
+static double now_sec(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// 길이 3~12 의 서로 다른 소문자 단어 생성
+static void build_dictionary(char* words[], char storage[][MAX_WORD_LEN]) {
+  for (int i = 0; i < DICTIONARY_SIZE; i++) {
+    int len = 3 + i % 10;
+    unsigned int v = (unsigned int)i * 2654435761u;
+    for (int j = 0; j < len; j++) {
+      storage[i][j] = 'a' + (v >> (j % 8) * 3) % 26;
+    }
+    snprintf(storage[i] + len, MAX_WORD_LEN - len, "%d", i);  // 중복 방지
+    words[i] = storage[i];
+  }
+}
+
+/*
+ * 스크립트 입력: 가장 아래에 있는 NORMAL/BONUS 단어를 골라 한 글자씩 입력하고 Enter
+ * (KILL 단어는 맞추면 게임이 끝나므로 피함)
+ */
+typedef struct {
+  char target[MAX_WORD_LEN];
+  int typed;
+  int cooldown;
+} AutoTyper;
+
+static void auto_type(GameEngine* engine, AutoTyper* typer) {
+  if (--typer->cooldown > 0) return;
+  typer->cooldown = KEY_INTERVAL_TICKS;
+
+  if (typer->target[0] == '\0') {
+    int best = -1;
+    for (int i = 0; i < MAX_WORDS; i++) {
+      const Word* w = &engine->words[i];
+      if (w->active && w->wtype != WORD_KILL && (best == -1 || w->y > engine->words[best].y)) best = i;
+    }
+    if (best == -1) return;
+    memcpy(typer->target, engine->words[best].text, MAX_WORD_LEN);
+    typer->typed = 0;
+  }
+
+  if (typer->target[typer->typed] != '\0') {
+    game_engine_input(engine, typer->target[typer->typed++]);
+  } else {
+    game_engine_input(engine, '\n');
+    typer->target[0] = '\0';
+  }
+}
+
+int main(int argc, char* argv[]) {
+  long ticks = (argc > 1) ? atol(argv[1]) : DEFAULT_TICK_COUNT;
+  if (ticks <= 0) ticks = DEFAULT_TICK_COUNT;
+  unsigned int seed = (argc > 2) ? (unsigned int)strtoul(argv[2], NULL, 10) : DEFAULT_SEED;
+
+  static char storage[DICTIONARY_SIZE][MAX_WORD_LEN];
+  char* dictionary[DICTIONARY_SIZE];
+  build_dictionary(dictionary, storage);
+
+  if (!init_active_word_table()) {
+    fprintf(stderr, "init_active_word_table failed\n");
+    return EXIT_FAILURE;
+  }
+
+  GameEngine engine;
+  AutoTyper typer = {{0}, 0, 1};
+  unsigned long games = 1;
+  unsigned long long score_sum = 0;
+  game_engine_init(&engine, AREA_WIDTH, AREA_HEIGHT, seed, dictionary, DICTIONARY_SIZE);
+
+  malloc_calls = lock_calls = 0;
+  double start = now_sec();
+  for (long t = 0; t < ticks; t++) {
+    auto_type(&engine, &typer);
+    game_engine_advance(&engine, SIM_TICK_MS, 0);
+
+    if (engine.over) {
+      score_sum += engine.score;
+      game_engine_clear(&engine);
+      game_engine_init(&engine, AREA_WIDTH, AREA_HEIGHT, seed + (unsigned int)games, dictionary, DICTIONARY_SIZE);
+      typer.target[0] = '\0';
+      games++;
+    }
+  }
+  double elapsed = now_sec() - start;
+  score_sum += engine.score;
+  game_engine_clear(&engine);
+  cleanup_active_word_table();
+
+  printf("=== game engine benchmark (%ld ticks, seed %u) ===\n", ticks, seed);
+  printf("simulated      : %.1f min of game time, %lu games\n", ticks * (double)SIM_TICK_MS / 60000.0, games);
+  printf("wall time      : %.3f s\n", elapsed);
+  printf("ticks/sec      : %.0f\n", elapsed > 0 ? ticks / elapsed : 0.0);
+  printf("malloc()       : %lu (%.4f per tick)\n", malloc_calls, (double)malloc_calls / ticks);
+  printf("mutex locks    : %lu (%.4f per tick)\n", lock_calls, (double)lock_calls / ticks);
+  printf("score checksum : %llu\n", score_sum);
+  return EXIT_SUCCESS;
+}
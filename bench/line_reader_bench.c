@@ -0,0 +1,164 @@
+// bench/line_reader_bench.c
+// 바이트 단위 read() 줄 읽기 vs LineReader 블록 읽기 비교
+//
+//   $ make bench && ./bin/line_reader_bench [줄 수]
+//
+// -Wl,--wrap=read 로 링크하여 실제 read() 시스템 콜 횟수를 센다.
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "line_reader.h"
+
+#define DEFAULT_LINE_COUNT 100000
+
+static unsigned long read_calls = 0;
+
+ssize_t __real_read(int fd, void* buf, size_t count);
+
+ssize_t __wrap_read(int fd, void* buf, size_t count) {
+  read_calls++;
+  return __real_read(fd, buf, count);
+}
+
+static double now_sec(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// 기존 db_handler.c / word_manager.c 의 한 바이트씩 읽는 방식
+static ssize_t legacy_read_line(int fd, char* buffer, size_t buffer_size) {
+  size_t pos = 0;
+  char ch;
+  ssize_t bytes_read;
+
+  while (pos < buffer_size - 1) {
+    bytes_read = read(fd, &ch, 1);
+    if (bytes_read == 0) {
+      if (pos == 0) return 0;
+      break;
+    }
+    if (bytes_read < 0) {
+      return -1;
+    }
+    if (ch == '\n') {
+      break;
+    }
+    buffer[pos++] = ch;
+  }
+
+  buffer[pos] = '\0';
+  return pos;
+}
+
+// username:score 형식의 테스트 파일 생성
+static int write_sample_file(char* path_template, int lines) {
+  int fd = mkstemp(path_template);
+  if (fd == -1) {
+    perror("mkstemp");
+    return -1;
+  }
+  FILE* fp = fdopen(fd, "w");
+  if (!fp) {
+    perror("fdopen");
+    close(fd);
+    return -1;
+  }
+  for (int i = 0; i < lines; i++) {
+    fprintf(fp, "player%05d:%d\n", i % 5000, (i * 7919) % 1000);
+  }
+  fclose(fp);
+  return 0;
+}
+
+typedef struct {
+  unsigned long lines;
+  unsigned long long checksum;
+  unsigned long syscalls;
+  double seconds;
+} BenchResult;
+
+static int run_legacy(const char* path, BenchResult* result) {
+  int fd = open(path, O_RDONLY);
+  if (fd == -1) return -1;
+
+  char line[64];
+  memset(result, 0, sizeof(*result));
+  read_calls = 0;
+  double start = now_sec();
+  while (legacy_read_line(fd, line, sizeof(line)) > 0) {
+    char* colon = strchr(line, ':');
+    if (colon) result->checksum += strtol(colon + 1, NULL, 10);
+    result->lines++;
+  }
+  result->seconds = now_sec() - start;
+  result->syscalls = read_calls;
+  close(fd);
+  return 0;
+}
+
+static int run_buffered(const char* path, BenchResult* result) {
+  int fd = open(path, O_RDONLY);
+  if (fd == -1) return -1;
+
+  LineReader reader;
+  if (line_reader_init(&reader, fd, 0) != 0) {
+    close(fd);
+    return -1;
+  }
+
+  char* line;
+  size_t len;
+  memset(result, 0, sizeof(*result));
+  read_calls = 0;
+  double start = now_sec();
+  while (line_reader_next(&reader, &line, &len) > 0) {
+    char* colon = strchr(line, ':');
+    if (colon) result->checksum += strtol(colon + 1, NULL, 10);
+    result->lines++;
+  }
+  result->seconds = now_sec() - start;
+  result->syscalls = read_calls;
+  line_reader_free(&reader);
+  close(fd);
+  return 0;
+}
+
+static void print_result(const char* name, const BenchResult* r) {
+  printf("%-22s lines=%-8lu read()=%-9lu time=%8.3f ms  checksum=%llu\n", name, r->lines, r->syscalls, r->seconds * 1000.0, r->checksum);
+}
+
+int main(int argc, char* argv[]) {
+  int lines = (argc > 1) ? atoi(argv[1]) : DEFAULT_LINE_COUNT;
+  if (lines <= 0) lines = DEFAULT_LINE_COUNT;
+
+  char path[] = "/tmp/rain_line_reader_benchXXXXXX";
+  if (write_sample_file(path, lines) != 0) {
+    return EXIT_FAILURE;
+  }
+
+  BenchResult legacy, buffered;
+  if (run_legacy(path, &legacy) != 0 || run_buffered(path, &buffered) != 0) {
+    perror("benchmark");
+    unlink(path);
+    return EXIT_FAILURE;
+  }
+  unlink(path);
+
+  printf("=== line reader benchmark (%d lines) ===\n", lines);
+  print_result("legacy read(fd, &ch, 1)", &legacy);
+  print_result("LineReader (64 KB)", &buffered);
+  if (buffered.seconds > 0) {
+    printf("speedup: %.1fx, syscalls: %lu -> %lu\n", legacy.seconds / buffered.seconds, legacy.syscalls, buffered.syscalls);
+  }
+
+  if (legacy.lines != buffered.lines || legacy.checksum != buffered.checksum) {
+    fprintf(stderr, "MISMATCH between readers!\n");
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,453 @@
+// bench/rain_bench.c
+// rain_server 부하 생성기: N 개 연결로 메시지 조합을 보내고 타입별 처리량/지연 시간을 측정
+//
+//   $ make bench && ./bin/rain_bench -c 64 -t 4 -d 10 -m score=4,leaderboard=4,wordlist=1
+//
+// 연결마다 요청을 하나씩 보내고 응답을 받으면 다음 요청을 보낸다 (closed loop).
+// 지연 시간은 요청 전송 직전부터 응답 전체 수신까지 (마이크로초).
+#define _GNU_SOURCE
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "latency_histogram.h"
+#include "protocol.h"
+
+#define DEFAULT_HOST "127.0.0.1"
+#define DEFAULT_PORT 8080
+#define DEFAULT_CONNECTIONS 32
+#define DEFAULT_THREADS 2
+#define DEFAULT_DURATION_SEC 10
+#define DEFAULT_MIX "register=1,login=2,score=4,leaderboard=4,wordlist=1"
+#define MAX_BENCH_THREADS 64
+#define RESPONSE_BUF_SIZE (sizeof(MessageHeader) + 65536)
+#define BENCH_PASSWORD_HASH "5e884898da28047151d0e56f8dc6292773603d0d6aabbdd62a11ef721d1542d8" /* "password" */
+
+/* 측정 대상 요청 종류 */
+typedef enum { OP_REGISTER = 0, OP_LOGIN, OP_SCORE, OP_LEADERBOARD, OP_WORDLIST, OP_LOGOUT, OP_COUNT } BenchOp;
+
+static const char* op_names[OP_COUNT] = {"register", "login", "score", "leaderboard", "wordlist", "logout"};
+
+typedef struct {
+  const char* host;
+  int port;
+  int connections;
+  int threads;
+  int duration_sec;
+  int weights[OP_COUNT]; /* logout 은 login 앞에 자동으로 끼워 넣으므로 가중치 없음 */
+  int weight_total;
+} BenchConfig;
+
+typedef struct {
+  LatencyHistogram hist;
+  uint64_t ok;
+  uint64_t failed; /* 응답의 success 필드가 0 */
+} OpStats;
+
+typedef struct {
+  int fd;
+  char username[MAX_ID_LEN];
+  bool logged_in;
+  unsigned long seq; /* register 용 고유 이름 생성 */
+
+  BenchOp pending_op;
+  BenchOp next_op; /* logout 후 이어서 보낼 login */
+  bool has_next_op;
+  uint64_t sent_at_us;
+
+  char out[sizeof(MessageHeader) + sizeof(RegisterRequest)];
+  size_t out_len;
+  size_t out_sent;
+
+  char* in;
+  size_t in_len;
+} BenchConn;
+
+typedef struct {
+  int index;
+  pthread_t tid;
+  const BenchConfig* config;
+  BenchConn* conns;
+  int conn_count;
+  uint32_t rng_state;
+  OpStats stats[OP_COUNT];
+  uint64_t errors; /* 연결 끊김 등 */
+} BenchThread;
+
+static uint64_t now_us(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static uint32_t bench_rand(BenchThread* thread) {
+  uint32_t x = thread->rng_state;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  thread->rng_state = x;
+  return x;
+}
+
+// "score=4,leaderboard=1" 형식 파싱
+static int parse_mix(const char* spec, BenchConfig* config) {
+  memset(config->weights, 0, sizeof(config->weights));
+  char* copy = strdup(spec);
+  if (!copy) return -1;
+
+  char* saveptr = NULL;
+  for (char* item = strtok_r(copy, ",", &saveptr); item; item = strtok_r(NULL, ",", &saveptr)) {
+    char* eq = strchr(item, '=');
+    int weight = eq ? atoi(eq + 1) : 1;
+    if (eq) *eq = '\0';
+
+    int op = -1;
+    for (int i = 0; i < OP_LOGOUT; i++) {
+      if (strcmp(item, op_names[i]) == 0) op = i;
+    }
+    if (op == -1 || weight < 0) {
+      fprintf(stderr, "unknown mix entry '%s' (use register, login, score, leaderboard, wordlist)\n", item);
+      free(copy);
+      return -1;
+    }
+    config->weights[op] = weight;
+  }
+  free(copy);
+
+  config->weight_total = 0;
+  for (int i = 0; i < OP_COUNT; i++) config->weight_total += config->weights[i];
+  return config->weight_total > 0 ? 0 : -1;
+}
+
+static BenchOp pick_op(BenchThread* thread) {
+  int r = bench_rand(thread) % thread->config->weight_total;
+  for (int i = 0; i < OP_COUNT; i++) {
+    if (r < thread->config->weights[i]) return (BenchOp)i;
+    r -= thread->config->weights[i];
+  }
+  return OP_LEADERBOARD;
+}
+
+static void build_request(BenchConn* conn, MessageType type, const void* body, size_t body_len) {
+  MessageHeader header;
+  header.type = type;
+  header.length = body_len;
+  memcpy(conn->out, &header, sizeof(header));
+  if (body_len > 0) memcpy(conn->out + sizeof(header), body, body_len);
+  conn->out_len = sizeof(header) + body_len;
+  conn->out_sent = 0;
+}
+
+static void build_op(BenchThread* thread, BenchConn* conn, BenchOp op) {
+  RegisterRequest cred;
+  memset(&cred, 0, sizeof(cred));
+  snprintf(cred.password, MAX_PW_LEN, "%s", BENCH_PASSWORD_HASH);
+
+  switch (op) {
+    case OP_REGISTER:
+      snprintf(cred.username, MAX_ID_LEN, "%.20s_r%lu", conn->username, conn->seq++);
+      build_request(conn, MSG_TYPE_REGISTER_REQ, &cred, sizeof(cred));
+      break;
+    case OP_LOGIN:
+      snprintf(cred.username, MAX_ID_LEN, "%s", conn->username);
+      build_request(conn, MSG_TYPE_LOGIN_REQ, &cred, sizeof(cred));
+      break;
+    case OP_SCORE: {
+      ScoreSubmitRequest req = {(int)(bench_rand(thread) % 1000)};
+      build_request(conn, MSG_TYPE_SCORE_SUBMIT_REQ, &req, sizeof(req));
+      break;
+    }
+    case OP_LEADERBOARD:
+      build_request(conn, MSG_TYPE_LEADERBOARD_REQ, NULL, 0);
+      break;
+    case OP_WORDLIST:
+      build_request(conn, MSG_TYPE_WORDLIST_REQ, NULL, 0);
+      break;
+    case OP_LOGOUT:
+    default:
+      build_request(conn, MSG_TYPE_LOGOUT_REQ, NULL, 0);
+      break;
+  }
+  conn->pending_op = op;
+}
+
+// 이미 로그인된 연결의 login 은 서버가 거절하므로 logout 을 먼저 보냄
+static void start_next_request(BenchThread* thread, BenchConn* conn) {
+  BenchOp op;
+  if (conn->has_next_op) {
+    op = conn->next_op;
+    conn->has_next_op = false;
+  } else {
+    op = pick_op(thread);
+    if (op == OP_LOGIN && conn->logged_in) {
+      conn->next_op = OP_LOGIN;
+      conn->has_next_op = true;
+      op = OP_LOGOUT;
+    }
+  }
+  build_op(thread, conn, op);
+  conn->sent_at_us = now_us();
+}
+
+static int flush_request(BenchConn* conn) {
+  while (conn->out_sent < conn->out_len) {
+    ssize_t n = send(conn->fd, conn->out + conn->out_sent, conn->out_len - conn->out_sent, MSG_NOSIGNAL);
+    if (n == -1) {
+      if (errno == EINTR) continue;
+      if (errno == EAGAIN || errno == EWOULDBLOCK) return 0;
+      return -1;
+    }
+    conn->out_sent += n;
+  }
+  return 0;
+}
+
+// 응답 하나 처리: 지연 시간 기록 + 성공 여부 + 로그인 상태 추적
+static void complete_response(BenchThread* thread, BenchConn* conn, const MessageHeader* header, const char* body) {
+  uint64_t latency = now_us() - conn->sent_at_us;
+  OpStats* stats = &thread->stats[conn->pending_op];
+  latency_hist_record(&stats->hist, latency);
+
+  bool success = true;
+  if (header->type == MSG_TYPE_ERROR) {
+    success = false;
+  } else if (header->type != MSG_TYPE_LEADERBOARD_RESP && header->type != MSG_TYPE_WORDLIST_RESP && header->length >= sizeof(int)) {
+    int flag;
+    memcpy(&flag, body, sizeof(int));
+    success = flag != 0;
+  }
+  if (success) {
+    stats->ok++;
+  } else {
+    stats->failed++;
+  }
+
+  if (conn->pending_op == OP_LOGIN && success) conn->logged_in = true;
+  if (conn->pending_op == OP_LOGOUT) conn->logged_in = false;
+}
+
+// 수신 버퍼에서 완성된 응답을 꺼냄, 응답을 받았으면 1
+static int consume_response(BenchThread* thread, BenchConn* conn) {
+  if (conn->in_len < sizeof(MessageHeader)) return 0;
+  MessageHeader header;
+  memcpy(&header, conn->in, sizeof(header));
+  size_t frame_len = sizeof(header) + header.length;
+  if (conn->in_len < frame_len) return 0;
+
+  complete_response(thread, conn, &header, conn->in + sizeof(header));
+  memmove(conn->in, conn->in + frame_len, conn->in_len - frame_len);
+  conn->in_len -= frame_len;
+  return 1;
+}
+
+// 블로킹 소켓으로 요청 하나를 보내고 응답 성공 여부 반환 (준비 단계 전용)
+static int blocking_call(BenchConn* conn, MessageType type, const void* body, size_t body_len) {
+  build_request(conn, type, body, body_len);
+  if (send(conn->fd, conn->out, conn->out_len, MSG_NOSIGNAL) != (ssize_t)conn->out_len) return -1;
+
+  MessageHeader header;
+  if (recv(conn->fd, &header, sizeof(header), MSG_WAITALL) != sizeof(header)) return -1;
+  char body_buf[65536];
+  if (header.length > 0 && recv(conn->fd, body_buf, header.length, MSG_WAITALL) != header.length) return -1;
+  int flag = 0;
+  if (header.length >= sizeof(int)) memcpy(&flag, body_buf, sizeof(int));
+  return flag;
+}
+
+// 연결 + 전용 계정 등록/로그인 (score 요청이 로그인된 세션을 필요로 함)
+static int setup_connection(const BenchConfig* config, BenchConn* conn, int thread_index, int conn_index) {
+  struct sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(config->port);
+  if (inet_pton(AF_INET, config->host, &addr.sin_addr) != 1) return -1;
+
+  conn->fd = socket(AF_INET, SOCK_STREAM, 0);
+  if (conn->fd == -1) return -1;
+  if (connect(conn->fd, (struct sockaddr*)&addr, sizeof(addr)) == -1) {
+    close(conn->fd);
+    conn->fd = -1;
+    return -1;
+  }
+  int one = 1;
+  setsockopt(conn->fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+  snprintf(conn->username, MAX_ID_LEN, "bench%d_%d_%d", (int)getpid() % 100000, thread_index, conn_index);
+  RegisterRequest cred;
+  memset(&cred, 0, sizeof(cred));
+  snprintf(cred.username, MAX_ID_LEN, "%s", conn->username);
+  snprintf(cred.password, MAX_PW_LEN, "%s", BENCH_PASSWORD_HASH);
+  if (blocking_call(conn, MSG_TYPE_REGISTER_REQ, &cred, sizeof(cred)) < 0) return -1;
+  int logged_in = blocking_call(conn, MSG_TYPE_LOGIN_REQ, &cred, sizeof(cred));
+  if (logged_in < 0) return -1;
+  conn->logged_in = logged_in != 0;
+
+  conn->in = malloc(RESPONSE_BUF_SIZE);
+  if (!conn->in) return -1;
+  fcntl(conn->fd, F_SETFL, fcntl(conn->fd, F_GETFL, 0) | O_NONBLOCK);
+  return 0;
+}
+
+static void* bench_thread_func(void* arg) {
+  BenchThread* thread = (BenchThread*)arg;
+  int epoll_fd = epoll_create1(0);
+  if (epoll_fd == -1) {
+    perror("epoll_create1");
+    return NULL;
+  }
+
+  for (int i = 0; i < thread->conn_count; i++) {
+    BenchConn* conn = &thread->conns[i];
+    struct epoll_event ev = {.events = EPOLLIN, .data.ptr = conn};
+    epoll_ctl(epoll_fd, EPOLL_CTL_ADD, conn->fd, &ev);
+    start_next_request(thread, conn);
+    if (flush_request(conn) != 0) thread->errors++;
+  }
+
+  uint64_t deadline = now_us() + (uint64_t)thread->config->duration_sec * 1000000;
+  struct epoll_event events[256];
+  while (now_us() < deadline) {
+    int n = epoll_wait(epoll_fd, events, 256, 100);
+    for (int i = 0; i < n; i++) {
+      BenchConn* conn = events[i].data.ptr;
+      if (conn->fd == -1) continue;
+
+      ssize_t r = recv(conn->fd, conn->in + conn->in_len, RESPONSE_BUF_SIZE - conn->in_len, 0);
+      if (r <= 0) {
+        if (r == -1 && (errno == EAGAIN || errno == EINTR)) continue;
+        thread->errors++;
+        epoll_ctl(epoll_fd, EPOLL_CTL_DEL, conn->fd, NULL);
+        close(conn->fd);
+        conn->fd = -1;
+        continue;
+      }
+      conn->in_len += r;
+
+      if (consume_response(thread, conn)) {
+        start_next_request(thread, conn);
+        if (flush_request(conn) != 0) thread->errors++;
+      }
+    }
+  }
+
+  close(epoll_fd);
+  return NULL;
+}
+
+static void usage(const char* prog) {
+  fprintf(stderr,
+          "usage: %s [-h host] [-p port] [-c connections] [-t threads] [-d seconds] [-m mix]\n"
+          "  mix: comma separated op=weight, ops: register, login, score, leaderboard, wordlist\n"
+          "       (default: %s)\n",
+          prog, DEFAULT_MIX);
+}
+
+int main(int argc, char* argv[]) {
+  BenchConfig config = {DEFAULT_HOST, DEFAULT_PORT, DEFAULT_CONNECTIONS, DEFAULT_THREADS, DEFAULT_DURATION_SEC, {0}, 0};
+  const char* mix = DEFAULT_MIX;
+
+  int opt;
+  while ((opt = getopt(argc, argv, "h:p:c:t:d:m:")) != -1) {
+    switch (opt) {
+      case 'h': config.host = optarg; break;
+      case 'p': config.port = atoi(optarg); break;
+      case 'c': config.connections = atoi(optarg); break;
+      case 't': config.threads = atoi(optarg); break;
+      case 'd': config.duration_sec = atoi(optarg); break;
+      case 'm': mix = optarg; break;
+      default: usage(argv[0]); return EXIT_FAILURE;
+    }
+  }
+  if (config.connections <= 0 || config.threads <= 0 || config.duration_sec <= 0 || parse_mix(mix, &config) != 0) {
+    usage(argv[0]);
+    return EXIT_FAILURE;
+  }
+  if (config.threads > MAX_BENCH_THREADS) config.threads = MAX_BENCH_THREADS;
+  if (config.threads > config.connections) config.threads = config.connections;
+
+  static BenchThread threads[MAX_BENCH_THREADS];
+  BenchConn* conns = calloc(config.connections, sizeof(BenchConn));
+  if (!conns) {
+    perror("calloc");
+    return EXIT_FAILURE;
+  }
+
+  // 연결 분배 및 준비 (등록 + 로그인)
+  int not_logged_in = 0;
+  int offset = 0;
+  for (int t = 0; t < config.threads; t++) {
+    BenchThread* thread = &threads[t];
+    thread->index = t;
+    thread->config = &config;
+    thread->rng_state = 0x9E3779B9u ^ (uint32_t)(t + 1) * 2654435761u;
+    thread->conns = conns + offset;
+    thread->conn_count = config.connections / config.threads + (t < config.connections % config.threads ? 1 : 0);
+    for (int op = 0; op < OP_COUNT; op++) latency_hist_init(&thread->stats[op].hist);
+
+    for (int i = 0; i < thread->conn_count; i++) {
+      if (setup_connection(&config, &thread->conns[i], t, i) != 0) {
+        fprintf(stderr, "failed to set up connection %d to %s:%d: %s\n", offset + i, config.host, config.port, strerror(errno));
+        return EXIT_FAILURE;
+      }
+      if (!thread->conns[i].logged_in) not_logged_in++;
+    }
+    offset += thread->conn_count;
+  }
+  if (not_logged_in > 0) {
+    fprintf(stderr, "warning: %d connections could not log in (score submits on them will fail)\n", not_logged_in);
+  }
+
+  printf("=== rain_bench: %s:%d, %d connections, %d threads, %d s, mix %s ===\n", config.host, config.port, config.connections, config.threads,
+         config.duration_sec, mix);
+
+  uint64_t start = now_us();
+  for (int t = 0; t < config.threads; t++) {
+    pthread_create(&threads[t].tid, NULL, bench_thread_func, &threads[t]);
+  }
+  uint64_t errors = 0;
+  for (int t = 0; t < config.threads; t++) {
+    pthread_join(threads[t].tid, NULL);
+    errors += threads[t].errors;
+  }
+  double elapsed = (now_us() - start) / 1e6;
+
+  // 스레드별 결과 합산 후 출력
+  printf("%-12s %10s %10s %8s %10s %10s %10s %10s\n", "op", "count", "req/s", "failed", "p50(us)", "p99(us)", "p999(us)", "max(us)");
+  uint64_t total = 0;
+  for (int op = 0; op < OP_COUNT; op++) {
+    OpStats merged;
+    memset(&merged, 0, sizeof(merged));
+    for (int t = 0; t < config.threads; t++) {
+      latency_hist_merge(&merged.hist, &threads[t].stats[op].hist);
+      merged.ok += threads[t].stats[op].ok;
+      merged.failed += threads[t].stats[op].failed;
+    }
+    if (merged.hist.total == 0) continue;
+    total += merged.hist.total;
+    printf("%-12s %10lu %10.0f %8lu %10lu %10lu %10lu %10lu\n", op_names[op], (unsigned long)merged.hist.total, merged.hist.total / elapsed,
+           (unsigned long)merged.failed, (unsigned long)latency_hist_percentile(&merged.hist, 50.0),
+           (unsigned long)latency_hist_percentile(&merged.hist, 99.0), (unsigned long)latency_hist_percentile(&merged.hist, 99.9),
+           (unsigned long)merged.hist.max);
+  }
+  printf("total: %lu requests in %.2f s = %.0f req/s, connection errors: %lu\n", (unsigned long)total, elapsed, total / elapsed,
+         (unsigned long)errors);
+
+  for (int i = 0; i < config.connections; i++) {
+    if (conns[i].fd != -1) close(conns[i].fd);
+    free(conns[i].in);
+  }
+  free(conns);
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,313 @@
+// bench/storage_bench.c
+// 저장소 백엔드 비교: 같은 작업을 StorageEngine 인터페이스로만 돌려 백엔드별 처리량을 측정
+//
+//   $ make bench && ./bin/storage_bench [-e text,log] [-u users] [-l lookups] [-t threads] [-s scores] [-b batch] [-y sync] [-d dir]
+//
+// 서버의 작업 패턴을 그대로 따른다:
+//   register  회원가입 (사용자마다 기록 + fsync)
+//   lookup    로그인 조회 (여러 스레드 동시, 10% 는 없는 사용자)
+//   append    점수 제출 (WAL 처럼 batch 개씩 묶어 한 번의 기록 + 동기화)
+//   scan      시작 시 점수 로그 전체 재생
+//   reopen    재시작 (사용자 인덱스 재구성 + 점수 로그 꼬리 확인)
+// 백엔드마다 scan 결과(개수, 점수 합)가 같아야 한다.
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "server_metrics.h"
+#include "storage_engine.h"
+
+#define DEFAULT_ENGINES "text,log"
+#define DEFAULT_USERS 2000
+#define DEFAULT_LOOKUPS 2000000
+#define DEFAULT_THREADS 4
+#define DEFAULT_SCORES 1000000
+#define DEFAULT_BATCH 64
+#define DEFAULT_DIR "/tmp"
+#define MAX_BENCH_THREADS 64
+#define MAX_ENGINES 8
+#define BENCH_PASSWORD_HASH "5e884898da28047151d0e56f8dc6292773603d0d6aabbdd62a11ef721d1542d8" /* "password" */
+
+typedef struct {
+  int users;
+  long lookups;
+  int threads;
+  long scores;
+  int batch;
+  DbSyncMode sync_mode;
+  const char* dir;
+} BenchConfig;
+
+typedef struct {
+  const char* name;
+  double register_sec;
+  double lookup_sec;
+  double append_sec;
+  double scan_sec;
+  double reopen_sec;
+  long found;
+  long scanned;
+  long long score_sum;
+  uint64_t log_size;
+  off_t disk_bytes;
+} EngineResult;
+
+static double now_sec(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static uint32_t next_rand(uint32_t* state) {
+  *state ^= *state << 13;
+  *state ^= *state >> 17;
+  *state ^= *state << 5;
+  return *state;
+}
+
+static void make_username(char* out, int index) { snprintf(out, MAX_ID_LEN, "bench%06d", index); }
+
+typedef struct {
+  const StorageEngine* engine;
+  void* state;
+  const BenchConfig* config;
+  int index;
+  long found;
+  pthread_t tid;
+} LookupThread;
+
+static void* lookup_thread_func(void* arg) {
+  LookupThread* thread = (LookupThread*)arg;
+  uint32_t rng = 0x9E3779B9u ^ (uint32_t)(thread->index + 1) * 2654435761u;
+  long count = thread->config->lookups / thread->config->threads;
+  int range = thread->config->users + thread->config->users / 9;  // 약 10% 는 없는 사용자
+  char username[MAX_ID_LEN];
+  UserData user;
+
+  for (long i = 0; i < count; i++) {
+    make_username(username, (int)(next_rand(&rng) % (uint32_t)range));
+    if (thread->engine->find_user(thread->state, username, &user) == 1) {
+      thread->found++;
+    }
+  }
+  return NULL;
+}
+
+typedef struct {
+  long count;
+  long long sum;
+} ScanTotals;
+
+static void scan_visitor(const char* username, int score, void* ctx) {
+  (void)username;
+  ScanTotals* totals = (ScanTotals*)ctx;
+  totals->count++;
+  totals->sum += score;
+}
+
+static off_t dir_file_bytes(const char* dir, const char* const names[], int count) {
+  off_t total = 0;
+  char path[640];
+  struct stat st;
+  for (int i = 0; i < count; i++) {
+    snprintf(path, sizeof(path), "%s/%s", dir, names[i]);
+    if (stat(path, &st) == 0) total += st.st_size;
+  }
+  return total;
+}
+
+static void remove_dir(const char* dir, const char* const names[], int count) {
+  char path[640];
+  for (int i = 0; i < count; i++) {
+    snprintf(path, sizeof(path), "%s/%s", dir, names[i]);
+    unlink(path);
+  }
+  rmdir(dir);
+}
+
+static int run_engine(const StorageEngine* engine, const BenchConfig* config, EngineResult* result) {
+  static const char* const files[] = {"users.txt", "scores.txt", "users.log", "scores.log"};
+  const int file_count = sizeof(files) / sizeof(files[0]);
+
+  char dir[512];
+  snprintf(dir, sizeof(dir), "%s/rain_storage_bench_%s_XXXXXX", config->dir, engine->name);
+  if (mkdtemp(dir) == NULL) {
+    perror("mkdtemp");
+    return -1;
+  }
+
+  memset(result, 0, sizeof(*result));
+  result->name = engine->name;
+
+  void* state = engine->open(dir, config->batch);
+  if (state == NULL) {
+    fprintf(stderr, "%s: open failed\n", engine->name);
+    remove_dir(dir, files, file_count);
+    return -1;
+  }
+
+  // register
+  UserData user;
+  memset(&user, 0, sizeof(user));
+  snprintf(user.password, MAX_PW_LEN, "%s", BENCH_PASSWORD_HASH);
+  double start = now_sec();
+  for (int i = 0; i < config->users; i++) {
+    make_username(user.username, i);
+    engine->add_user(state, &user);
+  }
+  result->register_sec = now_sec() - start;
+
+  // lookup
+  static LookupThread threads[MAX_BENCH_THREADS];
+  start = now_sec();
+  for (int t = 0; t < config->threads; t++) {
+    threads[t] = (LookupThread){engine, state, config, t, 0, 0};
+    pthread_create(&threads[t].tid, NULL, lookup_thread_func, &threads[t]);
+  }
+  for (int t = 0; t < config->threads; t++) {
+    pthread_join(threads[t].tid, NULL);
+    result->found += threads[t].found;
+  }
+  result->lookup_sec = now_sec() - start;
+
+  // append (WAL 배치와 같은 크기로)
+  ScoreRecord* batch = malloc(sizeof(ScoreRecord) * config->batch);
+  if (!batch) {
+    perror("malloc");
+    engine->close(state);
+    remove_dir(dir, files, file_count);
+    return -1;
+  }
+  uint32_t rng = 12345u;
+  start = now_sec();
+  for (long done = 0; done < config->scores;) {
+    int n = (config->scores - done < config->batch) ? (int)(config->scores - done) : config->batch;
+    for (int i = 0; i < n; i++) {
+      make_username(batch[i].username, (int)(next_rand(&rng) % (uint32_t)config->users));
+      batch[i].score = (int)(next_rand(&rng) % 100000);
+    }
+    if (!engine->append_scores(state, batch, n, config->sync_mode)) {
+      fprintf(stderr, "%s: append failed\n", engine->name);
+      break;
+    }
+    done += n;
+  }
+  result->append_sec = now_sec() - start;
+  free(batch);
+
+  // scan
+  ScanTotals totals = {0, 0};
+  start = now_sec();
+  engine->for_each_score(state, 0, scan_visitor, &totals, NULL);
+  result->scan_sec = now_sec() - start;
+  result->scanned = totals.count;
+  result->score_sum = totals.sum;
+  engine->score_log_size(state, &result->log_size);
+
+  // reopen
+  engine->close(state);
+  start = now_sec();
+  state = engine->open(dir, config->batch);
+  result->reopen_sec = now_sec() - start;
+  if (state == NULL) {
+    fprintf(stderr, "%s: reopen failed\n", engine->name);
+  } else {
+    engine->close(state);
+  }
+
+  result->disk_bytes = dir_file_bytes(dir, files, file_count);
+  remove_dir(dir, files, file_count);
+  return state == NULL ? -1 : 0;
+}
+
+static double per_sec(double count, double seconds) { return seconds > 0 ? count / seconds : 0; }
+
+static void usage(const char* prog) {
+  fprintf(stderr,
+          "usage: %s [-e engines] [-u users] [-l lookups] [-t threads] [-s scores] [-b batch] [-y fsync|fdatasync|none] [-d dir]\n"
+          "  engines: comma separated (default: %s)\n",
+          prog, DEFAULT_ENGINES);
+}
+
+int main(int argc, char* argv[]) {
+  BenchConfig config = {DEFAULT_USERS, DEFAULT_LOOKUPS, DEFAULT_THREADS, DEFAULT_SCORES, DEFAULT_BATCH, DB_SYNC_NONE, DEFAULT_DIR};
+  char engines_arg[256] = DEFAULT_ENGINES;
+  const char* sync_name = "none";
+
+  int opt;
+  while ((opt = getopt(argc, argv, "e:u:l:t:s:b:y:d:")) != -1) {
+    switch (opt) {
+      case 'e': snprintf(engines_arg, sizeof(engines_arg), "%s", optarg); break;
+      case 'u': config.users = atoi(optarg); break;
+      case 'l': config.lookups = atol(optarg); break;
+      case 't': config.threads = atoi(optarg); break;
+      case 's': config.scores = atol(optarg); break;
+      case 'b': config.batch = atoi(optarg); break;
+      case 'y': sync_name = optarg; break;
+      case 'd': config.dir = optarg; break;
+      default: usage(argv[0]); return EXIT_FAILURE;
+    }
+  }
+  if (strcmp(sync_name, "fsync") == 0) {
+    config.sync_mode = DB_SYNC_FSYNC;
+  } else if (strcmp(sync_name, "fdatasync") == 0) {
+    config.sync_mode = DB_SYNC_FDATASYNC;
+  } else if (strcmp(sync_name, "none") != 0) {
+    usage(argv[0]);
+    return EXIT_FAILURE;
+  }
+  if (config.users <= 0 || config.lookups < 0 || config.threads <= 0 || config.scores < 0 || config.batch <= 0) {
+    usage(argv[0]);
+    return EXIT_FAILURE;
+  }
+  if (config.threads > MAX_BENCH_THREADS) config.threads = MAX_BENCH_THREADS;
+
+  const StorageEngine* engines[MAX_ENGINES];
+  int engine_count = 0;
+  for (char* save = NULL, *name = strtok_r(engines_arg, ",", &save); name; name = strtok_r(NULL, ",", &save)) {
+    const StorageEngine* engine = storage_engine_find(name);
+    if (engine == NULL) {
+      fprintf(stderr, "unknown engine: %s\n", name);
+      return EXIT_FAILURE;
+    }
+    if (engine_count < MAX_ENGINES) engines[engine_count++] = engine;
+  }
+
+  printf("=== storage_bench: %d users, %ld lookups x %d threads, %ld scores (batch %d, sync %s), dir %s ===\n", config.users,
+         config.lookups, config.threads, config.scores, config.batch, sync_name, config.dir);
+
+  EngineResult results[MAX_ENGINES];
+  for (int i = 0; i < engine_count; i++) {
+    if (run_engine(engines[i], &config, &results[i]) != 0) {
+      return EXIT_FAILURE;
+    }
+  }
+
+  printf("%-6s %12s %14s %14s %14s %10s %10s %12s\n", "engine", "register/s", "lookup/s", "append/s", "scan/s", "reopen ms",
+         "disk KB", "log end");
+  for (int i = 0; i < engine_count; i++) {
+    const EngineResult* r = &results[i];
+    printf("%-6s %12.0f %14.0f %14.0f %14.0f %10.2f %10lld %12llu\n", r->name, per_sec(config.users, r->register_sec),
+           per_sec((double)(config.lookups / config.threads) * config.threads, r->lookup_sec), per_sec(config.scores, r->append_sec),
+           per_sec(r->scanned, r->scan_sec), r->reopen_sec * 1000.0, (long long)(r->disk_bytes / 1024),
+           (unsigned long long)r->log_size);
+  }
+
+  int mismatch = 0;
+  for (int i = 0; i < engine_count; i++) {
+    if (results[i].scanned != config.scores || results[i].scanned != results[0].scanned || results[i].score_sum != results[0].score_sum ||
+        results[i].found != results[0].found) {
+      fprintf(stderr, "MISMATCH: %s scanned %ld scores (sum %lld), found %ld users\n", results[i].name, results[i].scanned,
+              results[i].score_sum, results[i].found);
+      mismatch = 1;
+    }
+  }
+
+  metrics_cleanup();
+  return mismatch ? EXIT_FAILURE : EXIT_SUCCESS;
+}
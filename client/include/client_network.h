@@ -2,16 +2,63 @@
 #ifndef CLIENT_NETWORK_H
 #define CLIENT_NETWORK_H
 
+#include <stdint.h>
+
 #include "protocol.h"
 
 int connect_to_server(const char* ip, int port);
 void disconnect_from_server();
 
 int send_wordlist_request(WordListResponse* resp);
+
+/*
+ * 단어 리스트 전체 수신 (if-none-match 조건부)
+ * if_none_match: 가지고 있는 목록의 etag (없으면 0), 서버 목록과 같으면 목록 없이 1 반환
+ * 새로 받으면 0 과 함께 *words 에 단어 배열, *count 에 개수 (free_wordlist 로 해제), *etag 에 목록의 etag
+ * 서버가 조건부 요청을 모르면 압축 형식(MSG_TYPE_WORDLIST_PACKED_REQ), 그것도 모르면 기존 WordListResponse 로 받음
+ * (이때 *etag 는 0 이므로 캐시하지 않음), 실패 시 음수
+ */
+int fetch_wordlist(uint64_t if_none_match, char*** words, int* count, uint64_t* etag);
+void free_wordlist(char** words, int count);
+
+/*
+ * 난이도 구간 band (WORD_BAND_*, WORD_BAND_ANY 는 전체) 에서 무작위 단어 최대 count 개 수신 (MSG_TYPE_WORD_SAMPLE_REQ)
+ * 성공 시 0 과 함께 *words 에 단어 배열 (free_wordlist 로 해제), *received 에 받은 수 (구간이 비어 있으면 0)
+ * 서버가 이 타입을 모르면 -4, 그 외 실패 시 음수
+ */
+int fetch_word_sample(int band, int count, char*** words, int* received);
+
+/*
+ * 게임 중 단어 스트림의 다음 count 개 요청 (MSG_TYPE_WORD_STREAM_REQ, flags 는 WORD_STREAM_*)
+ * response 에는 WORD_SAMPLE_HEADER_SIZE + count * MAX_WORD_STR_LEN 바이트까지 응답 바디가 그대로 채워짐
+ * 반환값은 send_request_async 와 같음 (서버가 이 타입을 모르면 wait_for_response 가 -4)
+ */
+int send_word_stream_async(int flags, int band, int count, uint8_t* response, int response_max_len);
+
 int send_register_request(const char* username, const char* password, RegisterResponse* response);
 int send_login_request(const char* username, const char* password, LoginResponse* response);
 int send_score_submit_request(int score, ScoreSubmitResponse* response);
 int send_leaderboard_request(LeaderboardResponse* response);
 int send_logout_request(LogoutResponse* response);
 
+/*
+ * 파이프라이닝용 비동기 요청
+ * 응답을 기다리지 않고 요청만 보낸 뒤 핸들(0 이상)을 반환, 실패 시 음수 (send_* 와 같은 오류 코드)
+ * 응답은 wait_for_response(핸들) 이 반환될 때 response 에 채워져 있음
+ * 여러 요청을 먼저 보내고 기다리면 왕복 한 번에 처리됨 (응답은 도착 순서와 무관하게 요청별로 전달)
+ */
+int send_request_async(MessageType type, const void* request_body, int request_body_len, MessageType expected_resp_type, void* response_body,
+                       int response_body_max_len);
+int send_score_submit_async(int score, ScoreSubmitResponse* response);
+int send_leaderboard_async(LeaderboardResponse* response);
+
+/* 핸들의 응답을 기다림 (그동안 도착한 다른 요청의 응답도 각자 버퍼에 채움), 반환값은 send_* 와 같음 */
+int wait_for_response(int handle);
+
+/*
+ * 막지 않고 핸들의 응답이 도착했는지 확인 (게임 루프용, 이미 도착한 응답만 읽음)
+ * 도착했거나 실패했으면 1 (wait_for_response 가 바로 결과를 돌려줌), 아직이면 0
+ */
+int poll_response(int handle);
+
 #endif  // CLIENT_NETWORK_H
\ No newline at end of file
@@ -0,0 +1,157 @@
+// client/include/game_engine.h
+#ifndef GAME_ENGINE_H
+#define GAME_ENGINE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "prefix_index.h"
+
+/*
+ * 게임 코어 (터미널 없음)
+ * 단어 생성/낙하/입력 매칭/점수 계산만 담당하고, 시간은 호출자가 넘겨주는 가상 시계로 진행
+ * ncurses 화면과 실제 시계는 game_logic.c 가, 벤치마크는 bench/game_engine_bench.c 가 연결
+ */
+
+#define MAX_WORDS 20
+#define MAX_WORD_LEN 30
+#define INPUT_BUFFER_LEN (MAX_WORD_LEN + 10)
+#define INITIAL_LIVES 5
+#define WORD_SPAWN_RATE_MS 1500
+
+/* ---------- 시뮬레이션 타이밍 ---------- */
+#define SIM_TICK_MS 10 /* 고정 시뮬레이션 스텝 */
+
+/* ---------- 입력 키 (엔진은 ncurses 키 코드를 모름) ---------- */
+#define GAME_KEY_BACKSPACE '\b'
+
+/* ---------- 메모리 관리 구조체 ---------- */
+typedef struct {
+  char** words;
+  int count;
+  int capacity;
+  bool is_initialized;
+} WordManager;
+
+/*
+ * ---------- 활성 단어 해시 테이블 ----------
+ * 열린 주소법(선형 탐사) 슬롯 + 미리 잡아 둔 노드 풀 (MAX_WORDS 개)
+ * 추가/제거에 malloc 이 없고, 게임 루프 한 스레드에서만 쓰므로 락도 없음
+ * 제거 시 뒤쪽 항목을 당겨 채우므로 삭제 표시(tombstone)가 쌓이지 않음
+ */
+#define HASH_TABLE_SIZE 64 /* 슬롯 수 (2의 거듭제곱, MAX_WORDS 의 2배 이상이라 탐사가 짧음) */
+#define ACTIVE_WORD_NONE 0xFFFF
+
+typedef struct {
+  char word[MAX_WORD_LEN];
+  uint32_t hash;
+  uint16_t next_free; /* 빈 노드 목록 */
+} ActiveWordNode;
+
+typedef struct {
+  uint16_t slots[HASH_TABLE_SIZE]; /* 노드 번호, 빈 슬롯은 ACTIVE_WORD_NONE */
+  ActiveWordNode nodes[MAX_WORDS];
+  uint16_t free_head;
+  int total_count;
+} ActiveWordHashTable;
+
+/* ---------- Word 타입 구분 ---------- */
+typedef enum { WORD_NORMAL = 0, WORD_KILL = 1, WORD_BONUS = 2, WORD_TYPE_COUNT = 3 } WordType;
+
+/* ---------- Word 구조체 ---------- */
+typedef struct {
+  char text[MAX_WORD_LEN];
+  int x, y;
+  bool active;
+  WordType wtype;
+} Word;
+
+/* ---------- 단어 공급원 ---------- */
+/* 다음에 내릴 단어 (없으면 NULL), 돌려준 문자열은 다음 호출 전까지만 유효하면 됨 (엔진이 바로 복사) */
+typedef const char* (*GameWordSource)(void* ctx);
+
+/* ---------- 게임 한 판의 전체 상태 ---------- */
+typedef struct {
+  int area_width, area_height; /* 단어가 움직이는 영역 크기 */
+
+  Word words[MAX_WORDS];
+  int drop_accum_ms[WORD_TYPE_COUNT]; /* 타입별 다음 한 칸 낙하까지 누적 시간 */
+  int spawn_accum_ms;
+
+  long clock_ms;   /* 가상 시계: 지금까지 진행한 시뮬레이션 시간 */
+  long pending_ms; /* 아직 스텝으로 소화하지 못한 시간 */
+  uint32_t rng_state;
+
+  char* const* dictionary;
+  int dictionary_count;
+  GameWordSource word_source; /* 설정되어 있으면 사전보다 먼저 사용 (비었으면 사전으로) */
+  void* word_source_ctx;
+
+  int score;
+  int lives;
+  bool over;
+  char input[INPUT_BUFFER_LEN];
+  int input_pos;
+
+  PrefixIndex active_prefix; /* 화면에 있는 단어의 접두사 색인 (슬롯 = words[] 번호) */
+  uint16_t input_node;       /* 현재 입력에 해당하는 색인 노드 (일치하는 단어가 없으면 PREFIX_NODE_NONE) */
+} GameEngine;
+
+/* ---------- 전역 변수 선언 ---------- */
+extern WordManager g_word_manager;
+extern ActiveWordHashTable g_active_words;
+
+/* ---------- 타입별 드롭 속도 ---------- */
+extern int drop_interval_ms[WORD_TYPE_COUNT];
+void set_drop_interval(WordType type, int interval_ms);
+
+/* ---------- 메모리 관리 함수들 ---------- */
+int init_word_manager(void);
+void cleanup_word_manager(void);
+int load_words_from_response(const char* words[], int count);
+
+/* ---------- 활성 단어 관리 함수들 ---------- */
+int init_active_word_table(void);
+void cleanup_active_word_table(void);
+bool add_active_word(const char* word);
+bool remove_active_word(const char* word);
+bool is_word_in_active_table(const char* word);
+
+/* ---------- 엔진 함수들 ---------- */
+
+/*
+ * 새 게임 시작
+ * seed 가 같고 입력/시간 진행이 같으면 항상 같은 게임이 재현됨
+ * dictionary 는 엔진이 사용하는 동안 유지되어야 함 (복사하지 않음)
+ */
+void game_engine_init(GameEngine* engine, int area_width, int area_height, uint32_t seed, char* const* dictionary, int dictionary_count);
+
+/*
+ * 단어 공급원 설정 (서버 스트리밍 등), NULL 이면 사전만 사용
+ * 공급원의 단어는 엔진 난수와 무관하므로 같은 seed 라도 단어 순서는 재현되지 않음
+ */
+void game_engine_set_word_source(GameEngine* engine, GameWordSource source, void* ctx);
+
+/* 시뮬레이션 한 스텝 (SIM_TICK_MS) 진행 */
+void game_engine_tick(GameEngine* engine);
+
+/*
+ * 가상 시계를 elapsed_ms 만큼 진행 (SIM_TICK_MS 단위로 나눠 실행, 나머지는 다음 호출로 이월)
+ * max_ticks > 0 이면 한 번에 그 이상 실행하지 않고 남은 시간은 버림 (멈췄다 재개된 경우)
+ * 반환값: 실행한 스텝 수
+ */
+int game_engine_advance(GameEngine* engine, long elapsed_ms, int max_ticks);
+
+/* 키 입력 하나 처리 ('\n' / ' ' 는 입력 확정, GAME_KEY_BACKSPACE / 127 은 지우기) */
+void game_engine_input(GameEngine* engine, int ch);
+
+/* words[slot] 이 현재 입력으로 시작하는지 (입력 중인 후보 하이라이트용, 입력이 비었으면 false) */
+bool game_engine_is_candidate(const GameEngine* engine, int slot);
+
+/* 현재 점수 기준 레벨 (1~5) */
+int game_engine_level(const GameEngine* engine);
+
+/* 남은 단어를 모두 비활성화하고 활성 단어 테이블에서 제거 */
+void game_engine_clear(GameEngine* engine);
+
+#endif /* GAME_ENGINE_H */
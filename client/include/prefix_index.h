@@ -0,0 +1,55 @@
+// client/include/prefix_index.h
+#ifndef PREFIX_INDEX_H
+#define PREFIX_INDEX_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * 화면에 떠 있는 단어의 접두사 트라이 (입력 매칭 / 후보 하이라이트용)
+ * - 노드는 고정 크기 풀에서 꺼내 쓰고 빈 노드는 빈 목록으로 돌려줌 (게임 중 malloc 없음)
+ * - 노드마다 그 접두사를 가진 단어 슬롯 비트마스크(subtree)와 그 노드에서 끝나는 슬롯(terminal)을 둠
+ *   → 입력 한 글자마다 자식 하나로 내려가면 후보 집합이 바로 나옴
+ * - 같은 글자의 단어가 여러 슬롯에 있어도 각 슬롯 비트로 구분
+ */
+
+#define PREFIX_INDEX_SLOTS 20 /* 단어 슬롯 수 (game_engine.h 의 MAX_WORDS 이상) */
+#define PREFIX_INDEX_DEPTH 29 /* 색인하는 최대 글자 수 (MAX_WORD_LEN - 1 이상) */
+
+#define PREFIX_MASK_WORDS ((PREFIX_INDEX_SLOTS + 63) / 64)
+#define PREFIX_INDEX_NODES (PREFIX_INDEX_SLOTS * PREFIX_INDEX_DEPTH + 1) /* 모든 슬롯이 서로 다른 최장 단어여도 충분 */
+#define PREFIX_NODE_NONE 0xFFFF
+
+typedef struct {
+  uint64_t bits[PREFIX_MASK_WORDS];
+} PrefixSlotMask;
+
+typedef struct {
+  uint16_t first_child; /* 자식 목록 (형제끼리 next_sibling 으로 연결), 없으면 PREFIX_NODE_NONE */
+  uint16_t next_sibling;
+  char ch;
+  PrefixSlotMask subtree;  /* 이 접두사로 시작하는 단어 슬롯 */
+  PrefixSlotMask terminal; /* 정확히 이 접두사인 단어 슬롯 */
+} PrefixNode;
+
+typedef struct {
+  PrefixNode nodes[PREFIX_INDEX_NODES]; /* 0 번은 루트 (빈 접두사) */
+  uint16_t free_head;                   /* 빈 노드 목록 (next_sibling 으로 연결) */
+} PrefixIndex;
+
+/* 빈 색인으로 초기화 */
+void prefix_index_init(PrefixIndex* index);
+
+/* slot 의 단어 추가 / 제거 (PREFIX_INDEX_DEPTH 글자까지만 색인), 제거는 추가한 것과 같은 단어로 */
+void prefix_index_insert(PrefixIndex* index, const char* word, int slot);
+void prefix_index_remove(PrefixIndex* index, const char* word, int slot);
+
+/* from 노드에서 ch 로 한 글자 내려간 노드 (없으면 PREFIX_NODE_NONE) */
+uint16_t prefix_index_step(const PrefixIndex* index, uint16_t from, char ch);
+
+/* 루트에서 prefix 전체를 따라간 노드 (없으면 PREFIX_NODE_NONE) */
+uint16_t prefix_index_find(const PrefixIndex* index, const char* prefix);
+
+static inline bool prefix_mask_test(const PrefixSlotMask* mask, int slot) { return (mask->bits[slot / 64] >> (slot % 64)) & 1; }
+
+#endif  // PREFIX_INDEX_H
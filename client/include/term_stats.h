@@ -0,0 +1,24 @@
+// client/include/term_stats.h
+#ifndef TERM_STATS_H
+#define TERM_STATS_H
+
+/*
+ * 터미널 출력 바이트 계측 (계측 빌드 bin/rain_client_stats 에서만 동작)
+ * 계측 빌드는 ncurses 를 정적으로 링크하면서 write() 를 감싸(-Wl,--wrap=write)
+ * ncurses 와 클라이언트 코드가 stdout 으로 쓴 바이트를 센다
+ * 일반 빌드는 write() 를 건드리지 않으며 값은 항상 0
+ */
+
+/* 이 실행 파일이 출력량을 세는 계측 빌드이면 1 */
+int term_stats_available(void);
+
+/* 지금까지 터미널에 쓴 총 바이트 수 */
+unsigned long long term_stats_total_bytes(void);
+
+/*
+ * 최근 1초 구간의 초당 출력 바이트 수
+ * now_ms: 단조 시계 기준 현재 시각 (ms), 1초가 지날 때마다 값이 갱신됨
+ */
+unsigned long term_stats_bytes_per_sec(long now_ms);
+
+#endif  // TERM_STATS_H
@@ -0,0 +1,23 @@
+// client/include/word_cache.h
+#ifndef WORD_CACHE_H
+#define WORD_CACHE_H
+
+#include <stdint.h>
+
+/*
+ * 서버 단어 목록의 로컬 캐시 파일
+ * 다음 실행 때 캐시의 etag 로 조건부 요청을 보내 목록이 그대로면 전송을 생략
+ * 경로: 환경 변수 RAIN_WORD_CACHE, 없으면 $HOME/.rain_words.cache
+ * 형식: "RWC1" u64 etag u32 count, 뒤에 count 개의 [u8 len][bytes] (little-endian, wire_codec.h)
+ */
+
+/*
+ * 캐시 읽기, 성공 시 0 과 함께 *words 에 단어 배열 (free_wordlist 로 해제)
+ * 파일이 없거나 형식/etag 가 맞지 않으면 -1
+ */
+int word_cache_load(uint64_t* etag, char*** words, int* count);
+
+/* 캐시 쓰기 (임시 파일에 쓴 뒤 rename 으로 교체), 실패 시 -1 */
+int word_cache_save(uint64_t etag, char* const* words, int count);
+
+#endif  // WORD_CACHE_H
@@ -0,0 +1,36 @@
+// client/include/word_stream.h
+#ifndef WORD_STREAM_H
+#define WORD_STREAM_H
+
+#include <stdbool.h>
+
+/*
+ * 게임 중 서버 단어 스트리밍 (MSG_TYPE_WORD_STREAM_*)
+ * 전체 목록 대신 작은 링 버퍼에 앞으로 쓸 단어를 미리 받아 두고,
+ * 버퍼가 절반 아래로 줄면 빈 칸 수만큼 다음 단어를 요청 (응답은 게임 루프가 막지 않고 확인)
+ * 메모리는 사전 크기와 무관하게 WORD_STREAM_CAPACITY 칸으로 고정
+ */
+#define WORD_STREAM_CAPACITY 64
+
+/*
+ * 난이도 구간 band (WORD_BAND_*, WORD_BAND_ANY 는 전체) 로 새 스트림 시작, 첫 묶음을 받을 때까지 대기
+ * 성공 시 받은 단어 수 (≥1), 구간이 비었으면 0, 서버가 스트리밍을 모르면 -4, 그 외 실패 시 음수
+ */
+int word_stream_start(int band);
+
+/* 스트림이 시작되어 단어를 받고 있는지 */
+bool word_stream_active(void);
+
+/*
+ * 버퍼에서 다음 단어 (GameWordSource 형식, ctx 는 사용하지 않음), 비었으면 NULL
+ * 돌려준 문자열은 다음 word_stream_pump 전까지 유효
+ */
+const char* word_stream_next(void* ctx);
+
+/* 도착한 단어를 버퍼에 넣고 필요하면 다음 요청을 보냄 (게임 루프에서 프레임마다 호출, 막지 않음) */
+void word_stream_pump(void);
+
+/* 보낸 요청의 응답을 마저 받고 스트림 정지 (다음 요청과 응답이 섞이지 않도록 게임이 끝날 때 호출) */
+void word_stream_stop(void);
+
+#endif  // WORD_STREAM_H
@@ -15,9 +15,12 @@
 #include "how_to_play_ui.h" /* 게임 방법 설명 UI 추가 */
 #include "leaderboard_ui.h"
 #include "protocol.h"
+#include "word_cache.h"
+#include "word_stream.h"
 
 #define SERVER_IP "127.0.0.1"
 #define SERVER_PORT 8080
+#define SESSION_SAMPLE_WORDS 256 /* RAIN_WORD_BAND 지정 시 한 게임에 받는 단어 수 */
 
 volatile sig_atomic_t sigint_received = 0;
 volatile sig_atomic_t sigint_game_exit_requested = 0;
@@ -68,23 +71,75 @@ static void perform_cleanup_and_exit(int code, const char* msg) {
   exit(code);
 }
 
-static int load_words_from_server(void) {
-  WordListResponse wresp;
-  if (send_wordlist_request(&wresp) != 0 || wresp.count <= 0) {
-    return 0;
+/* RAIN_WORD_BAND (easy|normal|hard|expert 또는 0~3) → WORD_BAND_*, 없거나 잘못된 값이면 -1 */
+static int word_band_from_env(void) {
+  static const char* names[WORD_BAND_COUNT] = {"easy", "normal", "hard", "expert"};
+  const char* value = getenv("RAIN_WORD_BAND");
+  if (value == NULL || *value == '\0') return -1;
+  for (int band = 0; band < WORD_BAND_COUNT; band++) {
+    if (strcmp(value, names[band]) == 0 || (value[0] == '0' + band && value[1] == '\0')) return band;
   }
+  return -1;
+}
 
-  const char** word_ptrs = malloc(sizeof(char*) * wresp.count);
-  if (!word_ptrs) {
+// 난이도 구간을 지정했으면 그 구간의 표본만 받음 (구간이 비었거나 서버가 지원하지 않으면 0)
+static int load_word_sample_from_server(int band) {
+  char** words = NULL;
+  int count = 0;
+  if (fetch_word_sample(band, SESSION_SAMPLE_WORDS, &words, &count) != 0 || count <= 0) {
     return 0;
   }
 
-  for (int i = 0; i < wresp.count; i++) {
-    word_ptrs[i] = wresp.words[i];
+  int result = load_words_from_response((const char**)words, count);
+  free_wordlist(words, count);
+  return result;
+}
+
+/* RAIN_WORD_STREAM 이 설정되어 있으면 ("0" 제외) 전체 목록 대신 게임 중 단어를 스트리밍으로 받음 */
+static bool word_stream_enabled(void) {
+  const char* value = getenv("RAIN_WORD_STREAM");
+  return value != NULL && *value != '\0' && strcmp(value, "0") != 0;
+}
+
+// 스트림의 첫 묶음만 받고 바로 게임 시작 (서버가 지원하지 않거나 구간이 비었으면 0 → 목록 다운로드로)
+static int start_word_stream_from_server(void) {
+  int band = word_band_from_env();
+  return word_stream_start(band >= 0 ? band : WORD_BAND_ANY) > 0;
+}
+
+// 로컬 캐시의 etag 로 조건부 요청, 서버 목록이 그대로면 캐시를 사용하고 새로 받으면 캐시 갱신
+static int load_words_from_server(void) {
+  int band = word_band_from_env();
+  if (band >= 0 && load_word_sample_from_server(band)) {
+    return 1;
+  }
+
+  uint64_t cached_etag = 0;
+  char** cached_words = NULL;
+  int cached_count = 0;
+  if (word_cache_load(&cached_etag, &cached_words, &cached_count) != 0) {
+    cached_etag = 0;
   }
 
-  int result = load_words_from_response(word_ptrs, wresp.count);
-  free(word_ptrs);
+  char** words = NULL;
+  int count = 0;
+  uint64_t etag = 0;
+  int ret = fetch_wordlist(cached_etag, &words, &count, &etag);
+  if (ret == 1) {
+    int result = load_words_from_response((const char**)cached_words, cached_count);
+    free_wordlist(cached_words, cached_count);
+    return result;
+  }
+  free_wordlist(cached_words, cached_count);
+  if (ret != 0 || count <= 0) {
+    return 0;
+  }
+
+  if (etag != 0) {
+    word_cache_save(etag, words, count);
+  }
+  int result = load_words_from_response((const char**)words, count);
+  free_wordlist(words, count);
   return result;
 }
 
@@ -159,7 +214,8 @@ int main() {
             clear();
             refresh();
 
-            if (!g_word_manager.is_initialized || g_word_manager.count == 0) {
+            bool streaming = word_stream_enabled() && start_word_stream_from_server();
+            if (!streaming && (!g_word_manager.is_initialized || g_word_manager.count == 0)) {
               if (!load_words_from_server()) {
                 mvprintw(Y_STATUS_MSG, X_DEFAULT_POS, "Failed to load word list from server.");
                 wait_for_key_or_signal(Y_STATUS_MSG + 2, X_DEFAULT_POS, "Press any key...");
@@ -174,6 +230,7 @@ int main() {
 
             int final_score = run_rain_typing_game(user_id);
             is_game_running = false;
+            word_stream_stop();
 
             if (sigint_received) {
               stay_in_menu = false;
@@ -186,8 +243,15 @@ int main() {
               mvprintw(Y_STATUS_MSG - 2, X_DEFAULT_POS, "Game could not start or was aborted. (Error: %d)", final_score);
             } else {
               mvprintw(Y_STATUS_MSG - 4, X_DEFAULT_POS, "Game Over! Your final score: %d", final_score);
+
+              // 점수 제출과 리더보드 조회를 연달아 보내고 함께 기다림 (왕복 한 번)
+              // 서버는 점수 제출을 끝낸 뒤 리더보드를 처리하므로 방금 점수가 반영된 순위를 받음
               ScoreSubmitResponse score_res;
-              int ret = send_score_submit_request(final_score, &score_res);
+              LeaderboardResponse board_res;
+              int score_handle = send_score_submit_async(final_score, &score_res);
+              int board_handle = (score_handle >= 0) ? send_leaderboard_async(&board_res) : score_handle;
+              int ret = wait_for_response(score_handle);
+              int board_ret = wait_for_response(board_handle);
 
               if (sigint_received) {
                 stay_in_menu = false;
@@ -196,6 +260,14 @@ int main() {
 
               if (ret == 0 && score_res.success) {
                 mvprintw(Y_STATUS_MSG - 2, X_DEFAULT_POS, "Score submitted successfully! Server: %s", score_res.message);
+                if (board_ret == 0) {
+                  for (int i = 0; i < board_res.count && i < MAX_LEADERBOARD_ENTRIES; i++) {
+                    if (strcmp(board_res.entries[i].username, user_id) == 0) {
+                      mvprintw(Y_STATUS_MSG - 1, X_DEFAULT_POS, "Leaderboard rank: #%d (best %d)", i + 1, board_res.entries[i].score);
+                      break;
+                    }
+                  }
+                }
               } else {
                 mvprintw(Y_STATUS_MSG - 2, X_DEFAULT_POS, "Failed to submit score. Server: %s (ret: %d)",
                          (ret != 0 ? "Network/Comm error" : score_res.message), ret);
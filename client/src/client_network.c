@@ -3,6 +3,8 @@
 
 #include <arpa/inet.h>
 #include <errno.h>
+#include <poll.h>
+#include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -11,8 +13,86 @@
 
 #include "client_globals.h"
 #include "protocol.h"
+#include "wire_codec.h"
 
 static int client_sock = -1;
+static int wire_version = WIRE_VERSION_LEGACY; /* hello 로 협상한 프로토콜 버전 */
+
+#define MAX_REQUEST_BODY_LEN 1024       /* 클라이언트가 보내는 요청 바디 상한 */
+#define MAX_RESPONSE_BODY_LEN (1 << 20) /* 응답 바디 상한 (이상하면 연결 종료) */
+#define WORDLIST_MAX_RESTARTS 3         /* 단어 목록 수신 중 서버 목록이 바뀌었을 때 다시 받는 횟수 */
+
+/*
+ * 파이프라이닝: 응답을 기다리지 않고 요청을 보내고, 응답은 도착하는 대로 해당 요청의 버퍼에 채움
+ * 버전 2 서버는 요청 ID 로, 그 이전 서버는 요청 순서대로 응답하므로 가장 오래된 요청과 짝을 맞춤
+ */
+#define MAX_PENDING_REQUESTS 16
+
+typedef struct {
+  bool in_use;
+  bool done;
+  uint32_t request_id;
+  MessageType expected_type;
+  void* response_body;
+  int response_body_max_len;
+  int result; /* send_* 와 같은 반환 코드 */
+} PendingRequest;
+
+static PendingRequest pending_requests[MAX_PENDING_REQUESTS];
+static uint32_t next_request_id = 1;
+
+static int send_all(int sock, const void* buf, size_t len);
+static int recv_all(int sock, void* buf, size_t len);
+static void fail_pending_requests(int result);
+
+/*
+ * 접속 직후 hello 를 보내 프로토콜 버전 협상
+ * 레거시 서버는 hello 를 모르는 메시지로 보고 MSG_TYPE_ERROR 를 돌려주므로
+ * 그 응답을 읽어 버린 뒤 버전 0 (구조체 그대로) 으로 통신
+ */
+static int negotiate_protocol(void) {
+  uint8_t hello[WIRE_HELLO_SIZE];
+  wire_encode_hello(hello, RAIN_PROTOCOL_VERSION);
+  if (send_all(client_sock, hello, sizeof(hello)) != 0) {
+    return -1;
+  }
+
+  uint8_t reply[WIRE_HELLO_SIZE];
+  if (recv_all(client_sock, reply, 4) != 0) {
+    return -1;
+  }
+  if (memcmp(reply, RAIN_WIRE_MAGIC, 4) == 0) {
+    uint16_t version;
+    if (recv_all(client_sock, reply + 4, WIRE_HELLO_SIZE - 4) != 0 || wire_decode_hello(reply, &version) != 0) {
+      return -1;
+    }
+    if (version < 1 || version > RAIN_PROTOCOL_VERSION) {
+      return -1;
+    }
+    wire_version = version;
+    return 0;
+  }
+
+  // 레거시 서버의 에러 응답: 나머지 헤더와 바디를 버림
+  uint8_t legacy_header[sizeof(MessageHeader)];
+  memcpy(legacy_header, reply, 4);
+  if (recv_all(client_sock, legacy_header + 4, sizeof(MessageHeader) - 4) != 0) {
+    return -1;
+  }
+  WireFrameHeader header;
+  wire_decode_frame_header(WIRE_VERSION_LEGACY, legacy_header, &header);
+  char discard[sizeof(ErrorResponse)];
+  size_t remaining = header.length;
+  while (remaining > 0) {
+    size_t to_read = remaining < sizeof(discard) ? remaining : sizeof(discard);
+    if (recv_all(client_sock, discard, to_read) != 0) {
+      return -1;
+    }
+    remaining -= to_read;
+  }
+  wire_version = WIRE_VERSION_LEGACY;
+  return 0;
+}
 
 int connect_to_server(const char* ip, int port) {
   if (client_sock != -1) {
@@ -35,6 +115,13 @@ int connect_to_server(const char* ip, int port) {
     client_sock = -1;
     return -1;
   }
+
+  if (negotiate_protocol() != 0) {
+    close(client_sock);
+    client_sock = -1;
+    return -1;
+  }
+  memset(pending_requests, 0, sizeof(pending_requests));
   return 0;
 }
 
@@ -43,6 +130,7 @@ void disconnect_from_server() {
     close(client_sock);
     client_sock = -1;
   }
+  fail_pending_requests(-1);
 }
 
 // 정확한 바이트 수만큼 송신하는 함수
@@ -87,104 +175,205 @@ static int recv_all(int sock, void* buf, size_t len) {
   return 0;
 }
 
-static int send_request_and_receive_response(MessageType type, const void* request_body, int request_body_len, MessageType expected_resp_type,
-                                             void* response_body, int response_body_max_len) {
-  if (client_sock == -1) {
-    return -1;
+// 바디를 협상된 버전으로 인코딩 (레거시는 구조체 그대로), 바디 길이 반환 (실패 시 -1)
+static long encode_request_body(MessageType type, const void* msg, size_t msg_len, uint8_t* out, size_t cap) {
+  if (wire_version == WIRE_VERSION_LEGACY) {
+    if (msg_len > cap) return -1;
+    if (msg && msg_len > 0) memcpy(out, msg, msg_len);
+    return (long)msg_len;
   }
-  if (sigint_received) return -10;
-
-  // 요청 헤더 준비
-  MessageHeader req_header;
-  req_header.type = type;
-  req_header.length = request_body_len;
+  return wire_encode_body(type, msg, msg_len, out, cap);
+}
 
-  // 헤더 전송
-  if (send_all(client_sock, &req_header, sizeof(MessageHeader)) != 0) {
-    disconnect_from_server();
-    return -2;
+// 받은 바디를 구조체로 복원 (레거시는 그대로 복사), 실패 시 -1
+static long decode_response_body(uint32_t type, const uint8_t* body, size_t body_len, void* msg, size_t msg_cap) {
+  if (wire_version == WIRE_VERSION_LEGACY) {
+    if (body_len > msg_cap) return -1;
+    if (body_len > 0) memcpy(msg, body, body_len);
+    return (long)body_len;
   }
-  if (sigint_received) return -10;
+  return wire_decode_body(type, body, body_len, msg, msg_cap);
+}
 
-  // 바디 전송 (있는 경우)
-  if (request_body && request_body_len > 0) {
-    if (send_all(client_sock, request_body, request_body_len) != 0) {
-      disconnect_from_server();
-      return -2;
+// 응답이 오지 않을 요청들을 모두 실패로 완료
+static void fail_pending_requests(int result) {
+  for (int i = 0; i < MAX_PENDING_REQUESTS; i++) {
+    if (pending_requests[i].in_use && !pending_requests[i].done) {
+      pending_requests[i].done = true;
+      pending_requests[i].result = result;
     }
   }
-  if (sigint_received) return -10;
+}
 
-  // 응답 헤더 수신
-  MessageHeader resp_header;
-  if (recv_all(client_sock, &resp_header, sizeof(MessageHeader)) != 0) {
-    disconnect_from_server();
-    return -3;
+// 받은 응답의 짝이 되는 요청 (없으면 NULL)
+static PendingRequest* match_pending_request(const WireFrameHeader* header) {
+  PendingRequest* oldest = NULL;
+  for (int i = 0; i < MAX_PENDING_REQUESTS; i++) {
+    PendingRequest* p = &pending_requests[i];
+    if (!p->in_use || p->done) continue;
+    if (wire_version >= 2) {
+      if (p->request_id == header->request_id) return p;
+    } else if (oldest == NULL || p->request_id < oldest->request_id) {
+      oldest = p;
+    }
   }
-  if (sigint_received) return -10;
+  return oldest;
+}
 
-  // 에러 응답 처리
-  if (resp_header.type == MSG_TYPE_ERROR) {
-    if (resp_header.length > 0 && resp_header.length <= sizeof(ErrorResponse)) {
-      ErrorResponse err_resp;
-      if (recv_all(client_sock, &err_resp, resp_header.length) == 0) {
-        if (response_body && (size_t)response_body_max_len >= sizeof(ErrorResponse)) {
-          snprintf(((struct {
-                     int success;
-                     char message[MAX_MSG_LEN];
-                   }*)response_body)
-                       ->message,
-                   MAX_MSG_LEN, "%s", err_resp.message);
-          ((struct {
-            int success;
-            char message[MAX_MSG_LEN];
-          }*)response_body)
-              ->message[MAX_MSG_LEN - 1] = '\0';
-          ((struct {
-            int success;
-            char message[MAX_MSG_LEN];
-          }*)response_body)
-              ->success = 0;
-        }
-      }
-    }
-    return -4;
-  }
-
-  // 예상한 응답 타입인지 확인
-  if (resp_header.type != expected_resp_type) {
-    printf("[CLIENT_NETWORK] Expected response type %d, but got %d\n", expected_resp_type, resp_header.type);
-    // 응답 바디가 있다면 버퍼를 비워줘야 함
-    if (resp_header.length > 0) {
-      char discard_buffer[1024];
-      size_t remaining = resp_header.length;
-      while (remaining > 0) {
-        size_t to_read = (remaining > sizeof(discard_buffer)) ? sizeof(discard_buffer) : remaining;
-        if (recv_all(client_sock, discard_buffer, to_read) != 0) {
-          disconnect_from_server();
-          break;
-        }
-        remaining -= to_read;
-      }
+// 받은 응답 바디를 요청의 버퍼에 채우고 결과 코드 기록
+static void fill_pending_response(PendingRequest* p, const WireFrameHeader* resp_header, const uint8_t* resp_body) {
+  p->done = true;
+  p->result = 0;
+
+  if (resp_header->type == MSG_TYPE_ERROR) {
+    // 에러 메시지를 상태 응답(success + message) 형태로 전달
+    ErrorResponse err_resp;
+    memset(&err_resp, 0, sizeof(err_resp));
+    decode_response_body(MSG_TYPE_ERROR, resp_body, resp_header->length < sizeof(err_resp) ? resp_header->length : sizeof(err_resp), &err_resp,
+                         sizeof(err_resp));
+    if (p->response_body && (size_t)p->response_body_max_len >= sizeof(RegisterResponse)) {
+      RegisterResponse* status = (RegisterResponse*)p->response_body;
+      status->success = 0;
+      snprintf(status->message, MAX_MSG_LEN, "%.*s", MAX_MSG_LEN - 1, err_resp.message);
     }
-    return -5;
+    p->result = -4;
+  } else if (resp_header->type != (uint32_t)p->expected_type) {
+    // 예상한 응답 타입인지 확인
+    printf("[CLIENT_NETWORK] Expected response type %d, but got %u\n", p->expected_type, resp_header->type);
+    p->result = -5;
+  } else if (wire_version == WIRE_VERSION_LEGACY && resp_header->length > (uint32_t)p->response_body_max_len) {
+    // 응답 바디 크기 확인
+    printf("[CLIENT_NETWORK] Response body too large: %u > %d\n", resp_header->length, p->response_body_max_len);
+    p->result = -6;
+  } else if (decode_response_body(resp_header->type, resp_body, resp_header->length, p->response_body, p->response_body_max_len) < 0) {
+    printf("[CLIENT_NETWORK] Malformed response body (type %u)\n", resp_header->type);
+    p->result = -7;
   }
+}
 
-  // 응답 바디 크기 확인
-  if (resp_header.length > response_body_max_len) {
-    printf("[CLIENT_NETWORK] Response body too large: %d > %d\n", resp_header.length, response_body_max_len);
-    return -6;
+// 응답 프레임 하나를 받아 짝이 되는 요청에 전달, 연결 오류 시 -3 (대기 중인 요청은 모두 실패 처리)
+static int receive_next_response(void) {
+  size_t header_size = wire_frame_header_size(wire_version);
+  uint8_t header_buf[WIRE_MAX_FRAME_HEADER_SIZE];
+  WireFrameHeader resp_header;
+  if (recv_all(client_sock, header_buf, header_size) != 0) {
+    goto fail;
+  }
+  wire_decode_frame_header(wire_version, header_buf, &resp_header);
+  if (resp_header.length > MAX_RESPONSE_BODY_LEN) {
+    printf("[CLIENT_NETWORK] Response body too large: %u\n", resp_header.length);
+    goto fail;
   }
 
-  // 응답 바디 수신
+  // 응답 바디 수신 (짝이 없거나 타입이 달라도 다음 응답을 위해 끝까지 읽음)
+  uint8_t* resp_body = NULL;
   if (resp_header.length > 0) {
-    if (recv_all(client_sock, response_body, resp_header.length) != 0) {
-      disconnect_from_server();
-      return -3;
+    resp_body = malloc(resp_header.length);
+    if (!resp_body || recv_all(client_sock, resp_body, resp_header.length) != 0) {
+      free(resp_body);
+      goto fail;
     }
   }
 
+  // 요청하지 않은 응답은 건너뜀
+  PendingRequest* p = match_pending_request(&resp_header);
+  if (p) {
+    fill_pending_response(p, &resp_header, resp_body);
+  }
+  free(resp_body);
   return 0;
+
+fail:
+  fail_pending_requests(-3);
+  disconnect_from_server();
+  return -3;
+}
+
+int send_request_async(MessageType type, const void* request_body, int request_body_len, MessageType expected_resp_type, void* response_body,
+                       int response_body_max_len) {
+  if (client_sock == -1) {
+    return -1;
+  }
+  if (sigint_received) return -10;
+
+  int slot = -1;
+  for (int i = 0; i < MAX_PENDING_REQUESTS; i++) {
+    if (!pending_requests[i].in_use) {
+      slot = i;
+      break;
+    }
+  }
+  if (slot == -1) {
+    return -2;  // 응답을 기다리는 요청이 너무 많음
+  }
+
+  uint32_t request_id = next_request_id++;
+  if (next_request_id == 0) next_request_id = 1;
+
+  // 헤더 + 바디를 한 버퍼에 만들어 한 번에 전송
+  uint8_t frame[WIRE_MAX_FRAME_HEADER_SIZE + MAX_REQUEST_BODY_LEN];
+  size_t header_size = wire_frame_header_size(wire_version);
+  long body_len = encode_request_body(type, request_body, request_body_len, frame + header_size, MAX_REQUEST_BODY_LEN);
+  if (body_len < 0) {
+    return -2;
+  }
+  wire_encode_frame_header(wire_version, frame, type, request_id, (uint32_t)body_len);
+
+  if (send_all(client_sock, frame, header_size + body_len) != 0) {
+    disconnect_from_server();
+    return -2;
+  }
+
+  PendingRequest* p = &pending_requests[slot];
+  p->in_use = true;
+  p->done = false;
+  p->request_id = request_id;
+  p->expected_type = expected_resp_type;
+  p->response_body = response_body;
+  p->response_body_max_len = response_body_max_len;
+  p->result = 0;
+  return slot;
+}
+
+int wait_for_response(int handle) {
+  if (handle < 0) {
+    return handle;  // send_*_async 실패 코드를 그대로 전달
+  }
+  if (handle >= MAX_PENDING_REQUESTS || !pending_requests[handle].in_use) {
+    return -1;
+  }
+
+  PendingRequest* p = &pending_requests[handle];
+  while (!p->done) {
+    if (sigint_received) return -10;
+    if (receive_next_response() != 0) break;
+  }
+
+  int result = p->result;
+  p->in_use = false;
+  if (sigint_received) return -10;
+  return result;
+}
+
+int poll_response(int handle) {
+  if (handle < 0 || handle >= MAX_PENDING_REQUESTS || !pending_requests[handle].in_use) {
+    return 1;  // wait_for_response 가 바로 오류를 돌려줌
+  }
+
+  // 이미 도착한 프레임만 처리 (프레임 하나를 읽기 시작하면 끝까지 받음)
+  PendingRequest* p = &pending_requests[handle];
+  while (!p->done && client_sock != -1) {
+    struct pollfd pfd = {.fd = client_sock, .events = POLLIN};
+    int ready = poll(&pfd, 1, 0);
+    if (ready == 0 || (ready < 0 && errno == EINTR)) return 0;
+    if (receive_next_response() != 0) break;
+  }
+  return 1;
+}
+
+static int send_request_and_receive_response(MessageType type, const void* request_body, int request_body_len, MessageType expected_resp_type,
+                                             void* response_body, int response_body_max_len) {
+  return wait_for_response(send_request_async(type, request_body, request_body_len, expected_resp_type, response_body, response_body_max_len));
 }
 
 int send_register_request(const char* username, const char* password, RegisterResponse* response) {
@@ -208,21 +397,257 @@ int send_login_request(const char* username, const char* password, LoginResponse
   return send_request_and_receive_response(MSG_TYPE_LOGIN_REQ, &req_data, sizeof(LoginRequest), MSG_TYPE_LOGIN_RESP, response, sizeof(LoginResponse));
 }
 
-int send_score_submit_request(int score, ScoreSubmitResponse* response) {
+int send_score_submit_request(int score, ScoreSubmitResponse* response) { return wait_for_response(send_score_submit_async(score, response)); }
+
+int send_score_submit_async(int score, ScoreSubmitResponse* response) {
   ScoreSubmitRequest req_data;
   req_data.score = score;
-  return send_request_and_receive_response(MSG_TYPE_SCORE_SUBMIT_REQ, &req_data, sizeof(ScoreSubmitRequest), MSG_TYPE_SCORE_SUBMIT_RESP, response,
-                                           sizeof(ScoreSubmitResponse));
+  return send_request_async(MSG_TYPE_SCORE_SUBMIT_REQ, &req_data, sizeof(ScoreSubmitRequest), MSG_TYPE_SCORE_SUBMIT_RESP, response,
+                            sizeof(ScoreSubmitResponse));
 }
 
-int send_leaderboard_request(LeaderboardResponse* response) {
-  return send_request_and_receive_response(MSG_TYPE_LEADERBOARD_REQ, NULL, 0, MSG_TYPE_LEADERBOARD_RESP, response, sizeof(LeaderboardResponse));
+int send_leaderboard_async(LeaderboardResponse* response) {
+  return send_request_async(MSG_TYPE_LEADERBOARD_REQ, NULL, 0, MSG_TYPE_LEADERBOARD_RESP, response, sizeof(LeaderboardResponse));
 }
 
+int send_leaderboard_request(LeaderboardResponse* response) { return wait_for_response(send_leaderboard_async(response)); }
+
 int send_logout_request(LogoutResponse* response) {
   return send_request_and_receive_response(MSG_TYPE_LOGOUT_REQ, NULL, 0, MSG_TYPE_LOGOUT_RESP, response, sizeof(LogoutResponse));
 }
 
 int send_wordlist_request(WordListResponse* resp) {
   return send_request_and_receive_response(MSG_TYPE_WORDLIST_REQ, NULL, 0, MSG_TYPE_WORDLIST_RESP, resp, sizeof(WordListResponse));
-}
\ No newline at end of file
+}
+void free_wordlist(char** words, int count) {
+  if (!words) return;
+  for (int i = 0; i < count; i++) {
+    free(words[i]);
+  }
+  free(words);
+}
+
+// pos 부터 [u8 len][bytes] count 개를 풀어 dst 에 채움, 다 읽은 위치 반환 (형식 오류 시 0, 채운 단어는 호출자가 해제)
+static size_t unpack_packed_words(const uint8_t* body, size_t body_len, size_t pos, uint32_t count, char** dst) {
+  for (uint32_t i = 0; i < count; i++) {
+    if (pos >= body_len) return 0;
+    uint8_t len = wire_get_u8(body + pos++);
+    if (pos + len > body_len) return 0;
+    char* word = malloc(len + 1);
+    if (!word) return 0;
+    memcpy(word, body + pos, len);
+    word[len] = '\0';
+    dst[i] = word;
+    pos += len;
+  }
+  return pos;
+}
+
+// 압축 응답 하나를 풀어 words[start..] 에 채움, 다음 요청 시작 번호 반환 (형식 오류 시 -1)
+static long unpack_wordlist_chunk(const uint8_t* body, size_t body_len, char*** words, int* total) {
+  if (body_len < WORDLIST_PACKED_HEADER_SIZE) return -1;
+  uint32_t chunk_total = wire_get_u32(body);
+  uint32_t start = wire_get_u32(body + 4);
+  uint16_t count = wire_get_u16(body + 8);
+
+  if (*words == NULL) {
+    if (chunk_total == 0 || chunk_total > (uint32_t)(INT32_MAX / sizeof(char*))) return -1;
+    *words = calloc(chunk_total, sizeof(char*));
+    if (!*words) return -1;
+    *total = (int)chunk_total;
+  }
+  if (chunk_total != (uint32_t)*total || start + count > chunk_total || count == 0) return -1;
+
+  if (unpack_packed_words(body, body_len, WORDLIST_PACKED_HEADER_SIZE, count, *words + start) == 0) return -1;
+  return (long)start + count;
+}
+
+// 기존 고정 크기 응답으로 받기 (압축 형식을 모르는 서버)
+static int fetch_wordlist_legacy(char*** words, int* count) {
+  WordListResponse* wresp = malloc(sizeof(WordListResponse));
+  if (!wresp) return -1;
+  int ret = send_wordlist_request(wresp);
+  if (ret != 0 || wresp->count <= 0 || wresp->count > MAX_WORDLIST_WORDS) {
+    free(wresp);
+    return ret != 0 ? ret : -1;
+  }
+
+  *words = calloc(wresp->count, sizeof(char*));
+  if (!*words) {
+    free(wresp);
+    return -1;
+  }
+  for (int i = 0; i < wresp->count; i++) {
+    wresp->words[i][MAX_WORD_STR_LEN - 1] = '\0';
+    (*words)[i] = strdup(wresp->words[i]);
+    if (!(*words)[i]) {
+      free_wordlist(*words, i);
+      *words = NULL;
+      free(wresp);
+      return -1;
+    }
+  }
+  *count = wresp->count;
+  free(wresp);
+  return 0;
+}
+
+// 압축 형식으로 받기 (조건부 요청을 모르는 서버)
+static int fetch_wordlist_packed(char*** words, int* count) {
+  uint8_t* body = malloc(WORDLIST_PACKED_MAX_BODY);
+  if (!body) return -1;
+
+  int total = 0;
+  long next = 0;
+  do {
+    uint8_t req[WORDLIST_PACKED_REQ_SIZE];
+    wire_put_u32(req, (uint32_t)next);
+
+    // 응답 길이는 헤더에만 있으므로 수신 전 버퍼를 비워 두고 실제 길이는 바디 안의 count 로 검증
+    memset(body, 0, WORDLIST_PACKED_MAX_BODY);
+    int ret = send_request_and_receive_response(MSG_TYPE_WORDLIST_PACKED_REQ, req, sizeof(req), MSG_TYPE_WORDLIST_PACKED_RESP, body,
+                                                WORDLIST_PACKED_MAX_BODY);
+    if (ret == -4 && next == 0) {
+      // 서버가 압축 형식을 모름 → 기존 방식
+      free(body);
+      return fetch_wordlist_legacy(words, count);
+    }
+    if (ret != 0) {
+      free_wordlist(*words, total);
+      *words = NULL;
+      free(body);
+      return ret;
+    }
+
+    next = unpack_wordlist_chunk(body, WORDLIST_PACKED_MAX_BODY, words, &total);
+    if (next < 0) {
+      free_wordlist(*words, total);
+      *words = NULL;
+      free(body);
+      return -7;
+    }
+  } while (next < total);
+
+  free(body);
+  *count = total;
+  return 0;
+}
+
+int fetch_wordlist(uint64_t if_none_match, char*** words, int* count, uint64_t* etag) {
+  *words = NULL;
+  *count = 0;
+  *etag = 0;
+
+  uint8_t* body = malloc(WORDLIST_PACKED_MAX_BODY);
+  if (!body) return -1;
+
+  int total = 0;
+  long next = 0;
+  int restarts = 0;
+  int ret;
+  uint64_t list_etag = 0;
+  while (1) {
+    // 처음 요청에만 가진 목록의 etag 를 실어 보냄 (이어 받는 중에는 받고 있는 목록의 etag)
+    uint8_t req[WORDLIST_COND_REQ_SIZE];
+    wire_put_u32(req, (uint32_t)next);
+    wire_put_u64(req + 4, next == 0 ? if_none_match : list_etag);
+
+    memset(body, 0, WORDLIST_PACKED_MAX_BODY);
+    ret = send_request_and_receive_response(MSG_TYPE_WORDLIST_COND_REQ, req, sizeof(req), MSG_TYPE_WORDLIST_COND_RESP, body,
+                                            WORDLIST_PACKED_MAX_BODY);
+    if (ret == -4 && next == 0) {
+      // 서버가 조건부 요청을 모름 → 캐시 없이 전체 수신
+      free(body);
+      return fetch_wordlist_packed(words, count);
+    }
+    if (ret != 0) break;
+
+    uint8_t status = wire_get_u8(body);
+    uint64_t chunk_etag = wire_get_u64(body + 1);
+    if (status == WORDLIST_COND_NOT_MODIFIED && next == 0 && chunk_etag != 0) {
+      free(body);
+      *etag = chunk_etag;
+      return 1;
+    }
+    if (status != WORDLIST_COND_MODIFIED || chunk_etag == 0) {
+      ret = -7;
+      break;
+    }
+
+    if (next > 0 && chunk_etag != list_etag) {
+      // 받는 도중 서버 목록이 교체됨 → 처음부터 다시 (계속 바뀌면 포기)
+      free_wordlist(*words, total);
+      *words = NULL;
+      total = 0;
+      next = 0;
+      if (++restarts > WORDLIST_MAX_RESTARTS) {
+        ret = -7;
+        break;
+      }
+      continue;
+    }
+    list_etag = chunk_etag;
+
+    next = unpack_wordlist_chunk(body + WORDLIST_COND_HEADER_SIZE, WORDLIST_PACKED_MAX_BODY - WORDLIST_COND_HEADER_SIZE, words, &total);
+    if (next < 0) {
+      ret = -7;
+      break;
+    }
+    if (next >= total) {
+      free(body);
+      *count = total;
+      *etag = list_etag;
+      return 0;
+    }
+  }
+
+  free_wordlist(*words, total);
+  *words = NULL;
+  free(body);
+  return ret;
+}
+
+int fetch_word_sample(int band, int count, char*** words, int* received) {
+  *words = NULL;
+  *received = 0;
+  if (count <= 0 || count > WORD_SAMPLE_MAX) count = WORD_SAMPLE_MAX;
+
+  size_t body_cap = WORD_SAMPLE_HEADER_SIZE + (size_t)count * MAX_WORD_STR_LEN;
+  uint8_t* body = calloc(1, body_cap);
+  if (!body) return -1;
+
+  uint8_t req[WORD_SAMPLE_REQ_SIZE];
+  wire_put_u8(req, (uint8_t)band);
+  wire_put_u8(req + 1, 0);  // 길이 제한 없음
+  wire_put_u8(req + 2, 0);
+  wire_put_u16(req + 3, (uint16_t)count);
+  int ret = send_request_and_receive_response(MSG_TYPE_WORD_SAMPLE_REQ, req, sizeof(req), MSG_TYPE_WORD_SAMPLE_RESP, body, body_cap);
+  if (ret != 0) {
+    free(body);
+    return ret;
+  }
+
+  uint16_t got = wire_get_u16(body + 5);
+  if (got == 0 || got > count) {
+    free(body);
+    return got == 0 ? 0 : -7;
+  }
+  char** list = calloc(got, sizeof(char*));
+  if (!list || unpack_packed_words(body, body_cap, WORD_SAMPLE_HEADER_SIZE, got, list) == 0) {
+    free_wordlist(list, got);
+    free(body);
+    return -7;
+  }
+  free(body);
+  *words = list;
+  *received = got;
+  return 0;
+}
+
+int send_word_stream_async(int flags, int band, int count, uint8_t* response, int response_max_len) {
+  uint8_t req[WORD_STREAM_REQ_SIZE];
+  wire_put_u8(req, (uint8_t)flags);
+  wire_put_u8(req + 1, (uint8_t)band);
+  wire_put_u16(req + 2, (uint16_t)count);
+  return send_request_async(MSG_TYPE_WORD_STREAM_REQ, req, sizeof(req), MSG_TYPE_WORD_STREAM_RESP, response, response_max_len);
+}
@@ -0,0 +1,446 @@
+// client/src/game_engine.c
+#include "game_engine.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+_Static_assert(MAX_WORDS <= PREFIX_INDEX_SLOTS, "prefix index needs a slot per word");
+_Static_assert(MAX_WORD_LEN - 1 <= PREFIX_INDEX_DEPTH, "prefix index must cover whole words");
+
+/* ======= 전역 변수 정의 ======= */
+WordManager g_word_manager = {0};
+ActiveWordHashTable g_active_words = {0};
+
+/* ---------- 타입별 드롭 속도 기본값 ---------- */
+int drop_interval_ms[WORD_TYPE_COUNT] = {
+    0,   /* WORD_NORMAL */
+    350, /* WORD_KILL */
+    200  /* WORD_BONUS */
+};
+
+void set_drop_interval(WordType type, int interval_ms) {
+  if (type >= 0 && type < WORD_TYPE_COUNT && type != WORD_NORMAL && interval_ms > 50) drop_interval_ms[type] = interval_ms;
+}
+
+/* ========== 메모리 관리 함수 구현 ========== */
+
+int init_word_manager(void) {
+  if (g_word_manager.is_initialized) {
+    return 1;  // 이미 초기화됨
+  }
+
+  g_word_manager.capacity = 100;  // 초기 용량
+  g_word_manager.words = malloc(sizeof(char*) * g_word_manager.capacity);
+  if (!g_word_manager.words) {
+    return 0;  // 메모리 할당 실패
+  }
+
+  g_word_manager.count = 0;
+  g_word_manager.is_initialized = true;
+  return 1;
+}
+
+void cleanup_word_manager(void) {
+  if (!g_word_manager.is_initialized) {
+    return;
+  }
+
+  // 모든 단어 문자열 해제
+  for (int i = 0; i < g_word_manager.count; i++) {
+    if (g_word_manager.words[i]) {
+      free(g_word_manager.words[i]);
+      g_word_manager.words[i] = NULL;
+    }
+  }
+
+  // 단어 배열 해제
+  if (g_word_manager.words) {
+    free(g_word_manager.words);
+    g_word_manager.words = NULL;
+  }
+
+  g_word_manager.count = 0;
+  g_word_manager.capacity = 0;
+  g_word_manager.is_initialized = false;
+}
+
+int load_words_from_response(const char* words[], int count) {
+  if (!g_word_manager.is_initialized) {
+    if (!init_word_manager()) {
+      return 0;
+    }
+  }
+
+  // 기존 단어들 정리
+  cleanup_word_manager();
+  if (!init_word_manager()) {
+    return 0;
+  }
+
+  // 필요하면 용량 확장
+  if (count > g_word_manager.capacity) {
+    int new_capacity = count + 10;
+    char** new_words = realloc(g_word_manager.words, sizeof(char*) * new_capacity);
+    if (!new_words) {
+      return 0;
+    }
+    g_word_manager.words = new_words;
+    g_word_manager.capacity = new_capacity;
+  }
+
+  // 단어들 복사
+  for (int i = 0; i < count; i++) {
+    g_word_manager.words[i] = strdup(words[i]);
+    if (!g_word_manager.words[i]) {
+      // 메모리 할당 실패 시 이미 할당된 것들 정리
+      for (int j = 0; j < i; j++) {
+        free(g_word_manager.words[j]);
+      }
+      g_word_manager.count = 0;
+      return 0;
+    }
+  }
+
+  g_word_manager.count = count;
+  return 1;
+}
+
+/* ========== 활성 단어 해시 테이블 구현 ========== */
+
+_Static_assert((HASH_TABLE_SIZE & (HASH_TABLE_SIZE - 1)) == 0, "HASH_TABLE_SIZE must be a power of two");
+_Static_assert(HASH_TABLE_SIZE >= 2 * MAX_WORDS, "active word table needs free slots to keep probes short");
+
+// 단어는 MAX_WORD_LEN - 1 글자까지만 저장하므로 해시와 비교도 그 길이까지만
+static uint32_t hash_function(const char* str) {
+  uint32_t hash = 5381;
+  for (int i = 0; i < MAX_WORD_LEN - 1 && str[i] != '\0'; i++) {
+    hash = ((hash << 5) + hash) + (unsigned char)str[i]; /* hash * 33 + c */
+  }
+  return hash;
+}
+
+// word 가 있는 슬롯 (없으면 -1)
+static int find_active_slot(const char* word, uint32_t hash) {
+  for (uint32_t i = hash & (HASH_TABLE_SIZE - 1);; i = (i + 1) & (HASH_TABLE_SIZE - 1)) {
+    uint16_t node = g_active_words.slots[i];
+    if (node == ACTIVE_WORD_NONE) return -1;
+    if (g_active_words.nodes[node].hash == hash && strncmp(g_active_words.nodes[node].word, word, MAX_WORD_LEN - 1) == 0) return (int)i;
+  }
+}
+
+int init_active_word_table(void) {
+  for (int i = 0; i < HASH_TABLE_SIZE; i++) {
+    g_active_words.slots[i] = ACTIVE_WORD_NONE;
+  }
+  for (int i = 0; i < MAX_WORDS; i++) {
+    g_active_words.nodes[i].next_free = (i + 1 < MAX_WORDS) ? (uint16_t)(i + 1) : ACTIVE_WORD_NONE;
+  }
+  g_active_words.free_head = 0;
+  g_active_words.total_count = 0;
+  return 1;
+}
+
+void cleanup_active_word_table(void) { init_active_word_table(); }
+
+bool add_active_word(const char* word) {
+  if (!word) return false;
+
+  uint32_t hash = hash_function(word);
+
+  // 이미 존재하거나 노드가 모두 쓰였으면 실패 (슬롯은 노드보다 많으므로 빈 슬롯이 항상 있음)
+  if (find_active_slot(word, hash) >= 0 || g_active_words.free_head == ACTIVE_WORD_NONE) {
+    return false;
+  }
+
+  uint16_t node = g_active_words.free_head;
+  ActiveWordNode* n = &g_active_words.nodes[node];
+  g_active_words.free_head = n->next_free;
+  strncpy(n->word, word, MAX_WORD_LEN - 1);
+  n->word[MAX_WORD_LEN - 1] = '\0';
+  n->hash = hash;
+
+  uint32_t i = hash & (HASH_TABLE_SIZE - 1);
+  while (g_active_words.slots[i] != ACTIVE_WORD_NONE) {
+    i = (i + 1) & (HASH_TABLE_SIZE - 1);
+  }
+  g_active_words.slots[i] = node;
+  g_active_words.total_count++;
+  return true;
+}
+
+bool remove_active_word(const char* word) {
+  if (!word) return false;
+
+  int found = find_active_slot(word, hash_function(word));
+  if (found < 0) {
+    return false;
+  }
+
+  uint16_t node = g_active_words.slots[found];
+  g_active_words.nodes[node].next_free = g_active_words.free_head;
+  g_active_words.free_head = node;
+  g_active_words.total_count--;
+
+  // 뒤쪽 연속 구간에서 원래 자리(home)가 빈 칸 이전인 항목을 당겨 탐사 사슬을 유지
+  uint32_t hole = (uint32_t)found;
+  for (uint32_t j = (hole + 1) & (HASH_TABLE_SIZE - 1); g_active_words.slots[j] != ACTIVE_WORD_NONE; j = (j + 1) & (HASH_TABLE_SIZE - 1)) {
+    uint32_t home = g_active_words.nodes[g_active_words.slots[j]].hash & (HASH_TABLE_SIZE - 1);
+    bool stays = (hole <= j) ? (hole < home && home <= j) : (hole < home || home <= j);
+    if (!stays) {
+      g_active_words.slots[hole] = g_active_words.slots[j];
+      hole = j;
+    }
+  }
+  g_active_words.slots[hole] = ACTIVE_WORD_NONE;
+  return true;
+}
+
+bool is_word_in_active_table(const char* word) {
+  if (!word) return false;
+  return find_active_slot(word, hash_function(word)) >= 0;
+}
+
+/* ========== 게임 엔진 ========== */
+
+// xorshift32: 시드만 같으면 플랫폼과 무관하게 같은 수열 (rand() 전역 상태와 분리)
+static uint32_t engine_rand(GameEngine* engine) {
+  uint32_t x = engine->rng_state;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  engine->rng_state = x;
+  return x;
+}
+
+int game_engine_level(const GameEngine* engine) {
+  int s = engine->score;
+
+  if (s >= 200) return 5;
+  if (s >= 150) return 4;
+  if (s >= 100) return 3;
+  if (s >= 50) return 2;
+  return 1;
+}
+
+static int get_normal_drop_interval(const GameEngine* engine) {
+  int s = engine->score;
+
+  if (s >= 200) return 200;
+  if (s >= 150) return 275;
+  if (s >= 100) return 350;
+  if (s >= 50) return 425;
+  return 500;
+}
+
+void game_engine_init(GameEngine* engine, int area_width, int area_height, uint32_t seed, char* const* dictionary, int dictionary_count) {
+  memset(engine, 0, sizeof(*engine));
+  engine->area_width = area_width;
+  engine->area_height = area_height;
+  engine->rng_state = seed ? seed : 0x9E3779B9u; /* xorshift 는 0 상태에서 벗어나지 못함 */
+  engine->dictionary = dictionary;
+  engine->dictionary_count = dictionary_count;
+  engine->lives = INITIAL_LIVES;
+  prefix_index_init(&engine->active_prefix);
+  engine->input_node = 0;
+}
+
+// 색인이 바뀌면 노드 번호가 재사용될 수 있으므로 입력 위치를 다시 찾음
+static void refresh_input_node(GameEngine* engine) { engine->input_node = prefix_index_find(&engine->active_prefix, engine->input); }
+
+// 슬롯의 단어를 화면에서 제거 (활성 단어 테이블, 접두사 색인 포함)
+static void deactivate_word(GameEngine* engine, int slot) {
+  Word* w = &engine->words[slot];
+  w->active = false;
+  remove_active_word(w->text);
+  prefix_index_remove(&engine->active_prefix, w->text, slot);
+  refresh_input_node(engine);
+}
+
+bool game_engine_is_candidate(const GameEngine* engine, int slot) {
+  if (engine->input_pos == 0 || engine->input_node == PREFIX_NODE_NONE || !engine->words[slot].active) return false;
+  return prefix_mask_test(&engine->active_prefix.nodes[engine->input_node].subtree, slot);
+}
+
+void game_engine_set_word_source(GameEngine* engine, GameWordSource source, void* ctx) {
+  engine->word_source = source;
+  engine->word_source_ctx = ctx;
+}
+
+#define SOURCE_PICK_TRIES 4 /* 공급원 단어가 화면의 단어와 겹칠 때 더 받아 보는 횟수 */
+
+// 새로 내릴 단어 (공급원 → 사전 순), 고를 단어가 없으면 NULL
+static const char* pick_spawn_word(GameEngine* engine) {
+  const char* pick = NULL;
+  if (engine->word_source) {
+    for (int tries = 0; tries < SOURCE_PICK_TRIES; tries++) {
+      const char* next = engine->word_source(engine->word_source_ctx);
+      if (next == NULL) break;
+      pick = next;
+      if (!is_word_in_active_table(pick)) return pick;
+    }
+  }
+  if (engine->dictionary == NULL || engine->dictionary_count == 0) {
+    return pick;
+  }
+
+  // 해시 테이블을 이용한 중복 확인으로 성능 개선
+  int tries = 0;
+  do {
+    pick = engine->dictionary[engine_rand(engine) % engine->dictionary_count];
+    tries++;
+    if (tries > engine->dictionary_count) break;
+  } while (is_word_in_active_table(pick));
+  return pick;
+}
+
+static void spawn_word(GameEngine* engine) {
+  for (int i = 0; i < MAX_WORDS; ++i) {
+    Word* w = &engine->words[i];
+    if (!w->active) {
+      const char* pick = pick_spawn_word(engine);
+      if (pick == NULL) {
+        return;
+      }
+
+      strncpy(w->text, pick, MAX_WORD_LEN - 1);
+      w->text[MAX_WORD_LEN - 1] = '\0';
+      w->y = 0;
+      int len = strlen(w->text);
+      w->x = (engine->area_width > len) ? engine_rand(engine) % (engine->area_width - len + 1) : 0;
+      w->active = true;
+      w->wtype = (engine_rand(engine) % 100 < 20) ? WORD_KILL : (engine_rand(engine) % 100 < 30) ? WORD_BONUS : WORD_NORMAL;
+
+      // 활성 단어 테이블, 접두사 색인에 추가
+      add_active_word(w->text);
+      prefix_index_insert(&engine->active_prefix, w->text, i);
+      refresh_input_node(engine);
+      break;
+    }
+  }
+}
+
+/*
+ * 시뮬레이션 한 스텝 (SIM_TICK_MS)
+ * - 타입별 누적 시간이 낙하 간격을 넘으면 그 타입의 모든 단어가 한 칸 내려감
+ * - 바닥에 닿은 단어는 제거하고 생명 감소 (KILL 단어 제외)
+ */
+void game_engine_tick(GameEngine* engine) {
+  if (engine->over) return;
+  engine->clock_ms += SIM_TICK_MS;
+
+  int drop_steps[WORD_TYPE_COUNT];
+  for (int t = 0; t < WORD_TYPE_COUNT; ++t) {
+    int interval = (t == WORD_NORMAL) ? get_normal_drop_interval(engine) : drop_interval_ms[t];
+    engine->drop_accum_ms[t] += SIM_TICK_MS;
+    drop_steps[t] = 0;
+    while (engine->drop_accum_ms[t] >= interval) {
+      engine->drop_accum_ms[t] -= interval;
+      drop_steps[t]++;
+    }
+  }
+
+  for (int i = 0; i < MAX_WORDS && !engine->over; ++i) {
+    Word* w = &engine->words[i];
+    if (!w->active || drop_steps[w->wtype] == 0) continue;
+
+    w->y += drop_steps[w->wtype];
+    if (w->y >= engine->area_height) {
+      deactivate_word(engine, i);
+      if (w->wtype != WORD_KILL) engine->lives--;
+      if (engine->lives <= 0) engine->over = true;
+    }
+  }
+
+  engine->spawn_accum_ms += SIM_TICK_MS;
+  if (engine->spawn_accum_ms >= WORD_SPAWN_RATE_MS && !engine->over) {
+    engine->spawn_accum_ms -= WORD_SPAWN_RATE_MS;
+    spawn_word(engine);
+  }
+}
+
+int game_engine_advance(GameEngine* engine, long elapsed_ms, int max_ticks) {
+  engine->pending_ms += elapsed_ms;
+
+  int ticks = 0;
+  while (engine->pending_ms >= SIM_TICK_MS && !engine->over) {
+    game_engine_tick(engine);
+    engine->pending_ms -= SIM_TICK_MS;
+    if (max_ticks > 0 && ++ticks >= max_ticks) {
+      engine->pending_ms = 0;  // 밀린 시간은 버리고 현재 시각부터 다시 진행
+      return ticks;
+    }
+  }
+  return ticks;
+}
+
+// 입력 확정: 입력과 같은 단어 중 KILL > BONUS > NORMAL, 같으면 가장 아래 단어를 맞춤
+// 입력과 정확히 같은 단어는 입력 노드의 terminal 슬롯뿐이므로 전체 단어와 비교하지 않음
+static void submit_input(GameEngine* engine) {
+  int target_idx = -1;
+  int best_prio = 3;
+  int best_y = -1;
+
+  if (engine->input_node != PREFIX_NODE_NONE) {
+    const PrefixSlotMask* exact = &engine->active_prefix.nodes[engine->input_node].terminal;
+    for (int m = 0; m < PREFIX_MASK_WORDS; m++) {
+      for (uint64_t bits = exact->bits[m]; bits != 0; bits &= bits - 1) {
+        int i = m * 64 + __builtin_ctzll(bits);
+        const Word* w = &engine->words[i];
+        int prio = (w->wtype == WORD_KILL) ? 0 : (w->wtype == WORD_BONUS) ? 1 : 2;
+
+        if (prio < best_prio || (prio == best_prio && w->y > best_y)) {
+          best_prio = prio;
+          best_y = w->y;
+          target_idx = i;
+        }
+      }
+    }
+  }
+
+  engine->input[0] = '\0';
+  engine->input_pos = 0;
+
+  if (target_idx != -1) {
+    Word* w = &engine->words[target_idx];
+    deactivate_word(engine, target_idx);
+
+    if (w->wtype == WORD_KILL)
+      engine->over = true;
+    else {
+      if (w->wtype == WORD_BONUS) engine->score += 50;
+      engine->score += strlen(w->text);
+    }
+  }
+  engine->input_node = 0;
+}
+
+void game_engine_input(GameEngine* engine, int ch) {
+  if (engine->over) return;
+
+  if (ch == '\n' || ch == ' ') {
+    if (engine->input_pos > 0) submit_input(engine);
+  } else if (ch == GAME_KEY_BACKSPACE || ch == 127) {
+    if (engine->input_pos > 0) {
+      engine->input[--engine->input_pos] = '\0';
+      refresh_input_node(engine);
+    }
+  } else if (ch >= 32 && ch <= 126 && engine->input_pos < INPUT_BUFFER_LEN - 1) {
+    // 한 글자 입력은 자식 노드 하나로 내려가는 것으로 끝 (후보 집합이 바로 나옴)
+    engine->input_node = engine->input_pos < PREFIX_INDEX_DEPTH ? prefix_index_step(&engine->active_prefix, engine->input_node, (char)ch)
+                                                               : PREFIX_NODE_NONE;
+    engine->input[engine->input_pos++] = (char)ch;
+    engine->input[engine->input_pos] = '\0';
+  }
+}
+
+void game_engine_clear(GameEngine* engine) {
+  for (int i = 0; i < MAX_WORDS; ++i) {
+    if (engine->words[i].active) {
+      remove_active_word(engine->words[i].text);
+    }
+    engine->words[i].active = false;
+    engine->words[i].text[0] = '\0';
+  }
+  prefix_index_init(&engine->active_prefix);
+  refresh_input_node(engine);
+}
@@ -0,0 +1,115 @@
+// client/src/prefix_index.c
+#include "prefix_index.h"
+
+#include <string.h>
+
+static void mask_set(PrefixSlotMask* mask, int slot) { mask->bits[slot / 64] |= 1ULL << (slot % 64); }
+
+static void mask_clear(PrefixSlotMask* mask, int slot) { mask->bits[slot / 64] &= ~(1ULL << (slot % 64)); }
+
+static bool mask_empty(const PrefixSlotMask* mask) {
+  for (int i = 0; i < PREFIX_MASK_WORDS; i++) {
+    if (mask->bits[i] != 0) return false;
+  }
+  return true;
+}
+
+void prefix_index_init(PrefixIndex* index) {
+  memset(&index->nodes[0], 0, sizeof(PrefixNode));
+  index->nodes[0].first_child = PREFIX_NODE_NONE;
+  index->nodes[0].next_sibling = PREFIX_NODE_NONE;
+
+  // 나머지 노드는 빈 목록으로 연결
+  for (int i = 1; i < PREFIX_INDEX_NODES; i++) {
+    index->nodes[i].next_sibling = (i + 1 < PREFIX_INDEX_NODES) ? (uint16_t)(i + 1) : PREFIX_NODE_NONE;
+  }
+  index->free_head = PREFIX_INDEX_NODES > 1 ? 1 : PREFIX_NODE_NONE;
+}
+
+uint16_t prefix_index_step(const PrefixIndex* index, uint16_t from, char ch) {
+  if (from == PREFIX_NODE_NONE) return PREFIX_NODE_NONE;
+  uint16_t child = index->nodes[from].first_child;
+  while (child != PREFIX_NODE_NONE && index->nodes[child].ch != ch) {
+    child = index->nodes[child].next_sibling;
+  }
+  return child;
+}
+
+uint16_t prefix_index_find(const PrefixIndex* index, const char* prefix) {
+  uint16_t node = 0;
+  for (int depth = 0; prefix[depth] != '\0' && node != PREFIX_NODE_NONE; depth++) {
+    node = depth < PREFIX_INDEX_DEPTH ? prefix_index_step(index, node, prefix[depth]) : PREFIX_NODE_NONE;
+  }
+  return node;
+}
+
+void prefix_index_insert(PrefixIndex* index, const char* word, int slot) {
+  if (slot < 0 || slot >= PREFIX_INDEX_SLOTS) return;
+
+  uint16_t node = 0;
+  mask_set(&index->nodes[0].subtree, slot);
+  for (int depth = 0; word[depth] != '\0' && depth < PREFIX_INDEX_DEPTH; depth++) {
+    uint16_t child = prefix_index_step(index, node, word[depth]);
+    if (child == PREFIX_NODE_NONE) {
+      // 풀 크기가 (슬롯 수 × 최대 깊이) 이상이므로 모자라지 않음
+      child = index->free_head;
+      if (child == PREFIX_NODE_NONE) break;
+      PrefixNode* fresh = &index->nodes[child];
+      index->free_head = fresh->next_sibling;
+      memset(fresh, 0, sizeof(*fresh));
+      fresh->ch = word[depth];
+      fresh->first_child = PREFIX_NODE_NONE;
+      fresh->next_sibling = index->nodes[node].first_child;
+      index->nodes[node].first_child = child;
+    }
+    node = child;
+    mask_set(&index->nodes[node].subtree, slot);
+  }
+  mask_set(&index->nodes[node].terminal, slot);
+}
+
+void prefix_index_remove(PrefixIndex* index, const char* word, int slot) {
+  if (slot < 0 || slot >= PREFIX_INDEX_SLOTS) return;
+
+  // 경로를 따라 비트를 지우고, 더 이상 어떤 단어도 지나지 않는 노드는 부모에서 떼어 풀에 반납
+  uint16_t parent = 0;
+  mask_clear(&index->nodes[0].subtree, slot);
+  int len = 0;
+  while (word[len] != '\0' && len < PREFIX_INDEX_DEPTH) len++;
+  if (len == 0) {
+    mask_clear(&index->nodes[0].terminal, slot);
+    return;
+  }
+
+  for (int depth = 0; depth < len; depth++) {
+    uint16_t prev = PREFIX_NODE_NONE;
+    uint16_t node = index->nodes[parent].first_child;
+    while (node != PREFIX_NODE_NONE && index->nodes[node].ch != word[depth]) {
+      prev = node;
+      node = index->nodes[node].next_sibling;
+    }
+    if (node == PREFIX_NODE_NONE) return;  // 추가하지 않은 단어
+
+    PrefixNode* n = &index->nodes[node];
+    mask_clear(&n->subtree, slot);
+    if (depth == len - 1) mask_clear(&n->terminal, slot);
+
+    if (mask_empty(&n->subtree)) {
+      // 아래 노드들도 모두 이 슬롯만 지나던 노드 → 서브트리 전체를 반납
+      if (prev == PREFIX_NODE_NONE) {
+        index->nodes[parent].first_child = n->next_sibling;
+      } else {
+        index->nodes[prev].next_sibling = n->next_sibling;
+      }
+      uint16_t release = node;
+      while (release != PREFIX_NODE_NONE) {
+        uint16_t next = index->nodes[release].first_child;
+        index->nodes[release].next_sibling = index->free_head;
+        index->free_head = release;
+        release = next;
+      }
+      return;
+    }
+    parent = node;
+  }
+}
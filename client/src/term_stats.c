@@ -0,0 +1,49 @@
+// client/src/term_stats.c
+#include "term_stats.h"
+
+#include <unistd.h>
+
+static unsigned long long total_bytes = 0;
+
+static unsigned long long window_start_bytes = 0;
+static long window_start_ms = -1;
+static unsigned long last_rate = 0;
+
+#ifdef TERM_STATS_WRAP_WRITE
+/*
+ * 계측 빌드(make client-stats) 전용: -Wl,--wrap=write 로 정적 링크한 ncurses 의 write() 호출이 여기로 옴
+ * 기록은 libc write() 로 그대로 넘기고 stdout 으로 나간 바이트만 누적
+ */
+ssize_t __real_write(int fd, const void* buf, size_t count);
+
+ssize_t __wrap_write(int fd, const void* buf, size_t count) {
+  ssize_t written = __real_write(fd, buf, count);
+  if (fd == STDOUT_FILENO && written > 0) {
+    __atomic_add_fetch(&total_bytes, (unsigned long long)written, __ATOMIC_RELAXED);
+  }
+  return written;
+}
+
+int term_stats_available(void) { return 1; }
+#else
+int term_stats_available(void) { return 0; }
+#endif
+
+unsigned long long term_stats_total_bytes(void) { return __atomic_load_n(&total_bytes, __ATOMIC_RELAXED); }
+
+unsigned long term_stats_bytes_per_sec(long now_ms) {
+  unsigned long long total = term_stats_total_bytes();
+  if (window_start_ms < 0) {
+    window_start_ms = now_ms;
+    window_start_bytes = total;
+    return 0;
+  }
+
+  long elapsed = now_ms - window_start_ms;
+  if (elapsed >= 1000) {
+    last_rate = (unsigned long)((total - window_start_bytes) * 1000 / elapsed);
+    window_start_ms = now_ms;
+    window_start_bytes = total;
+  }
+  return last_rate;
+}
@@ -0,0 +1,155 @@
+// client/src/word_cache.c
+#include "word_cache.h"
+
+#include <fcntl.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "wire_codec.h"
+
+#define WORD_CACHE_MAGIC "RWC1"
+#define WORD_CACHE_HEADER_SIZE 16           /* magic 4 + etag 8 + count 4 */
+#define WORD_CACHE_MAX_FILE_SIZE (64 << 20) /* 이보다 크면 손상으로 간주 */
+#define WORD_CACHE_FILE_NAME ".rain_words.cache"
+
+static int word_cache_path(char* path, size_t size) {
+  const char* env = getenv("RAIN_WORD_CACHE");
+  if (env && env[0] != '\0') {
+    return snprintf(path, size, "%s", env) < (int)size ? 0 : -1;
+  }
+  const char* home = getenv("HOME");
+  if (!home || home[0] == '\0') {
+    return -1;
+  }
+  return snprintf(path, size, "%s/%s", home, WORD_CACHE_FILE_NAME) < (int)size ? 0 : -1;
+}
+
+// 파일 전체를 읽음 (반환값은 malloc 된 버퍼, 실패 시 NULL)
+static uint8_t* read_whole_file(const char* path, size_t* len) {
+  int fd = open(path, O_RDONLY);
+  if (fd < 0) return NULL;
+
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size < WORD_CACHE_HEADER_SIZE || st.st_size > WORD_CACHE_MAX_FILE_SIZE) {
+    close(fd);
+    return NULL;
+  }
+
+  size_t size = (size_t)st.st_size;
+  uint8_t* buf = malloc(size);
+  size_t done = 0;
+  while (buf && done < size) {
+    ssize_t n = read(fd, buf + done, size - done);
+    if (n <= 0) {
+      free(buf);
+      buf = NULL;
+      break;
+    }
+    done += (size_t)n;
+  }
+  close(fd);
+  *len = size;
+  return buf;
+}
+
+static void free_words(char** words, int count) {
+  for (int i = 0; i < count; i++) {
+    free(words[i]);
+  }
+  free(words);
+}
+
+int word_cache_load(uint64_t* etag, char*** words, int* count) {
+  char path[PATH_MAX];
+  size_t len;
+  uint8_t* buf = word_cache_path(path, sizeof(path)) == 0 ? read_whole_file(path, &len) : NULL;
+  if (!buf) return -1;
+
+  uint64_t stored_etag = wire_get_u64(buf + 4);
+  uint32_t stored_count = wire_get_u32(buf + 12);
+  const uint8_t* packed = buf + WORD_CACHE_HEADER_SIZE;
+  size_t packed_len = len - WORD_CACHE_HEADER_SIZE;
+
+  // 헤더와 내용 해시가 모두 맞아야 사용 (중간에 잘린 파일, 다른 형식 거부)
+  if (memcmp(buf, WORD_CACHE_MAGIC, 4) != 0 || stored_count == 0 || stored_count > packed_len ||
+      wire_wordlist_etag(packed, packed_len) != stored_etag) {
+    free(buf);
+    return -1;
+  }
+
+  char** list = calloc(stored_count, sizeof(char*));
+  size_t pos = 0;
+  uint32_t parsed = 0;
+  while (list && parsed < stored_count && pos < packed_len) {
+    uint8_t word_len = wire_get_u8(packed + pos++);
+    if (pos + word_len > packed_len) break;
+    char* word = malloc(word_len + 1);
+    if (!word) break;
+    memcpy(word, packed + pos, word_len);
+    word[word_len] = '\0';
+    list[parsed++] = word;
+    pos += word_len;
+  }
+  free(buf);
+
+  if (!list || parsed != stored_count || pos != packed_len) {
+    if (list) free_words(list, (int)parsed);
+    return -1;
+  }
+
+  *etag = stored_etag;
+  *words = list;
+  *count = (int)stored_count;
+  return 0;
+}
+
+int word_cache_save(uint64_t etag, char* const* words, int count) {
+  char path[PATH_MAX];
+  char tmp_path[PATH_MAX + 32];
+  if (count <= 0 || word_cache_path(path, sizeof(path)) != 0) return -1;
+  snprintf(tmp_path, sizeof(tmp_path), "%s.tmp.%d", path, (int)getpid());
+
+  size_t size = WORD_CACHE_HEADER_SIZE;
+  for (int i = 0; i < count; i++) {
+    size_t word_len = strlen(words[i]);
+    if (word_len > UINT8_MAX) return -1;
+    size += 1 + word_len;
+  }
+
+  uint8_t* buf = malloc(size);
+  if (!buf) return -1;
+  memcpy(buf, WORD_CACHE_MAGIC, 4);
+  wire_put_u64(buf + 4, etag);
+  wire_put_u32(buf + 12, (uint32_t)count);
+  size_t pos = WORD_CACHE_HEADER_SIZE;
+  for (int i = 0; i < count; i++) {
+    size_t word_len = strlen(words[i]);
+    wire_put_u8(buf + pos++, (uint8_t)word_len);
+    memcpy(buf + pos, words[i], word_len);
+    pos += word_len;
+  }
+
+  int fd = open(tmp_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    free(buf);
+    return -1;
+  }
+  size_t done = 0;
+  while (done < size) {
+    ssize_t n = write(fd, buf + done, size - done);
+    if (n <= 0) break;
+    done += (size_t)n;
+  }
+  free(buf);
+
+  // 다 쓴 파일만 rename 으로 교체 (읽는 쪽은 항상 완전한 파일을 봄)
+  if (close(fd) != 0 || done != size || rename(tmp_path, path) != 0) {
+    unlink(tmp_path);
+    return -1;
+  }
+  return 0;
+}
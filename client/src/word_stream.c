@@ -0,0 +1,122 @@
+// client/src/word_stream.c
+#include "word_stream.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include "client_network.h"
+#include "protocol.h"
+#include "wire_codec.h"
+
+#define WORD_STREAM_LOW_WATER (WORD_STREAM_CAPACITY / 2) /* 이 이하로 줄면 다음 묶음 요청 */
+#define WORD_STREAM_RESP_MAX (WORD_SAMPLE_HEADER_SIZE + WORD_STREAM_CAPACITY * MAX_WORD_STR_LEN)
+
+/* 받은 단어 링 버퍼: ring[(ring_head + i) % WORD_STREAM_CAPACITY], i < ring_count */
+static char ring[WORD_STREAM_CAPACITY][MAX_WORD_STR_LEN];
+static int ring_head = 0;
+static int ring_count = 0;
+
+static bool stream_active = false;
+static int stream_band = WORD_BAND_ANY;
+
+/* 응답을 기다리는 요청 (없으면 -1), 요청한 개수는 보낼 때의 빈 칸 수이므로 도착하면 항상 들어감 */
+static int inflight_handle = -1;
+static int inflight_credit = 0;
+static uint8_t response[WORD_STREAM_RESP_MAX];
+
+// 빈 칸 수만큼 다음 단어 요청
+static int request_more(int flags) {
+  int credit = WORD_STREAM_CAPACITY - ring_count;
+  memset(response, 0, sizeof(response));
+  int handle = send_word_stream_async(flags, stream_band, credit, response, sizeof(response));
+  if (handle < 0) {
+    return handle;
+  }
+  inflight_handle = handle;
+  inflight_credit = credit;
+  return 0;
+}
+
+// 도착한 응답의 단어를 버퍼 뒤에 추가, 추가한 수 (형식 오류 시 -7)
+static int append_response(void) {
+  uint16_t count = wire_get_u16(response + 5);
+  if (count > inflight_credit) {
+    return -7;
+  }
+
+  size_t pos = WORD_SAMPLE_HEADER_SIZE;
+  for (int i = 0; i < count; i++) {
+    uint8_t len = wire_get_u8(response + pos++);
+    if (len >= MAX_WORD_STR_LEN || pos + len > sizeof(response)) {
+      return -7;
+    }
+    char* slot = ring[(ring_head + ring_count) % WORD_STREAM_CAPACITY];
+    memcpy(slot, response + pos, len);
+    slot[len] = '\0';
+    pos += len;
+    ring_count++;
+  }
+  return count;
+}
+
+// 보낸 요청의 응답을 기다려 버퍼에 넣음, 추가한 수 또는 음수
+static int finish_request(void) {
+  int ret = wait_for_response(inflight_handle);
+  inflight_handle = -1;
+  return ret == 0 ? append_response() : ret;
+}
+
+int word_stream_start(int band) {
+  word_stream_stop();
+  stream_band = band;
+  ring_head = 0;
+  ring_count = 0;
+
+  int ret = request_more(WORD_STREAM_RESTART);
+  if (ret == 0) {
+    ret = finish_request();
+  }
+  stream_active = ret > 0;
+  return ret;
+}
+
+bool word_stream_active(void) { return stream_active; }
+
+const char* word_stream_next(void* ctx) {
+  (void)ctx;
+  if (ring_count == 0) {
+    return NULL;
+  }
+  const char* word = ring[ring_head];
+  ring_head = (ring_head + 1) % WORD_STREAM_CAPACITY;
+  ring_count--;
+  return word;
+}
+
+void word_stream_pump(void) {
+  if (!stream_active) {
+    return;
+  }
+  if (inflight_handle >= 0) {
+    if (poll_response(inflight_handle) == 0) {
+      return;
+    }
+    if (finish_request() <= 0) {
+      stream_active = false;  // 연결 오류 또는 리로드로 구간이 빔: 남은 버퍼 (그리고 사전) 로 계속
+      return;
+    }
+  }
+  if (ring_count <= WORD_STREAM_LOW_WATER && request_more(0) != 0) {
+    stream_active = false;
+  }
+}
+
+void word_stream_stop(void) {
+  if (inflight_handle >= 0) {
+    wait_for_response(inflight_handle);
+    inflight_handle = -1;
+  }
+  stream_active = false;
+  ring_head = 0;
+  ring_count = 0;
+}
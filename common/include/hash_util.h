@@ -2,6 +2,7 @@
 #ifndef CRYPTO_UTILS_H
 #define CRYPTO_UTILS_H
 
+#include <stddef.h>
 #include <stdint.h>
 
 /* SHA-256 해시 길이 상수 */
@@ -16,6 +17,14 @@
  */
 int hash_password_sha256(const char* password, char* hash_output);
 
+/*
+ * 문자열을 FNV-1a 64비트 해시로 변환 (해시 테이블 인덱스용, 암호화 용도 아님)
+ */
+uint64_t hash_string_fnv1a(const char* str);
+
+/* 바이트 배열용 FNV-1a 64 (내용 변경 감지용) */
+uint64_t hash_bytes_fnv1a(const void* data, size_t len);
+
 /*
  * 암호화 시스템 초기화 (OpenSSL 초기화)
  * 반환값: 성공 시 1, 실패 시 0
@@ -0,0 +1,44 @@
+// common/include/latency_histogram.h
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <stdint.h>
+
+/*
+ * 고정 메모리 로그-선형 히스토그램 (HDR 히스토그램 방식)
+ * - 2의 거듭제곱 구간마다 16 칸으로 나눠 상대 오차 약 6% 이내
+ * - 값 단위는 호출자가 정함 (보통 마이크로초)
+ * - 기록은 O(1), 락 없음: 스레드마다 하나씩 두고 마지막에 merge
+ */
+#define LATENCY_HIST_SUB_BUCKETS 16
+#define LATENCY_HIST_BUCKETS (61 * LATENCY_HIST_SUB_BUCKETS)
+
+typedef struct {
+  uint64_t counts[LATENCY_HIST_BUCKETS];
+  uint64_t total;
+  uint64_t max;
+  uint64_t sum;
+} LatencyHistogram;
+
+void latency_hist_init(LatencyHistogram* hist);
+
+void latency_hist_record(LatencyHistogram* hist, uint64_t value);
+
+/* src 의 기록을 dst 에 더함 */
+void latency_hist_merge(LatencyHistogram* dst, const LatencyHistogram* src);
+
+/*
+ * 한 스레드만 기록하고 다른 스레드가 기록 도중에 읽는 히스토그램용 (서버 지표)
+ * 필드마다 relaxed 원자 읽기/쓰기만 하므로 lock 접두어 없이 기록 비용은 latency_hist_record 와 같음
+ * 읽는 쪽은 칸 사이의 순간적인 불일치(total 과 counts 합이 하나 어긋나는 정도)를 허용
+ */
+void latency_hist_record_shared(LatencyHistogram* hist, uint64_t value);
+void latency_hist_merge_shared(LatencyHistogram* dst, const LatencyHistogram* src);
+
+/*
+ * 백분위 값 (percentile: 0~100, 예: 99.9)
+ * 해당 칸의 상한값을 반환, 기록이 없으면 0
+ */
+uint64_t latency_hist_percentile(const LatencyHistogram* hist, double percentile);
+
+#endif /* LATENCY_HISTOGRAM_H */
@@ -0,0 +1,47 @@
+// common/include/line_reader.h
+#ifndef LINE_READER_H
+#define LINE_READER_H
+
+#include <stddef.h>
+#include <sys/types.h>
+
+/* 기본 블록 크기: read() 한 번에 가져오는 바이트 수 */
+#define LINE_READER_DEFAULT_BLOCK 65536
+
+/*
+ * 블록 단위 버퍼드 줄 읽기
+ * - read() 를 바이트마다 호출하지 않고 블록 단위로 읽은 뒤
+ *   버퍼 안에서 memchr 로 개행을 찾는다
+ * - 반환되는 줄은 버퍼 내부를 가리키며 다음 호출 전까지만 유효
+ */
+typedef struct {
+  int fd;
+  char* buf;
+  size_t cap;   /* 버퍼 크기 (줄 최대 길이 = cap - 1) */
+  size_t start; /* 아직 반환하지 않은 데이터 시작 위치 */
+  size_t end;   /* 버퍼에 채워진 데이터 끝 위치 */
+  int eof;
+} LineReader;
+
+/*
+ * 리더 초기화 (fd 소유권은 가져가지 않음)
+ * block_size: 0 이면 LINE_READER_DEFAULT_BLOCK
+ * 반환값: 성공 시 0, 메모리 부족 시 -1
+ */
+int line_reader_init(LineReader* reader, int fd, size_t block_size);
+
+/*
+ * 다음 줄 읽기
+ * line: 개행('\n', 뒤따르는 '\r' 포함)을 제거하고 '\0' 으로 끝나는 줄 포인터
+ * len: 줄 길이
+ * cap - 1 보다 긴 줄은 잘라서 여러 번에 나누어 반환
+ * 반환값: 줄을 읽었으면 1, EOF 면 0, 읽기 에러면 -1
+ */
+int line_reader_next(LineReader* reader, char** line, size_t* len);
+
+/*
+ * 리더 버퍼 해제 (fd 는 닫지 않음)
+ */
+void line_reader_free(LineReader* reader);
+
+#endif /* LINE_READER_H */
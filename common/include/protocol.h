@@ -31,15 +31,70 @@ typedef enum {
 
   /* 단어 리스트 송수신 */
   MSG_TYPE_WORDLIST_REQ = 0x20,
-  MSG_TYPE_WORDLIST_RESP = 0x21
+  MSG_TYPE_WORDLIST_RESP = 0x21,
+
+  /* 압축 단어 리스트 (가변 길이, 아래 WORDLIST_PACKED_* 참고) */
+  MSG_TYPE_WORDLIST_PACKED_REQ = 0x22,
+  MSG_TYPE_WORDLIST_PACKED_RESP = 0x23,
+
+  /* 조건부 단어 리스트 (클라이언트 캐시용, 아래 WORDLIST_COND_* 참고) */
+  MSG_TYPE_WORDLIST_COND_REQ = 0x24,
+  MSG_TYPE_WORDLIST_COND_RESP = 0x25,
+
+  /* 난이도 구간 단어 표본 (아래 WORD_SAMPLE_* 참고) */
+  MSG_TYPE_WORD_SAMPLE_REQ = 0x26,
+  MSG_TYPE_WORD_SAMPLE_RESP = 0x27,
+
+  /* 게임 중 단어 스트리밍 (아래 WORD_STREAM_* 참고) */
+  MSG_TYPE_WORD_STREAM_REQ = 0x28,
+  MSG_TYPE_WORD_STREAM_RESP = 0x29,
+
+  /* 서버 지표 조회 (관리용, 아래 METRICS_* 참고) */
+  MSG_TYPE_METRICS_REQ = 0x2A,
+  MSG_TYPE_METRICS_RESP = 0x2B
 } MessageType;
 
-/* 모든 패킷 공통 헤더 */
+/*
+ * 레거시 패킷 헤더 (버전 0)
+ * enum 폭과 호스트 바이트 순서를 그대로 보내므로 같은 ABI 끼리만 통신 가능
+ * 핸드셰이크 없이 접속한 구 클라이언트와의 호환용으로만 사용
+ */
 typedef struct {
   MessageType type;
   uint16_t length; /* 헤더 뒤 바디 길이 (byte) */
 } __attribute__((packed)) MessageHeader;
 
+/*
+ * 버전 협상 (wire_codec.h 가 인코딩/디코딩)
+ * 접속 직후 클라이언트가 hello 8 바이트를 보냄:
+ *   "RAIN"  u16 2  u16 version
+ * 서버는 min(클라이언트 버전, 서버 버전) 을 같은 형식으로 돌려주고 이후 그 버전으로 통신
+ * - 레거시 서버는 hello 를 "알 수 없는 타입 + 2 바이트 바디" 로 읽고 MSG_TYPE_ERROR 로 답하므로
+ *   클라이언트는 첫 4 바이트가 "RAIN" 이 아니면 버전 0 으로 돌아간다
+ * - 서버는 첫 4 바이트가 "RAIN" 이 아니면 레거시 클라이언트로 보고 MessageHeader 로 읽는다
+ *
+ * 버전 1 프레임 헤더 (8 바이트, 모든 정수 little-endian):
+ *   u16 type  u16 flags  u32 length
+ * 버전 2 프레임 헤더 (12 바이트):
+ *   u16 type  u16 flags  u32 request_id  u32 length
+ * - flags 는 예약 (보낼 때 0, 받을 때 모르는 비트는 무시)
+ * - request_id 는 클라이언트가 정하고 서버는 응답에 그대로 돌려줌
+ *   버전 2 에서는 한 연결에 여러 요청을 응답을 기다리지 않고 보낼 수 있고 (파이프라이닝),
+ *   세션을 바꾸지 않는 요청은 서버가 동시에 처리하므로 응답 순서가 요청 순서와 다를 수 있다
+ *   로그인 / 로그아웃 / 점수 제출은 앞뒤 요청이 모두 끝난 뒤 단독으로 처리
+ *   버전 0 / 1 은 요청 순서대로 하나씩 처리하므로 응답도 같은 순서
+ * - 바디는 구조체 그대로가 아니라 필드 단위로 직렬화 (wire_encode_body / wire_decode_body)
+ *     정수: 고정 폭 little-endian, 문자열: [u8 len][len 바이트] (NUL 없음)
+ * - 모르는 타입의 프레임도 length 로 건너뛸 수 있으므로 새 메시지 타입을 추가해도
+ *   기존 상대는 MSG_TYPE_ERROR 로 답하고 연결을 유지한다
+ */
+#define RAIN_WIRE_MAGIC "RAIN"
+#define RAIN_PROTOCOL_VERSION 2
+#define WIRE_VERSION_LEGACY 0
+#define WIRE_HELLO_SIZE 8
+#define WIRE_FRAME_HEADER_SIZE_V1 8
+#define WIRE_FRAME_HEADER_SIZE 12
+
 /* 기본 구조체들 */
 typedef struct {
   char username[MAX_ID_LEN];
@@ -89,4 +144,72 @@ typedef struct {
   char words[MAX_WORDLIST_WORDS][MAX_WORD_STR_LEN]; /* 단어 배열 */
 } WordListResponse;
 
+/*
+ * 압축 단어 리스트 (MSG_TYPE_WORDLIST_PACKED_*)
+ * 정수는 모두 little-endian, 패딩 없이 바이트 단위로 인코딩 (wire_codec.h)
+ *   요청: u32 start                           받고 싶은 첫 단어 번호
+ *   응답: u32 total, u32 start, u16 count     뒤에 count 개의 [u8 len][len 바이트] (NUL 없음)
+ * 응답 바디는 WORDLIST_PACKED_MAX_BODY 이하이므로, start + count < total 이면
+ * 클라이언트는 start + count 부터 다시 요청한다 (단어 수 제한 없음)
+ * 이 타입을 모르는 서버는 MSG_TYPE_ERROR 로 응답하므로 클라이언트는 WORDLIST_REQ 로 돌아간다
+ */
+#define WORDLIST_PACKED_REQ_SIZE 4
+#define WORDLIST_PACKED_HEADER_SIZE 10
+#define WORDLIST_PACKED_MAX_BODY 60000
+
+/*
+ * 조건부 단어 리스트 (MSG_TYPE_WORDLIST_COND_*), if-none-match 방식
+ *   요청: u32 start, u64 etag                 etag: 클라이언트가 가진 목록의 etag (없으면 0)
+ *   응답: u8 status, u64 etag                 etag: 서버 목록의 etag
+ *         status == WORDLIST_COND_NOT_MODIFIED 이면 여기서 끝 (start == 0 이고 etag 가 같을 때)
+ *         status == WORDLIST_COND_MODIFIED 이면 뒤에 압축 단어 리스트 응답과 같은 바디
+ * etag 는 목록 내용([u8 len][bytes] 를 이어 붙인 바이트)의 해시 (wire_wordlist_etag, 0 은 쓰지 않음)
+ * 나눠 받는 도중 etag 가 바뀌면 서버 목록이 교체된 것이므로 처음부터 다시 받는다
+ * 이 타입을 모르는 서버는 MSG_TYPE_ERROR 로 응답하므로 클라이언트는 WORDLIST_PACKED_REQ 로 돌아간다
+ */
+#define WORDLIST_COND_REQ_SIZE 12
+#define WORDLIST_COND_HEADER_SIZE 9
+#define WORDLIST_COND_MODIFIED 0
+#define WORDLIST_COND_NOT_MODIFIED 1
+
+/*
+ * 난이도 구간 단어 표본 (MSG_TYPE_WORD_SAMPLE_*), 세션에 필요한 만큼만 받기
+ *   요청: u8 band, u8 min_len, u8 max_len, u16 count
+ *         band: WORD_BAND_* (WORD_BAND_ANY 면 구간 무관), 길이 0 은 제한 없음
+ *   응답: u8 band, u32 available, u16 count   뒤에 count 개의 [u8 len][len 바이트]
+ *         available: 조건에 맞는 전체 단어 수, count ≤ min(요청 count, WORD_SAMPLE_MAX)
+ * 조건에 맞는 단어 중 중복 없이 무작위로 뽑음 (요청마다 다른 표본)
+ * 단어의 난이도는 0~255 점수이고 64 점 단위로 구간을 나눔 (data/words.txt 에서 "단어<TAB>점수" 로 지정 가능)
+ */
+#define WORD_BAND_EASY 0
+#define WORD_BAND_NORMAL 1
+#define WORD_BAND_HARD 2
+#define WORD_BAND_EXPERT 3
+#define WORD_BAND_COUNT 4
+#define WORD_BAND_ANY 0xFF
+#define WORD_SAMPLE_REQ_SIZE 5
+#define WORD_SAMPLE_HEADER_SIZE 7
+#define WORD_SAMPLE_MAX 1024
+
+/*
+ * 게임 중 단어 스트리밍 (MSG_TYPE_WORD_STREAM_*), 전체 목록 없이 필요한 만큼씩 미리 받기
+ *   요청: u8 flags, u8 band, u16 count
+ *         count: 클라이언트 버퍼의 빈 칸 수 (이만큼 더 받겠다는 크레딧), WORD_SAMPLE_MAX 이하로 잘림
+ *         flags & WORD_STREAM_RESTART: band 로 새 스트림 시작 (아니면 이전 스트림을 이어서, 연결의 첫 요청은 항상 새로 시작)
+ *   응답: 난이도 표본 응답과 같은 형식 (u8 band, u32 available, u16 count, 단어들)
+ * 서버는 연결마다 구간 안의 단어를 무작위 순열 순서로 이어서 내보내므로 구간을 한 바퀴 돌기 전에는 같은 단어가 다시 오지 않음
+ * 서버 목록이 리로드되면 같은 구간의 새 목록으로 스트림을 다시 시작
+ */
+#define WORD_STREAM_RESTART 0x01
+#define WORD_STREAM_REQ_SIZE 4
+
+/*
+ * 서버 지표 (MSG_TYPE_METRICS_*), 관리용
+ *   요청: 바디 없음
+ *   응답: Prometheus 텍스트 형식 지표 (NUL 없음, 서버의 Unix 소켓 덤프와 같은 내용)
+ * 루프백(127.0.0.0/8) 에서 접속한 연결만 허용하고 그 외에는 MSG_TYPE_ERROR 로 응답
+ * 지표가 METRICS_MAX_BODY 바이트를 넘으면 MSG_TYPE_ERROR (버전 0 헤더의 16 비트 길이 한도)
+ */
+#define METRICS_MAX_BODY 65535
+
 #endif /* PROTOCOL_H */
\ No newline at end of file
@@ -0,0 +1,92 @@
+// common/include/wire_codec.h
+#ifndef WIRE_CODEC_H
+#define WIRE_CODEC_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "protocol.h"
+
+/*
+ * 고정 폭 little-endian 정수 인코딩
+ * 구조체를 그대로 보내지 않는 메시지(가변 길이 바디 등)는 이 함수들로 바이트 단위로 읽고 쓴다
+ * 정렬되지 않은 주소에서도 안전하고 호스트 엔디언과 무관
+ */
+
+static inline void wire_put_u8(uint8_t* p, uint8_t v) { p[0] = v; }
+
+static inline void wire_put_u16(uint8_t* p, uint16_t v) {
+  p[0] = (uint8_t)v;
+  p[1] = (uint8_t)(v >> 8);
+}
+
+static inline void wire_put_u32(uint8_t* p, uint32_t v) {
+  p[0] = (uint8_t)v;
+  p[1] = (uint8_t)(v >> 8);
+  p[2] = (uint8_t)(v >> 16);
+  p[3] = (uint8_t)(v >> 24);
+}
+
+static inline void wire_put_u64(uint8_t* p, uint64_t v) {
+  wire_put_u32(p, (uint32_t)v);
+  wire_put_u32(p + 4, (uint32_t)(v >> 32));
+}
+
+static inline uint8_t wire_get_u8(const uint8_t* p) { return p[0]; }
+
+static inline uint16_t wire_get_u16(const uint8_t* p) { return (uint16_t)(p[0] | (p[1] << 8)); }
+
+static inline uint32_t wire_get_u32(const uint8_t* p) {
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static inline uint64_t wire_get_u64(const uint8_t* p) { return (uint64_t)wire_get_u32(p) | ((uint64_t)wire_get_u32(p + 4) << 32); }
+
+/* ---------- 프레임 / 메시지 직렬화 (protocol.h 의 버전 협상 참고) ---------- */
+
+/* 어떤 버전이든 프레임 헤더가 들어가는 크기 */
+#define WIRE_MAX_FRAME_HEADER_SIZE WIRE_FRAME_HEADER_SIZE
+
+/* 버전과 무관하게 디코딩된 프레임 헤더 */
+typedef struct {
+  uint32_t type;
+  uint16_t flags;
+  uint32_t request_id; /* 버전 2 미만은 항상 0 */
+  uint32_t length;     /* 헤더 뒤 바디 길이 (byte) */
+} WireFrameHeader;
+
+void wire_encode_hello(uint8_t* out, uint16_t version);
+
+/* "RAIN" 으로 시작하는 hello 면 0 과 함께 *version 설정, 아니면 -1 */
+int wire_decode_hello(const uint8_t* in, uint16_t* version);
+
+/* 버전별 프레임 헤더 크기 (버전 0 은 sizeof(MessageHeader)) */
+size_t wire_frame_header_size(int version);
+
+/* request_id 는 버전 2 이상에서만 기록 */
+void wire_encode_frame_header(int version, uint8_t* out, uint32_t type, uint32_t request_id, uint32_t length);
+
+void wire_decode_frame_header(int version, const uint8_t* in, WireFrameHeader* header);
+
+/*
+ * 메시지 구조체 → 버전 1 바디
+ * protocol.h 에 구조체가 정해진 타입은 필드 단위로, 그 외 (압축 단어 리스트, 바디 없는 요청,
+ * 모르는 타입) 는 msg_len 바이트를 그대로 복사
+ * 반환값: 기록한 바디 길이, msg_len 이 구조체보다 작거나 cap 이 부족하면 -1
+ */
+long wire_encode_body(uint32_t type, const void* msg, size_t msg_len, uint8_t* out, size_t cap);
+
+/*
+ * 버전 1 바디 → 메시지 구조체 (msg 는 msg_cap 바이트)
+ * 뒤에 남는 바이트는 무시하므로 이후 버전에서 필드를 뒤에 추가해도 기존 상대가 읽을 수 있음
+ * 반환값: msg 에 채운 바이트 수, 형식 오류나 공간 부족이면 -1
+ */
+long wire_decode_body(uint32_t type, const uint8_t* in, size_t in_len, void* msg, size_t msg_cap);
+
+/*
+ * 단어 목록의 etag ([u8 len][bytes] 를 이어 붙인 packed 바이트의 FNV-1a 64, 0 은 1 로 바꿈)
+ * 서버와 클라이언트 캐시가 같은 정의를 사용
+ */
+uint64_t wire_wordlist_etag(const uint8_t* packed, size_t len);
+
+#endif /* WIRE_CODEC_H */
@@ -71,4 +71,22 @@ int hash_password_sha256(const char* password, char* hash_output) {
 
   bytes_to_hex(hash, SHA256_DIGEST_LENGTH, hash_output);
   return 1;
-}
\ No newline at end of file
+}
+uint64_t hash_string_fnv1a(const char* str) {
+  uint64_t hash = 1469598103934665603ULL;
+  while (*str) {
+    hash ^= (unsigned char)*str++;
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+uint64_t hash_bytes_fnv1a(const void* data, size_t len) {
+  const unsigned char* p = data;
+  uint64_t hash = 1469598103934665603ULL;
+  for (size_t i = 0; i < len; i++) {
+    hash ^= p[i];
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
@@ -0,0 +1,87 @@
+// common/src/latency_histogram.c
+#include "latency_histogram.h"
+
+#include <string.h>
+
+/* 값 → 칸 번호: 16 미만은 그대로, 그 이상은 (최상위 비트 위치, 다음 4비트) 로 나눔 */
+static int bucket_index(uint64_t value) {
+  if (value < LATENCY_HIST_SUB_BUCKETS) {
+    return (int)value;
+  }
+  int msb = 63 - __builtin_clzll(value);
+  int shift = msb - 4;
+  int index = (msb - 3) * LATENCY_HIST_SUB_BUCKETS + (int)((value >> shift) & (LATENCY_HIST_SUB_BUCKETS - 1));
+  return index < LATENCY_HIST_BUCKETS ? index : LATENCY_HIST_BUCKETS - 1;
+}
+
+/* 칸 번호 → 그 칸에 들어가는 가장 큰 값 */
+static uint64_t bucket_upper_bound(int index) {
+  if (index < LATENCY_HIST_SUB_BUCKETS) {
+    return (uint64_t)index;
+  }
+  int msb = index / LATENCY_HIST_SUB_BUCKETS + 3;
+  int shift = msb - 4;
+  uint64_t sub = (uint64_t)(index % LATENCY_HIST_SUB_BUCKETS);
+  return ((LATENCY_HIST_SUB_BUCKETS + sub + 1) << shift) - 1;
+}
+
+void latency_hist_init(LatencyHistogram* hist) { memset(hist, 0, sizeof(*hist)); }
+
+void latency_hist_record(LatencyHistogram* hist, uint64_t value) {
+  hist->counts[bucket_index(value)]++;
+  hist->total++;
+  hist->sum += value;
+  if (value > hist->max) hist->max = value;
+}
+
+void latency_hist_merge(LatencyHistogram* dst, const LatencyHistogram* src) {
+  for (int i = 0; i < LATENCY_HIST_BUCKETS; i++) {
+    dst->counts[i] += src->counts[i];
+  }
+  dst->total += src->total;
+  dst->sum += src->sum;
+  if (src->max > dst->max) dst->max = src->max;
+}
+
+/* 기록하는 스레드가 하나뿐이므로 읽고 더해 쓰는 것으로 충분 (원자적 증가 불필요) */
+static inline void shared_add(uint64_t* field, uint64_t value) {
+  __atomic_store_n(field, __atomic_load_n(field, __ATOMIC_RELAXED) + value, __ATOMIC_RELAXED);
+}
+
+void latency_hist_record_shared(LatencyHistogram* hist, uint64_t value) {
+  shared_add(&hist->counts[bucket_index(value)], 1);
+  shared_add(&hist->total, 1);
+  shared_add(&hist->sum, value);
+  if (value > __atomic_load_n(&hist->max, __ATOMIC_RELAXED)) {
+    __atomic_store_n(&hist->max, value, __ATOMIC_RELAXED);
+  }
+}
+
+void latency_hist_merge_shared(LatencyHistogram* dst, const LatencyHistogram* src) {
+  for (int i = 0; i < LATENCY_HIST_BUCKETS; i++) {
+    dst->counts[i] += __atomic_load_n(&src->counts[i], __ATOMIC_RELAXED);
+  }
+  dst->total += __atomic_load_n(&src->total, __ATOMIC_RELAXED);
+  dst->sum += __atomic_load_n(&src->sum, __ATOMIC_RELAXED);
+  uint64_t max = __atomic_load_n(&src->max, __ATOMIC_RELAXED);
+  if (max > dst->max) dst->max = max;
+}
+
+uint64_t latency_hist_percentile(const LatencyHistogram* hist, double percentile) {
+  if (hist->total == 0) {
+    return 0;
+  }
+
+  uint64_t rank = (uint64_t)(hist->total * (percentile / 100.0));
+  if (rank >= hist->total) rank = hist->total - 1;
+
+  uint64_t seen = 0;
+  for (int i = 0; i < LATENCY_HIST_BUCKETS; i++) {
+    seen += hist->counts[i];
+    if (seen > rank) {
+      uint64_t bound = bucket_upper_bound(i);
+      return bound < hist->max ? bound : hist->max;
+    }
+  }
+  return hist->max;
+}
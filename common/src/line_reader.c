@@ -0,0 +1,90 @@
+// common/src/line_reader.c
+#include "line_reader.h"
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+int line_reader_init(LineReader* reader, int fd, size_t block_size) {
+  if (block_size == 0) {
+    block_size = LINE_READER_DEFAULT_BLOCK;
+  }
+
+  reader->buf = malloc(block_size);
+  if (!reader->buf) {
+    return -1;
+  }
+  reader->fd = fd;
+  reader->cap = block_size;
+  reader->start = 0;
+  reader->end = 0;
+  reader->eof = 0;
+  return 0;
+}
+
+/* 남은 데이터를 버퍼 앞으로 옮기고 빈 공간을 read() 한 번으로 채움 */
+static int fill_buffer(LineReader* reader) {
+  if (reader->start > 0) {
+    memmove(reader->buf, reader->buf + reader->start, reader->end - reader->start);
+    reader->end -= reader->start;
+    reader->start = 0;
+  }
+
+  /* 마지막 1바이트는 '\0' 종료용으로 남겨 둠 */
+  while (1) {
+    ssize_t bytes_read = read(reader->fd, reader->buf + reader->end, reader->cap - 1 - reader->end);
+    if (bytes_read < 0) {
+      if (errno == EINTR) continue;  // 시그널에 의한 중단은 재시도
+      return -1;
+    }
+    if (bytes_read == 0) {
+      reader->eof = 1;
+    }
+    reader->end += bytes_read;
+    return 0;
+  }
+}
+
+int line_reader_next(LineReader* reader, char** line, size_t* len) {
+  while (1) {
+    char* begin = reader->buf + reader->start;
+    size_t available = reader->end - reader->start;
+    char* newline = available > 0 ? memchr(begin, '\n', available) : NULL;
+
+    size_t line_len;
+    size_t consumed;
+    if (newline != NULL) {
+      line_len = newline - begin;
+      consumed = line_len + 1;
+    } else if (reader->eof || available >= reader->cap - 1) {
+      /* 파일 끝의 개행 없는 줄, 또는 버퍼보다 긴 줄 */
+      if (available == 0) {
+        return 0;  // EOF
+      }
+      line_len = available;
+      consumed = available;
+    } else {
+      if (fill_buffer(reader) != 0) {
+        return -1;
+      }
+      continue;
+    }
+
+    if (line_len > 0 && begin[line_len - 1] == '\r') {
+      line_len--;
+    }
+    begin[line_len] = '\0';
+    reader->start += consumed;
+
+    *line = begin;
+    *len = line_len;
+    return 1;
+  }
+}
+
+void line_reader_free(LineReader* reader) {
+  free(reader->buf);
+  reader->buf = NULL;
+  reader->cap = reader->start = reader->end = 0;
+}
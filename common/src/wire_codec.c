@@ -0,0 +1,318 @@
+// common/src/wire_codec.c
+#include "wire_codec.h"
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "hash_util.h"
+
+/* 두 응답 구조체는 같은 레이아웃으로 인코딩 */
+_Static_assert(sizeof(LogoutResponse) == sizeof(RegisterResponse), "LogoutResponse layout must match RegisterResponse");
+
+/* 범위를 확인하며 쓰는 커서 (넘치면 ok = false 이후 쓰기 무시) */
+typedef struct {
+  uint8_t* p;
+  size_t left;
+  bool ok;
+} WireWriter;
+
+typedef struct {
+  const uint8_t* p;
+  size_t left;
+  bool ok;
+} WireReader;
+
+static uint8_t* writer_take(WireWriter* w, size_t n) {
+  if (!w->ok || w->left < n) {
+    w->ok = false;
+    return NULL;
+  }
+  uint8_t* at = w->p;
+  w->p += n;
+  w->left -= n;
+  return at;
+}
+
+static void put_u8(WireWriter* w, uint8_t v) {
+  uint8_t* at = writer_take(w, 1);
+  if (at) wire_put_u8(at, v);
+}
+
+static void put_u16(WireWriter* w, uint16_t v) {
+  uint8_t* at = writer_take(w, 2);
+  if (at) wire_put_u16(at, v);
+}
+
+static void put_u32(WireWriter* w, uint32_t v) {
+  uint8_t* at = writer_take(w, 4);
+  if (at) wire_put_u32(at, v);
+}
+
+// 고정 크기 char 배열 필드 → [u8 len][bytes]
+static void put_str(WireWriter* w, const char* s, size_t field_size) {
+  size_t len = strnlen(s, field_size - 1);
+  put_u8(w, (uint8_t)len);
+  uint8_t* at = writer_take(w, len);
+  if (at) memcpy(at, s, len);
+}
+
+static const uint8_t* reader_take(WireReader* r, size_t n) {
+  if (!r->ok || r->left < n) {
+    r->ok = false;
+    return NULL;
+  }
+  const uint8_t* at = r->p;
+  r->p += n;
+  r->left -= n;
+  return at;
+}
+
+static uint8_t get_u8(WireReader* r) {
+  const uint8_t* at = reader_take(r, 1);
+  return at ? wire_get_u8(at) : 0;
+}
+
+static uint16_t get_u16(WireReader* r) {
+  const uint8_t* at = reader_take(r, 2);
+  return at ? wire_get_u16(at) : 0;
+}
+
+static uint32_t get_u32(WireReader* r) {
+  const uint8_t* at = reader_take(r, 4);
+  return at ? wire_get_u32(at) : 0;
+}
+
+// [u8 len][bytes] → NUL 로 끝나는 고정 크기 필드 (필드에 안 들어가면 형식 오류)
+static void get_str(WireReader* r, char* dst, size_t field_size) {
+  uint8_t len = get_u8(r);
+  if (len >= field_size) {
+    r->ok = false;
+  }
+  const uint8_t* at = reader_take(r, len);
+  if (!at) {
+    dst[0] = '\0';
+    return;
+  }
+  memcpy(dst, at, len);
+  dst[len] = '\0';
+}
+
+void wire_encode_hello(uint8_t* out, uint16_t version) {
+  memcpy(out, RAIN_WIRE_MAGIC, 4);
+  wire_put_u16(out + 4, 2);
+  wire_put_u16(out + 6, version);
+}
+
+int wire_decode_hello(const uint8_t* in, uint16_t* version) {
+  if (memcmp(in, RAIN_WIRE_MAGIC, 4) != 0) {
+    return -1;
+  }
+  *version = wire_get_u16(in + 6);
+  return 0;
+}
+
+size_t wire_frame_header_size(int version) {
+  if (version == WIRE_VERSION_LEGACY) return sizeof(MessageHeader);
+  return version == 1 ? WIRE_FRAME_HEADER_SIZE_V1 : WIRE_FRAME_HEADER_SIZE;
+}
+
+void wire_encode_frame_header(int version, uint8_t* out, uint32_t type, uint32_t request_id, uint32_t length) {
+  if (version == WIRE_VERSION_LEGACY) {
+    MessageHeader header;
+    header.type = (MessageType)type;
+    header.length = (uint16_t)length;
+    memcpy(out, &header, sizeof(MessageHeader));
+    return;
+  }
+  wire_put_u16(out, (uint16_t)type);
+  wire_put_u16(out + 2, 0);
+  if (version == 1) {
+    wire_put_u32(out + 4, length);
+    return;
+  }
+  wire_put_u32(out + 4, request_id);
+  wire_put_u32(out + 8, length);
+}
+
+void wire_decode_frame_header(int version, const uint8_t* in, WireFrameHeader* header) {
+  if (version == WIRE_VERSION_LEGACY) {
+    MessageHeader legacy;
+    memcpy(&legacy, in, sizeof(MessageHeader));
+    header->type = (uint32_t)legacy.type;
+    header->flags = 0;
+    header->request_id = 0;
+    header->length = legacy.length;
+    return;
+  }
+  header->type = wire_get_u16(in);
+  header->flags = wire_get_u16(in + 2);
+  if (version == 1) {
+    header->request_id = 0;
+    header->length = wire_get_u32(in + 4);
+    return;
+  }
+  header->request_id = wire_get_u32(in + 4);
+  header->length = wire_get_u32(in + 8);
+}
+
+long wire_encode_body(uint32_t type, const void* msg, size_t msg_len, uint8_t* out, size_t cap) {
+  WireWriter w = {out, cap, true};
+
+  switch (type) {
+    case MSG_TYPE_REGISTER_REQ:
+    case MSG_TYPE_LOGIN_REQ: {
+      if (msg_len < sizeof(RegisterRequest)) return -1;
+      const RegisterRequest* req = msg;
+      put_str(&w, req->username, MAX_ID_LEN);
+      put_str(&w, req->password, MAX_PW_LEN);
+      break;
+    }
+
+    case MSG_TYPE_REGISTER_RESP:
+    case MSG_TYPE_LOGIN_RESP:
+    case MSG_TYPE_SCORE_SUBMIT_RESP:
+    case MSG_TYPE_LOGOUT_RESP: {
+      if (msg_len < sizeof(RegisterResponse)) return -1;
+      const RegisterResponse* resp = msg;
+      put_u8(&w, resp->success ? 1 : 0);
+      put_str(&w, resp->message, MAX_MSG_LEN);
+      break;
+    }
+
+    case MSG_TYPE_SCORE_SUBMIT_REQ: {
+      if (msg_len < sizeof(ScoreSubmitRequest)) return -1;
+      const ScoreSubmitRequest* req = msg;
+      put_u32(&w, (uint32_t)req->score);
+      break;
+    }
+
+    case MSG_TYPE_LEADERBOARD_RESP: {
+      if (msg_len < sizeof(LeaderboardResponse)) return -1;
+      const LeaderboardResponse* resp = msg;
+      int count = resp->count < 0 ? 0 : resp->count > MAX_LEADERBOARD_ENTRIES ? MAX_LEADERBOARD_ENTRIES : resp->count;
+      put_u8(&w, (uint8_t)count);
+      for (int i = 0; i < count; i++) {
+        put_str(&w, resp->entries[i].username, MAX_ID_LEN);
+        put_u32(&w, (uint32_t)resp->entries[i].score);
+      }
+      put_str(&w, resp->message, MAX_MSG_LEN);
+      break;
+    }
+
+    case MSG_TYPE_WORDLIST_RESP: {
+      if (msg_len < sizeof(WordListResponse)) return -1;
+      const WordListResponse* resp = msg;
+      int count = resp->count < 0 ? 0 : resp->count > MAX_WORDLIST_WORDS ? MAX_WORDLIST_WORDS : resp->count;
+      put_u16(&w, (uint16_t)count);
+      for (int i = 0; i < count; i++) {
+        put_str(&w, resp->words[i], MAX_WORD_STR_LEN);
+      }
+      break;
+    }
+
+    case MSG_TYPE_ERROR: {
+      if (msg_len < sizeof(ErrorResponse)) return -1;
+      const ErrorResponse* resp = msg;
+      put_str(&w, resp->message, MAX_MSG_LEN);
+      break;
+    }
+
+    default: {
+      // 이미 바이트 단위로 정의된 바디 (또는 바디 없음)
+      uint8_t* at = writer_take(&w, msg_len);
+      if (at && msg_len > 0) memcpy(at, msg, msg_len);
+      break;
+    }
+  }
+
+  return w.ok ? (long)(cap - w.left) : -1;
+}
+
+long wire_decode_body(uint32_t type, const uint8_t* in, size_t in_len, void* msg, size_t msg_cap) {
+  WireReader r = {in, in_len, true};
+  size_t msg_size;
+
+  switch (type) {
+    case MSG_TYPE_REGISTER_REQ:
+    case MSG_TYPE_LOGIN_REQ: {
+      if (msg_cap < sizeof(RegisterRequest)) return -1;
+      RegisterRequest* req = msg;
+      memset(req, 0, sizeof(*req));
+      get_str(&r, req->username, MAX_ID_LEN);
+      get_str(&r, req->password, MAX_PW_LEN);
+      msg_size = sizeof(*req);
+      break;
+    }
+
+    case MSG_TYPE_REGISTER_RESP:
+    case MSG_TYPE_LOGIN_RESP:
+    case MSG_TYPE_SCORE_SUBMIT_RESP:
+    case MSG_TYPE_LOGOUT_RESP: {
+      if (msg_cap < sizeof(RegisterResponse)) return -1;
+      RegisterResponse* resp = msg;
+      memset(resp, 0, sizeof(*resp));
+      resp->success = get_u8(&r);
+      get_str(&r, resp->message, MAX_MSG_LEN);
+      msg_size = sizeof(*resp);
+      break;
+    }
+
+    case MSG_TYPE_SCORE_SUBMIT_REQ: {
+      if (msg_cap < sizeof(ScoreSubmitRequest)) return -1;
+      ScoreSubmitRequest* req = msg;
+      req->score = (int32_t)get_u32(&r);
+      msg_size = sizeof(*req);
+      break;
+    }
+
+    case MSG_TYPE_LEADERBOARD_RESP: {
+      if (msg_cap < sizeof(LeaderboardResponse)) return -1;
+      LeaderboardResponse* resp = msg;
+      memset(resp, 0, sizeof(*resp));
+      resp->count = get_u8(&r);
+      if (resp->count > MAX_LEADERBOARD_ENTRIES) return -1;
+      for (int i = 0; i < resp->count; i++) {
+        get_str(&r, resp->entries[i].username, MAX_ID_LEN);
+        resp->entries[i].score = (int32_t)get_u32(&r);
+      }
+      get_str(&r, resp->message, MAX_MSG_LEN);
+      msg_size = sizeof(*resp);
+      break;
+    }
+
+    case MSG_TYPE_WORDLIST_RESP: {
+      if (msg_cap < sizeof(WordListResponse)) return -1;
+      WordListResponse* resp = msg;
+      resp->count = get_u16(&r);
+      if (resp->count > MAX_WORDLIST_WORDS) return -1;
+      for (int i = 0; i < resp->count; i++) {
+        get_str(&r, resp->words[i], MAX_WORD_STR_LEN);
+      }
+      msg_size = sizeof(*resp);
+      break;
+    }
+
+    case MSG_TYPE_ERROR: {
+      if (msg_cap < sizeof(ErrorResponse)) return -1;
+      ErrorResponse* resp = msg;
+      memset(resp, 0, sizeof(*resp));
+      get_str(&r, resp->message, MAX_MSG_LEN);
+      msg_size = sizeof(*resp);
+      break;
+    }
+
+    default: {
+      if (in_len > msg_cap) return -1;
+      if (in_len > 0) memcpy(msg, in, in_len);
+      msg_size = in_len;
+      break;
+    }
+  }
+
+  return r.ok ? (long)msg_size : -1;
+}
+
+uint64_t wire_wordlist_etag(const uint8_t* packed, size_t len) {
+  uint64_t etag = hash_bytes_fnv1a(packed, len);
+  return etag ? etag : 1;
+}
@@ -2,10 +2,9 @@
 #ifndef DB_HANDLER_H
 #define DB_HANDLER_H
 
-#include "protocol.h"
+#include <stdint.h>
 
-#define MAX_USERS 100
-#define MAX_TOTAL_SCORES 500
+#include "protocol.h"
 
 typedef struct {
   char username[MAX_ID_LEN];
@@ -17,10 +16,57 @@ typedef struct {
   int score;
 } ScoreRecord;
 
-void init_db_files();
-int find_user_in_file(const char* username, UserData* found_user);
-int add_user_to_file(const UserData* user);
-int add_score_to_file(const char* username, int score);
-int load_all_scores_from_file(ScoreRecord scores[], int max_records);
+/* 배치 기록 후 디스크 동기화 방식 */
+typedef enum {
+  DB_SYNC_NONE = 0,  /* write() 만 수행 (OS 페이지 캐시에 맡김) */
+  DB_SYNC_FDATASYNC, /* fdatasync() */
+  DB_SYNC_FSYNC      /* fsync() (기본값) */
+} DbSyncMode;
+
+/* 점수 기록 하나를 전달받는 콜백 */
+typedef void (*ScoreVisitor)(const char* username, int score, void* ctx);
+
+/*
+ * 데이터 디렉터리를 만들고 저장소 백엔드를 열어 인덱스 적재 (실패하면 서버 종료)
+ * engine_name: "text"(users.txt / scores.txt) 또는 "log"(users.log / scores.log), NULL 이면 "text"
+ * max_batch: db_append_scores 한 번에 넘기는 최대 점수 수 (점수 WAL 배치 크기)
+ * 백엔드마다 파일이 따로이므로 백엔드를 바꾸면 그 백엔드의 파일로 시작함
+ */
+void init_db(const char* engine_name, int max_batch);
+
+/* 백엔드 닫기 (서버 종료 시, 저장소를 쓰는 다른 스레드가 모두 끝난 뒤) */
+void close_db(void);
+
+/* 사용 중인 백엔드 이름 */
+const char* db_engine_name(void);
+
+/* 반환값: 찾으면 1, 없으면 0, 에러 시 -1 */
+int db_find_user(const char* username, UserData* found_user);
+
+/* 반환값: 추가되면 1, 이미 있거나 실패 시 0 */
+int db_add_user(const UserData* user);
+
+/*
+ * 여러 점수를 한 번의 쓰기와 한 번의 동기화로 점수 로그에 추가
+ * 반환값: 성공 시 1, 실패 시 0
+ */
+int db_append_scores(const ScoreRecord records[], int count, DbSyncMode sync_mode);
+
+/*
+ * 점수 로그의 start_offset 위치부터 끝까지의 기록을 순서대로 visitor 에 전달 (0 이면 처음부터)
+ * end_offset: NULL 이 아니면 읽은 구간의 끝 위치 (다음 꼬리 재생의 시작 위치)
+ * 반환값: 전달한 기록 수, 실패하거나 로그가 start_offset 보다 짧으면 -1
+ */
+int db_for_each_score(uint64_t start_offset, ScoreVisitor visitor, void* ctx, uint64_t* end_offset);
+
+/* 점수 로그의 현재 끝 위치, 반환값: 성공 시 0, 실패 시 -1 */
+int db_score_log_size(uint64_t* size);
+
+/*
+ * 점수 로그의 offset 직전 구간(최대 64바이트) 지문
+ * 스냅샷이 가리키는 로그가 그 뒤로 잘리거나 교체되지 않았는지 확인하는 용도
+ * 반환값: 성공 시 0, 로그가 offset 보다 짧거나 실패 시 -1
+ */
+int db_score_log_fingerprint(uint64_t offset, uint64_t* fingerprint);
 
-#endif  // DB_HANDLER_H
\ No newline at end of file
+#endif  // DB_HANDLER_H
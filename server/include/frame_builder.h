@@ -0,0 +1,36 @@
+// server/include/frame_builder.h
+#ifndef FRAME_BUILDER_H
+#define FRAME_BUILDER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "shared_buffer.h"
+
+/*
+ * 연결의 프로토콜 버전(wire_version)에 맞는 응답 프레임 생성
+ * 버전 0 은 MessageHeader + 구조체 그대로, 버전 1 이상은 wire_codec.h 형식
+ * request_id 는 응답할 요청의 ID (버전 2 이상에서만 헤더에 기록)
+ */
+
+/*
+ * 헤더만 채운 프레임 생성 (바디는 호출자가 *body 에 body_len 바이트 기록)
+ * 이미 바이트 단위로 정의된 바디(압축 단어 리스트 등)용, 실패 시 NULL
+ */
+SharedBuffer* frame_builder_alloc(int wire_version, uint32_t type, uint32_t request_id, size_t body_len, uint8_t** body);
+
+/*
+ * 메시지 구조체(msg_len 바이트)를 인코딩한 프레임 생성, 실패 시 NULL
+ */
+SharedBuffer* frame_builder_encode(int wire_version, uint32_t type, uint32_t request_id, const void* msg, size_t msg_len);
+
+/*
+ * 헤더 없이 바디만 인코딩 (여러 요청이 공유하는 캐시용)
+ * 보낼 때 frame_builder_header 로 만든 요청별 헤더 뒤에 붙임
+ */
+SharedBuffer* frame_builder_encode_body(int wire_version, uint32_t type, const void* msg, size_t msg_len);
+
+/* body_len 바이트 바디 앞에 붙일 헤더만 담은 버퍼, 실패 시 NULL */
+SharedBuffer* frame_builder_header(int wire_version, uint32_t type, uint32_t request_id, size_t body_len);
+
+#endif  // FRAME_BUILDER_H
@@ -0,0 +1,20 @@
+// server/include/leaderboard_cache.h
+#ifndef LEADERBOARD_CACHE_H
+#define LEADERBOARD_CACHE_H
+
+#include "shared_buffer.h"
+
+/*
+ * 현재 리더보드의 인코딩된 응답 바디 (wire_version 형식의 LeaderboardResponse, 헤더 제외)
+ * 상위 K 명이 바뀐 경우에만 다시 만들고, 그 외에는 같은 버퍼를 공유
+ * 보낼 때 요청 ID 가 들어간 헤더를 따로 만들어 앞에 붙임
+ * 반환값: 참조가 하나 추가된 버퍼 (사용 후 shared_buffer_unref), 실패 시 NULL
+ */
+SharedBuffer* leaderboard_cache_get_body(int wire_version);
+
+/*
+ * 캐시된 버퍼 해제 (서버 종료 시)
+ */
+void leaderboard_cache_cleanup(void);
+
+#endif  // LEADERBOARD_CACHE_H
@@ -3,8 +3,44 @@
 #define SCORE_MANAGER_H
 #include "protocol.h"
 
-void init_score_system();
+/*
+ * 점수 제출 결과 콜백 (WAL 기록 스레드 또는 호출 스레드에서 호출됨)
+ * response_msg: 클라이언트에 보낼 메시지 (콜백 안에서만 유효)
+ */
+typedef void (*ScoreSubmitCallback)(int success, const char* response_msg, void* ctx);
+
+/*
+ * 점수 상태 적재
+ * snapshot: 압축 스냅샷 경로 (NULL 이면 사용 안 함), 유효하면 스냅샷 + 그 이후의 점수 로그 꼬리만 재생하고
+ *           없거나 손상되었거나 로그와 이어지지 않으면 점수 로그 전체를 재생
+ */
+void init_score_system(const char* snapshot);
+
+/*
+ * 주기적 압축 스레드 시작: interval_sec 마다 마지막 스냅샷 이후 반영된 점수가 있으면 새 스냅샷 기록
+ * (init_score_system 에 스냅샷 경로를 준 경우에만, WAL 시작 뒤에 호출)
+ * 반환값: 성공 시 0, 실패하거나 스냅샷을 쓰지 않으면 -1
+ */
+int start_score_compaction(int interval_sec);
+
+/* 압축 스레드 정지 후 마지막 스냅샷 기록 (score_wal_stop 뒤에 호출) */
+void stop_score_compaction(void);
+
+/*
+ * 점수 제출 (비동기)
+ * WAL 그룹 커밋으로 디스크에 기록된 뒤 리더보드에 반영하고 on_done 을 정확히 한 번 호출
+ */
+void submit_score_async(const char* username, int score, ScoreSubmitCallback on_done, void* ctx);
+
+/*
+ * 점수 제출 (동기): 기록이 끝날 때까지 대기
+ */
 int submit_score_impl(const char* username, int score, char* response_msg);
 void get_leaderboard_impl(LeaderboardEntry* entries, int* count, int max_entries);
 
+/*
+ * 리더보드 상위 항목이 바뀔 때마다 증가하는 버전 번호 (응답 캐시 무효화용)
+ */
+unsigned long get_leaderboard_version(void);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,71 @@
+// server/include/score_snapshot.h
+#ifndef SCORE_SNAPSHOT_H
+#define SCORE_SNAPSHOT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "protocol.h"
+
+/*
+ * 점수 로그 압축 스냅샷 (바이너리, little-endian)
+ * - 사용자별 최고 점수/판 수/점수 합계와 전체 판 수를 한 파일에 담고
+ *   스냅샷이 반영한 점수 로그 위치(db_score_log_size)를 함께 기록
+ * - 시작 시 스냅샷을 mmap 해 적재한 뒤 그 위치 이후의 로그 꼬리만 재생하면 되므로
+ *   적재 시간이 기록된 판 수가 아니라 사용자 수에 비례
+ * - 항목은 리더보드 상위 top_count 명(리더보드 순서 그대로)이 먼저 오고,
+ *   나머지는 최고 점수 내림차순, 같으면 사용자명 오름차순
+ *
+ * 파일 구성:
+ *   헤더 64바이트
+ *     [0]  "RSNP"           [4]  버전(u16)        [6]  항목 크기(u16)
+ *     [8]  log_offset(u64)  [16] log_fingerprint(u64)
+ *     [24] total_games(u64) [32] player_count(u32) [36] top_count(u32)
+ *     [40] 생성 시각(u64, 유닉스 초)
+ *     [48] 항목 영역 FNV-1a(u64)  [56] 헤더 [0, 56) FNV-1a(u64)
+ *   항목 48바이트 × player_count
+ *     [0] 사용자명(MAX_ID_LEN, '\0' 채움)  [32] best(i32)  [36] games(u32)  [40] total(i64)
+ */
+
+typedef struct {
+  char username[MAX_ID_LEN];
+  int best;
+  uint32_t games; /* 기록된 판 수 */
+  int64_t total;  /* 점수 합계 */
+} ScoreSnapshotEntry;
+
+typedef struct {
+  uint64_t log_offset;      /* 점수 로그의 이 위치까지 반영됨 */
+  uint64_t log_fingerprint; /* log_offset 직전 구간 지문 (db_score_log_fingerprint) */
+  uint64_t total_games;
+  uint32_t player_count;
+  uint32_t top_count; /* 앞에서부터 이 수만큼이 리더보드 상위 */
+} ScoreSnapshotInfo;
+
+/* mmap 으로 연 스냅샷 (score_snapshot_close 전까지 유효) */
+typedef struct {
+  ScoreSnapshotInfo info;
+  const uint8_t* entries;
+  void* map;
+  size_t map_size;
+} ScoreSnapshot;
+
+/*
+ * 스냅샷 기록: 같은 디렉터리의 임시 파일에 쓰고 fsync 한 뒤 rename 으로 교체
+ * entries: 앞의 info->top_count 개는 리더보드 순서, 나머지는 이 함수가 정렬함
+ * 반환값: 성공 시 0, 실패 시 -1
+ */
+int score_snapshot_write(const char* path, const ScoreSnapshotInfo* info, ScoreSnapshotEntry* entries);
+
+/*
+ * 스냅샷을 mmap 하고 형식과 체크섬 검증
+ * 반환값: 성공 시 0, 파일이 없으면 1, 손상되었거나 읽기 실패 시 -1
+ */
+int score_snapshot_open(const char* path, ScoreSnapshot* snap);
+
+/* index 번째 항목 디코딩 */
+void score_snapshot_entry(const ScoreSnapshot* snap, uint32_t index, ScoreSnapshotEntry* out);
+
+void score_snapshot_close(ScoreSnapshot* snap);
+
+#endif  // SCORE_SNAPSHOT_H
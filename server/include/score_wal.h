@@ -0,0 +1,46 @@
+// server/include/score_wal.h
+#ifndef SCORE_WAL_H
+#define SCORE_WAL_H
+
+#include "db_handler.h"
+
+/*
+ * 점수 기록 완료 콜백 (WAL 기록 스레드에서 호출됨)
+ * success: 디스크 기록(및 설정된 동기화) 성공 시 1, 실패 시 0
+ */
+typedef void (*WalCommitCallback)(int success, void* ctx);
+
+/*
+ * 점수 WAL(저장소의 추가 전용 점수 로그) 그룹 커밋 스레드 시작
+ * sync_mode: 배치마다 수행할 동기화 방식 (내구성 수준)
+ * max_batch: 한 번에 묶어 기록할 최대 점수 수
+ * 반환값: 성공 시 0, 실패 시 -1
+ */
+int score_wal_start(DbSyncMode sync_mode, int max_batch);
+
+/*
+ * 점수 기록 요청 (블록하지 않음)
+ * 기록 스레드가 대기 중인 요청들을 한 번의 write + 한 번의 동기화로 처리한 뒤
+ * 각 요청의 on_commit 을 호출
+ * 반환값: 대기열에 추가되면 0, WAL 이 실행 중이 아니거나 메모리 부족이면 -1
+ */
+int score_wal_append(const char* username, int score, WalCommitCallback on_commit, void* ctx);
+
+/* 배치 경계에서 실행할 함수 (score_wal_checkpoint) */
+typedef void (*WalCheckpointFn)(void* ctx);
+
+/*
+ * 배치 경계에서 fn 실행: 지금까지 기록한 배치의 on_commit 은 모두 끝났고
+ * 다음 배치는 아직 쓰지 않은 시점이라 점수 로그와 메모리 상태가 정확히 일치함
+ * 기록 스레드가 돌고 있으면 그 스레드에서 실행하고 끝날 때까지 기다림 (그동안 기록은 멈춤),
+ * 없으면 호출 스레드에서 바로 실행
+ */
+void score_wal_checkpoint(WalCheckpointFn fn, void* ctx);
+
+/*
+ * 대기 중인 기록을 모두 처리한 뒤 기록 스레드 종료 (on_commit 이 모두 호출된 뒤 반환)
+ * 이미 멈췄으면 아무것도 하지 않음
+ */
+void score_wal_stop(void);
+
+#endif  // SCORE_WAL_H
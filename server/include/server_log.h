@@ -0,0 +1,57 @@
+// server/include/server_log.h
+#ifndef SERVER_LOG_H
+#define SERVER_LOG_H
+
+#include <stdint.h>
+
+/*
+ * 비동기 서버 로그
+ * - 호출한 스레드는 메시지를 자기 링 버퍼의 고정 크기 레코드 하나로 만들어 넣기만 함
+ *   (스레드마다 링이 따로라 락, 원자적 증가, 시스템 콜 없음)
+ * - 백그라운드 기록 스레드가 주기적으로 모든 링을 시각 순으로 합쳐 한 번의 write 로 출력
+ *   (WARN 이상은 stderr, 나머지는 stdout)
+ * - 링이 가득 찼거나 스레드별 초당 한도를 넘은 메시지는 기다리지 않고 버리고,
+ *   버린 수는 기록 스레드가 나중에 한 줄로 알림
+ * - 기록 스레드가 시작 전이거나 정지한 뒤에는 호출한 스레드에서 바로 출력 (시작/종료 과정용)
+ *
+ * 사용법: 파일마다 LOG_MODULE 을 정의하고 LOG_INFO("Client connected: %s", ...) 처럼 호출
+ *         %m 은 호출 시점의 errno 메시지 (perror 대신)
+ */
+
+typedef enum { LOG_LEVEL_DEBUG = 0, LOG_LEVEL_INFO, LOG_LEVEL_WARN, LOG_LEVEL_ERROR } LogLevel;
+
+/* 이 수준 미만은 포맷하지 않고 바로 버림 */
+extern int server_log_min_level;
+
+#define LOG_AT(level, ...)                                                                    \
+  do {                                                                                        \
+    if ((level) >= __atomic_load_n(&server_log_min_level, __ATOMIC_RELAXED)) {                \
+      server_log((level), LOG_MODULE, __VA_ARGS__);                                           \
+    }                                                                                         \
+  } while (0)
+
+#define LOG_DEBUG(...) LOG_AT(LOG_LEVEL_DEBUG, __VA_ARGS__)
+#define LOG_INFO(...) LOG_AT(LOG_LEVEL_INFO, __VA_ARGS__)
+#define LOG_WARN(...) LOG_AT(LOG_LEVEL_WARN, __VA_ARGS__)
+#define LOG_ERROR(...) LOG_AT(LOG_LEVEL_ERROR, __VA_ARGS__)
+
+/* module: 문자열 리터럴 (레코드에는 포인터만 저장) */
+void server_log(LogLevel level, const char* module, const char* fmt, ...) __attribute__((format(printf, 3, 4)));
+
+/*
+ * "debug" / "info" / "warn" / "error" → 수준
+ * 반환값: 알 수 없는 이름이면 -1
+ */
+int server_log_parse_level(const char* name);
+
+/*
+ * 기록 스레드 시작
+ * min_level: 출력할 최저 수준, rate_limit: 스레드마다 초당 최대 메시지 수
+ * 반환값: 성공 시 0, 실패 시 -1 (이후에도 로그는 호출한 스레드에서 바로 출력됨)
+ */
+int server_log_start(LogLevel min_level, int rate_limit);
+
+/* 남은 레코드를 모두 출력한 뒤 기록 스레드 정지 및 링 해제 (로그를 남기는 다른 스레드가 모두 끝난 뒤, exit 시에도 자동 호출) */
+void server_log_stop(void);
+
+#endif  // SERVER_LOG_H
@@ -0,0 +1,63 @@
+// server/include/server_metrics.h
+#ifndef SERVER_METRICS_H
+#define SERVER_METRICS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * 서버 지표 (요청 종류별 지연 히스토그램, DB 시간, 연결 수, 송수신 바이트)
+ * - 기록하는 스레드마다 자기 블록을 하나씩 두고 그 스레드만 씀 → 락, 원자적 증가 없음
+ *   블록은 스레드가 처음 기록할 때 만들어 전역 목록에 올리고 서버 종료 시 해제
+ * - 읽는 쪽(metrics_render)은 모든 블록을 relaxed 원자 읽기로 합산하므로 기록을 멈추지 않음
+ * - 지연은 마이크로초 단위 로그-선형 히스토그램 (latency_histogram.h)
+ */
+
+/* 누적 카운터 */
+typedef enum {
+  METRIC_CONN_OPENED = 0,
+  METRIC_CONN_CLOSED,
+  METRIC_BYTES_IN,
+  METRIC_BYTES_OUT,
+  METRIC_COUNTER_COUNT
+} MetricCounter;
+
+/* db_handler 시간 */
+typedef enum {
+  METRIC_DB_LOCK_WAIT = 0, /* 파일 mutex 대기 */
+  METRIC_DB_READ,          /* 점수 파일 전체 읽기 */
+  METRIC_DB_WRITE,         /* 사용자/점수 줄 쓰기 */
+  METRIC_DB_FSYNC,         /* fsync / fdatasync */
+  METRIC_DB_OP_COUNT
+} MetricDbOp;
+
+/* 단조 시계 (나노초) */
+uint64_t metrics_now_ns(void);
+
+void metrics_count(MetricCounter counter, uint64_t amount);
+
+/* 요청 하나의 처리 시간 (디코딩 완료 ~ 응답 준비 완료), type: 요청 MessageType */
+void metrics_record_request(uint32_t type, uint64_t elapsed_ns);
+
+void metrics_record_db(MetricDbOp op, uint64_t elapsed_ns);
+
+/*
+ * 현재 지표를 Prometheus 텍스트 형식으로 (호출자가 free)
+ * 실패 시 NULL
+ */
+char* metrics_render(size_t* len);
+
+/*
+ * 지표 덤프용 Unix 도메인 소켓 스레드 시작
+ * 접속마다 지표 텍스트를 한 번 쓰고 닫음 (요청이 "GET" 으로 시작하면 HTTP 응답 헤더를 붙임)
+ * 반환값: 성공 시 0, 실패 시 -1
+ */
+int metrics_start_socket(const char* path);
+
+/* 소켓 스레드 정지 및 소켓 파일 삭제 */
+void metrics_stop_socket(void);
+
+/* 스레드별 블록 해제 (서버 종료 시, 기록하는 스레드가 모두 끝난 뒤) */
+void metrics_cleanup(void);
+
+#endif  // SERVER_METRICS_H
@@ -2,6 +2,24 @@
 #ifndef SERVER_NETWORK_H
 #define SERVER_NETWORK_H
 
-void* handle_client(void* arg);
+typedef struct {
+  int num_reactors;   /* 소켓 I/O 를 담당하는 이벤트 루프 스레드 수 (호출 스레드 포함) */
+  int num_workers;    /* 요청 핸들러를 실행하는 워커 스레드 수 */
+  int queue_capacity; /* 워커 대기 큐 길이, 가득 차면 리액터가 읽기를 멈춤 */
+} ServerNetworkConfig;
 
-#endif  // SERVER_NETWORK_H
\ No newline at end of file
+/*
+ * epoll 기반 이벤트 루프 실행
+ * listen_fd: bind/listen 이 끝난 서버 소켓
+ * config: 리액터/워커 스레드 수 및 큐 길이
+ * 종료 요청이 들어올 때까지 블록되며, 모든 연결을 정리한 뒤 반환
+ * 반환값: 성공 시 0, 실패 시 -1
+ */
+int run_server_event_loop(int listen_fd, const ServerNetworkConfig* config);
+
+/*
+ * 이벤트 루프 종료 요청 (시그널 핸들러에서 호출 가능)
+ */
+void request_server_shutdown(void);
+
+#endif  // SERVER_NETWORK_H
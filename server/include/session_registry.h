@@ -0,0 +1,36 @@
+// server/include/session_registry.h
+#ifndef SESSION_REGISTRY_H
+#define SESSION_REGISTRY_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/*
+ * 로그인 중인 세션 목록 (사용자명 → 세션 소켓)
+ * 사용자명 해시로 샤드를 고르고 샤드마다 open addressing 테이블과 락을 따로 두므로
+ * 서로 다른 사용자의 로그인/로그아웃은 거의 다투지 않고 O(1) 로 끝남
+ * 테이블은 차면 두 배로 커지므로 동시 로그인 수 상한이 없음
+ */
+
+/* 모든 세션 제거 (서버 시작 시) */
+void session_registry_init(void);
+
+/* 모든 세션 제거 및 메모리 해제 (서버 종료 시) */
+void session_registry_destroy(void);
+
+/* username 으로 로그인 중인 세션이 있는지 */
+bool session_registry_contains(const char* username);
+
+/*
+ * 세션 등록 (확인과 등록을 한 번에 하므로 같은 ID 로 동시에 로그인해도 하나만 성공)
+ * 반환값: 등록 1, 이미 다른 세션이 로그인 중 0, 메모리 부족 -1
+ */
+int session_registry_claim(const char* username, int client_sock);
+
+/* client_sock 이 등록한 username 세션 제거 (다른 소켓이 등록한 세션은 그대로), 제거했으면 true */
+bool session_registry_release(const char* username, int client_sock);
+
+/* 현재 로그인 중인 세션 수 */
+size_t session_registry_count(void);
+
+#endif  // SESSION_REGISTRY_H
@@ -0,0 +1,28 @@
+// server/include/shared_buffer.h
+#ifndef SHARED_BUFFER_H
+#define SHARED_BUFFER_H
+
+#include <stdatomic.h>
+#include <stddef.h>
+
+/*
+ * 참조 카운트 기반 불변 바이트 버퍼
+ * - 같은 응답(예: 리더보드)을 여러 연결의 송신 큐가 복사 없이 공유
+ * - 생성 직후 참조 수는 1, 마지막 unref 에서 해제
+ */
+typedef struct {
+  atomic_int refs;
+  size_t len;
+  char data[];
+} SharedBuffer;
+
+/* len 바이트 버퍼 생성 (내용은 호출자가 채움), 실패 시 NULL */
+SharedBuffer* shared_buffer_create(size_t len);
+
+/* 참조 추가 후 같은 포인터 반환 */
+SharedBuffer* shared_buffer_ref(SharedBuffer* buf);
+
+/* 참조 해제, 0 이 되면 메모리 해제 (NULL 허용) */
+void shared_buffer_unref(SharedBuffer* buf);
+
+#endif  // SHARED_BUFFER_H
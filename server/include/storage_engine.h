@@ -0,0 +1,63 @@
+// server/include/storage_engine.h
+#ifndef STORAGE_ENGINE_H
+#define STORAGE_ENGINE_H
+
+#include <pthread.h>
+#include <stdint.h>
+
+#include "db_handler.h"
+
+/*
+ * 저장소 백엔드 인터페이스 (db_handler 가 시작 시 하나를 골라 모든 호출을 넘김)
+ * - 백엔드마다 함수 테이블 하나와 open 이 돌려주는 자기 상태 포인터로 구성
+ * - 모든 함수는 여러 스레드에서 동시에 호출될 수 있음 (동기화는 백엔드 책임)
+ * - 점수 로그 위치(offset)는 백엔드마다 의미가 다른 불투명한 값이지만
+ *   같은 백엔드 안에서는 기록 순서대로 증가하고, 길이(score_log_size)가 곧 마지막 위치
+ */
+typedef struct {
+  const char* name;
+
+  /*
+   * dir 아래의 자기 파일을 열고(없으면 생성) 인덱스 적재, 실패 시 NULL
+   * max_batch: append_scores 한 번에 들어오는 최대 레코드 수 (비정상 종료로 찢어졌다고 볼 수 있는 꼬리의 한도)
+   */
+  void* (*open)(const char* dir, int max_batch);
+  void (*close)(void* state);
+
+  /* 반환값: 찾으면 1, 없으면 0, 에러 시 -1 */
+  int (*find_user)(void* state, const char* username, UserData* found_user);
+
+  /* 기록 후 fsync, 반환값: 추가되면 1, 이미 있거나 실패 시 0 */
+  int (*add_user)(void* state, const UserData* user);
+
+  /* 한 번의 쓰기와 한 번의 동기화로 추가, 반환값: 성공 시 1, 실패 시 0 */
+  int (*append_scores)(void* state, const ScoreRecord records[], int count, DbSyncMode sync_mode);
+
+  /* start_offset 부터 끝까지의 점수를 순서대로 전달, 반환값: 전달한 수, 실패하거나 로그가 start_offset 보다 짧으면 -1 */
+  int (*for_each_score)(void* state, uint64_t start_offset, ScoreVisitor visitor, void* ctx, uint64_t* end_offset);
+
+  int (*score_log_size)(void* state, uint64_t* size);
+
+  /* offset 직전 구간(최대 STORAGE_FINGERPRINT_WINDOW 바이트) 지문, 로그가 offset 보다 짧으면 -1 */
+  int (*score_log_fingerprint)(void* state, uint64_t offset, uint64_t* fingerprint);
+} StorageEngine;
+
+/* score_log_fingerprint 가 해시하는 offset 직전 구간 길이 */
+#define STORAGE_FINGERPRINT_WINDOW 64
+
+/* 줄 단위 텍스트 파일 (users.txt, scores.txt) */
+extern const StorageEngine storage_text_engine;
+
+/* 추가 전용 바이너리 로그 (users.log, scores.log) + 메모리 인덱스 */
+extern const StorageEngine storage_log_engine;
+
+/* 이름으로 백엔드 찾기 ("text" / "log"), 없으면 NULL */
+const StorageEngine* storage_engine_find(const char* name);
+
+/* 파일 mutex 획득 (대기 시간을 지표로 기록, 바로 얻으면 0) */
+void storage_lock_mutex(pthread_mutex_t* mutex);
+
+/* fd 파일의 offset 직전 구간 지문, 파일이 offset 보다 짧으면 -1 */
+int storage_fingerprint_fd(int fd, uint64_t offset, uint64_t* fingerprint);
+
+#endif  // STORAGE_ENGINE_H
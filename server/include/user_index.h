@@ -0,0 +1,31 @@
+// server/include/user_index.h
+#ifndef USER_INDEX_H
+#define USER_INDEX_H
+
+#include <stddef.h>
+
+#include "db_handler.h"
+
+/*
+ * 사용자 인덱스 (open addressing + linear probing, 저장소 백엔드 공용)
+ * - 시작 시 백엔드가 사용자 파일을 한 번 읽어 채우고, 이후 조회는 파일 없이 O(1)
+ * - 락은 호출자 책임 (조회는 읽기 락, 추가는 쓰기 락으로 감싸서 사용)
+ */
+typedef struct {
+  UserData* slots; /* username[0] == '\0' 이면 빈 슬롯 */
+  size_t capacity;
+  size_t count;
+} UserIndex;
+
+/* 빈 인덱스 할당, 반환값: 성공 시 0, 메모리 부족 시 -1 */
+int user_index_init(UserIndex* index);
+
+/* 없으면 NULL (반환된 포인터는 다음 삽입 전까지만 유효) */
+const UserData* user_index_find(const UserIndex* index, const char* username);
+
+/* 반환값: 새로 추가 1, 이미 존재 0, 메모리 부족 -1 */
+int user_index_insert(UserIndex* index, const UserData* user);
+
+void user_index_free(UserIndex* index);
+
+#endif  // USER_INDEX_H
@@ -2,8 +2,102 @@
 #define WORD_MANAGER_H
 #include "protocol.h"
 
-extern WordListResponse g_wordlist;
+#include <stddef.h>
+#include <stdint.h>
+
+/* 난이도 점수 (0~255) → 구간 (WORD_BAND_*) */
+#define WORD_DIFFICULTY_BAND(score) ((score) >> 6)
+
+/* (난이도 구간, 단어 바이트 길이) 색인 키 수 */
+#define WORD_INDEX_KEYS (WORD_BAND_COUNT * MAX_WORD_STR_LEN)
+
+/*
+ * 불변 단어 목록 스냅샷
+ * 로드/리로드마다 새로 만들어 포인터 교체 한 번으로 게시하고, 게시된 뒤에는 수정하지 않음
+ * 세 가지 응답 형식(고정 크기, 압축, etag)과 난이도 표본이 항상 같은 목록에서 나옴
+ */
+typedef struct {
+  WordListResponse legacy; /* 기존 고정 크기 응답용 (앞쪽 MAX_WORDLIST_WORDS 개만 담김) */
+  uint8_t* packed;         /* 전체 단어를 [u8 len][bytes] 로 이어 붙인 문자열 아레나 */
+  size_t packed_len;
+  uint32_t* offsets;   /* offsets[i]: i 번째 단어 시작 위치, offsets[count]: 전체 길이 */
+  uint8_t* difficulty; /* 단어별 난이도 점수 */
+  int count;           /* 전체 단어 수 (MAX_WORDLIST_WORDS 제한 없음) */
+  uint64_t etag;       /* wire_wordlist_etag (조건부 요청용) */
+  uint64_t generation; /* 게시 순번 (목록이 바뀌었는지 확인용, 내용이 같아도 다름) */
+
+  /*
+   * 단어 번호를 (난이도 구간, 길이) 순으로 정렬한 색인
+   * 키 band * MAX_WORD_STR_LEN + len 의 단어들은 by_band_length[index_start[key] .. index_start[key + 1]) 에 있음
+   * → 한 구간 안의 길이 범위는 연속 구간 하나
+   */
+  uint32_t* by_band_length;
+  uint32_t index_start[WORD_INDEX_KEYS + 1];
+} WordList;
+
+/* 시작 시 한 번 로드 (파일이 없거나 비어 있으면 기본 목록을 써 넣음), 성공 시 단어 수 (≥1), 실패 시 음수 */
 int load_wordlist_from_file(const char* path);
 
-#endif
+/*
+ * 현재 목록 읽기 (락 없음)
+ * acquire 가 돌려준 목록은 같은 read_slot 으로 release 할 때까지 해제되지 않음
+ * 리로드가 중간에 일어나도 읽는 쪽은 acquire 시점의 목록 하나만 봄
+ */
+const WordList* word_list_acquire(int* read_slot);
+void word_list_release(int read_slot);
+
+/*
+ * start 번째 단어부터 max_bytes 안에 들어가는 만큼의 압축 단어 바이트 ([u8 len][bytes] 반복)
+ * count: 포함된 단어 수, bytes: 바이트 수
+ * 반환값: 시작 위치 (start 가 범위 밖이면 NULL 이고 count = 0)
+ */
+const uint8_t* word_list_packed_range(const WordList* list, int start, size_t max_bytes, int* count, size_t* bytes);
+
+/*
+ * 난이도 구간 band (WORD_BAND_ANY 면 전체) 이고 바이트 길이가 [min_len, max_len] 인 단어 중
+ * 중복 없이 무작위로 최대 max_count 개 (WORD_SAMPLE_MAX 이하) 를 골라 out 에 단어 번호를 기록
+ * 길이 0 은 제한 없음, available: 조건에 맞는 전체 단어 수
+ * 반환값: 고른 단어 수
+ */
+int word_list_sample(const WordList* list, int band, int min_len, int max_len, uint32_t* out, int max_count, uint32_t* available);
 
+/*
+ * 단어 스트림 위치 (연결마다 하나, MSG_TYPE_WORD_STREAM_*)
+ * 구간 안 단어 번호 [begin, begin + size) 를 (offset + i * step) mod size 순열 순서로 내보냄
+ * step 은 size 와 서로소라 한 바퀴에 모든 단어가 한 번씩 나오고, 한 바퀴가 끝나면 새 순열을 뽑음
+ */
+typedef struct {
+  uint64_t generation; /* 만든 목록의 게시 순번 (0 이면 시작 전) */
+  int band;
+  uint32_t begin;
+  uint32_t size;
+  uint32_t step;
+  uint32_t offset;
+  uint32_t position;
+} WordStreamCursor;
+
+/* band (WORD_BAND_ANY 면 전체) 로 스트림 (다시) 시작 */
+void word_stream_reset(WordStreamCursor* cursor, const WordList* list, int band);
+
+/*
+ * 스트림에서 다음 단어 번호를 최대 max_count 개 (WORD_SAMPLE_MAX 이하) out 에 기록
+ * cursor 가 다른 목록에서 만들어졌으면 같은 구간으로 다시 시작, available: 구간의 단어 수
+ * 반환값: 기록한 단어 수
+ */
+int word_stream_next(WordStreamCursor* cursor, const WordList* list, uint32_t* out, int max_count, uint32_t* available);
+
+/*
+ * 단어 파일 리로드 감시 스레드 시작
+ * 파일이 교체되거나(rename) 쓰기가 끝나면(inotify) 또는 request_wordlist_reload() 가 불리면
+ * 새 목록을 만들어 게시 (읽을 수 없거나 단어가 없으면 기존 목록 유지)
+ * 반환값: 성공 시 0, 실패 시 -1
+ */
+int start_wordlist_watcher(const char* path);
+
+/* 감시 스레드 정지 후 현재 목록 해제 (서버 종료 시, 읽는 쪽이 모두 끝난 뒤) */
+void stop_wordlist_watcher(void);
+
+/* 리로드 요청 (SIGHUP 핸들러에서 호출 가능) */
+void request_wordlist_reload(void);
+
+#endif
@@ -0,0 +1,28 @@
+// server/include/worker_pool.h
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+
+/* 워커 스레드에서 실행할 작업 함수 */
+typedef void (*WorkerTaskFunc)(void* arg);
+
+/*
+ * 고정 크기 워커 스레드 풀 시작
+ * num_workers: 워커 스레드 수
+ * queue_capacity: 대기 작업 큐 최대 길이 (가득 차면 제출자가 대기)
+ * 반환값: 성공 시 0, 실패 시 -1
+ */
+int worker_pool_start(int num_workers, int queue_capacity);
+
+/*
+ * 작업 제출 (여러 스레드에서 동시에 호출 가능)
+ * 큐가 가득 차 있으면 빈 자리가 생길 때까지 블록 → 리액터가 소켓 읽기를 멈추는 backpressure
+ * 반환값: 성공 시 0, 풀이 정지 중이면 -1
+ */
+int worker_pool_submit(WorkerTaskFunc func, void* arg);
+
+/*
+ * 풀 정지: 새 작업을 받지 않고 큐에 남은 작업을 모두 처리한 뒤 워커 종료
+ */
+void worker_pool_stop(void);
+
+#endif  // WORKER_POOL_H
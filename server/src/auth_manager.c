@@ -6,14 +6,17 @@
 
 #include "db_handler.h"
 #include "hash_util.h" /* 암호화 유틸리티 추가 */
+#include "server_log.h"
+
+#define LOG_MODULE "AUTH_MANAGER"
 
 void init_auth_system() {
   /* 암호화 시스템 초기화 */
   if (!crypto_init()) {
-    fprintf(stderr, "[AUTH_MANAGER] Failed to initialize crypto system\n");
+    LOG_ERROR("Failed to initialize crypto system");
     return;
   }
-  printf("[AUTH_MANAGER] Auth system initialized with crypto support (using file DB).\n");
+  LOG_INFO("Auth system initialized with crypto support (using %s storage).", db_engine_name());
 }
 
 int register_user_impl(const char* username, const char* hashed_password, char* response_msg) {
@@ -29,7 +32,7 @@ int register_user_impl(const char* username, const char* hashed_password, char*
   }
 
   UserData existing_user;
-  int find_res = find_user_in_file(username, &existing_user);
+  int find_res = db_find_user(username, &existing_user);
 
   if (find_res == 1) {
     snprintf(response_msg, MAX_MSG_LEN, "User '%s' already exists.", username);
@@ -49,7 +52,7 @@ int register_user_impl(const char* username, const char* hashed_password, char*
   strncpy(new_user.password, hashed_password, MAX_PW_LEN - 1);
   new_user.password[MAX_PW_LEN - 1] = '\0';
 
-  if (add_user_to_file(&new_user)) {
+  if (db_add_user(&new_user)) {
     snprintf(response_msg, MAX_MSG_LEN, "User '%s' registered successfully.", username);
     response_msg[MAX_MSG_LEN - 1] = '\0';
     return 1;
@@ -69,7 +72,7 @@ int login_user_impl(const char* username, const char* hashed_password, char* res
   }
 
   UserData user_from_db;
-  int find_res = find_user_in_file(username, &user_from_db);
+  int find_res = db_find_user(username, &user_from_db);
 
   if (find_res == 0) {
     snprintf(response_msg, MAX_MSG_LEN, "User '%s' not found.", username);
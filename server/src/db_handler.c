@@ -2,49 +2,67 @@
 #include "db_handler.h"
 
 #include <errno.h>
-#include <fcntl.h>
-#include <pthread.h>  // mutex를 위해 추가
+#include <pthread.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <sys/file.h>  // flock() 함수를 위해 추가
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
 
+#include "hash_util.h"
+#include "server_log.h"
+#include "server_metrics.h"
+#include "storage_engine.h"
+
+#define LOG_MODULE "DB_HANDLER"
+
 #define DATA_DIR_PATH "data"
-#define USERS_FILE_PATH DATA_DIR_PATH "/users.txt"
-#define SCORES_FILE_PATH DATA_DIR_PATH "/scores.txt"
+#define DEFAULT_ENGINE "text"
 
-// 파일 접근 동기화를 위한 전역 mutex들
-static pthread_mutex_t users_file_mutex = PTHREAD_MUTEX_INITIALIZER;
-static pthread_mutex_t scores_file_mutex = PTHREAD_MUTEX_INITIALIZER;
+/* 사용 중인 백엔드 (init_db 에서 한 번 정해지고 이후 바뀌지 않음) */
+static const StorageEngine *engine = NULL;
+static void *engine_state = NULL;
 
-// 한 줄씩 읽기 위한 버퍼 기반 읽기 함수
-static ssize_t read_line(int fd, char *buffer, size_t buffer_size) {
-  size_t pos = 0;
-  char ch;
-  ssize_t bytes_read;
+static const StorageEngine *const engines[] = {&storage_text_engine, &storage_log_engine};
 
-  while (pos < buffer_size - 1) {
-    bytes_read = read(fd, &ch, 1);
-    if (bytes_read == 0) {     // EOF
-      if (pos == 0) return 0;  // 아무것도 읽지 못함
-      break;
-    }
-    if (bytes_read < 0) {  // 에러
-      return -1;
+const StorageEngine *storage_engine_find(const char *name) {
+  for (size_t i = 0; i < sizeof(engines) / sizeof(engines[0]); i++) {
+    if (strcmp(engines[i]->name, name) == 0) {
+      return engines[i];
     }
+  }
+  return NULL;
+}
 
-    if (ch == '\n') {
-      break;
-    }
+// 요청 처리 중의 파일 mutex 획득 (대기 시간을 지표로 기록, 바로 얻으면 0)
+void storage_lock_mutex(pthread_mutex_t *mutex) {
+  if (pthread_mutex_trylock(mutex) == 0) {
+    metrics_record_db(METRIC_DB_LOCK_WAIT, 0);
+    return;
+  }
+  uint64_t start = metrics_now_ns();
+  pthread_mutex_lock(mutex);
+  metrics_record_db(METRIC_DB_LOCK_WAIT, metrics_now_ns() - start);
+}
+
+int storage_fingerprint_fd(int fd, uint64_t offset, uint64_t *fingerprint) {
+  uint8_t window[STORAGE_FINGERPRINT_WINDOW];
+  size_t len = offset < STORAGE_FINGERPRINT_WINDOW ? (size_t)offset : STORAGE_FINGERPRINT_WINDOW;
 
-    buffer[pos++] = ch;
+  if (len == 0) {
+    *fingerprint = hash_bytes_fnv1a("", 0);
+    return 0;
+  }
+
+  ssize_t n = pread(fd, window, len, (off_t)(offset - len));
+  if (n != (ssize_t)len) {
+    return -1;  // 파일이 offset 보다 짧음 (잘렸거나 교체됨)
   }
 
-  buffer[pos] = '\0';
-  return pos;
+  *fingerprint = hash_bytes_fnv1a(window, len);
+  return 0;
 }
 
 static int create_directory_if_not_exists(const char *path) {
@@ -54,13 +72,13 @@ static int create_directory_if_not_exists(const char *path) {
     if (S_ISDIR(st.st_mode)) {
       return 0;  // 디렉터리 존재
     } else {
-      fprintf(stderr, "[DB_HANDLER] Error: Path exists but is not a directory: %s\n", path);
+      LOG_ERROR("Error: Path exists but is not a directory: %s", path);
       return -1;
     }
   } else {
     // 디렉터리 생성 시도
     if (mkdir(path, 0755) == 0) {
-      printf("[DB_HANDLER] Directory created: %s\n", path);
+      LOG_INFO("Directory created: %s", path);
       return 0;
     } else {
       if (errno == EEXIST) {
@@ -69,237 +87,67 @@ static int create_directory_if_not_exists(const char *path) {
           return 0;
         }
       }
-      perror("[DB_HANDLER] mkdir failed");
-      fprintf(stderr, "[DB_HANDLER] Failed to create directory: %s (errno: %d)\n", path, errno);
+      LOG_ERROR("mkdir failed: %m");
+      LOG_ERROR("Failed to create directory: %s (errno: %d)", path, errno);
       return -1;
     }
   }
 }
 
-void init_db_files() {
+void init_db(const char *engine_name, int max_batch) {
   if (create_directory_if_not_exists(DATA_DIR_PATH) != 0) {
-    fprintf(stderr, "[DB_HANDLER] Critical: Could not ensure data directory %s exists. Exiting.\n", DATA_DIR_PATH);
+    LOG_ERROR("Critical: Could not ensure data directory %s exists. Exiting.", DATA_DIR_PATH);
     exit(EXIT_FAILURE);
   }
 
-  // 사용자 파일 생성/확인 (O_CREAT으로 없으면 생성)
-  pthread_mutex_lock(&users_file_mutex);
-  int fd_users = open(USERS_FILE_PATH, O_WRONLY | O_CREAT | O_APPEND, 0644);
-  if (fd_users == -1) {
-    perror("[DB_HANDLER] Failed to open/create users.txt");
-  } else {
-    close(fd_users);
-  }
-  pthread_mutex_unlock(&users_file_mutex);
-
-  // 점수 파일 생성/확인
-  pthread_mutex_lock(&scores_file_mutex);
-  int fd_scores = open(SCORES_FILE_PATH, O_WRONLY | O_CREAT | O_APPEND, 0644);
-  if (fd_scores == -1) {
-    perror("[DB_HANDLER] Failed to open/create scores.txt");
-  } else {
-    close(fd_scores);
-  }
-  pthread_mutex_unlock(&scores_file_mutex);
-
-  printf("[DB_HANDLER] Checked/Initialized data files: %s, %s\n", USERS_FILE_PATH, SCORES_FILE_PATH);
-}
-
-int find_user_in_file(const char *username, UserData *found_user) {
-  pthread_mutex_lock(&users_file_mutex);
-
-  int fd = open(USERS_FILE_PATH, O_RDONLY);
-  if (fd == -1) {
-    pthread_mutex_unlock(&users_file_mutex);
-    if (errno == ENOENT) {
-      return 0;  // 파일이 없음 = 사용자 없음
-    }
-    return -1;  // 다른 에러
+  if (engine_name == NULL) {
+    engine_name = DEFAULT_ENGINE;
   }
-
-  // 파일 락 적용
-  if (flock(fd, LOCK_SH) == -1) {
-    perror("[DB_HANDLER] Failed to acquire shared lock on users file");
-    close(fd);
-    pthread_mutex_unlock(&users_file_mutex);
-    return -1;
+  const StorageEngine *selected = storage_engine_find(engine_name);
+  if (selected == NULL) {
+    LOG_ERROR("Critical: Unknown storage engine '%s' (expected text or log). Exiting.", engine_name);
+    exit(EXIT_FAILURE);
   }
 
-  UserData current_user;
-  int found = 0;
-  char line_buffer[MAX_ID_LEN + MAX_PW_LEN + 3];  // username:password\n\0
-  ssize_t line_length;
-
-  while ((line_length = read_line(fd, line_buffer, sizeof(line_buffer))) > 0) {
-    // username:password 형태 파싱
-    char *colon_pos = strchr(line_buffer, ':');
-    if (colon_pos == NULL) {
-      continue;  // 잘못된 형식의 줄은 건너뛰기
-    }
-
-    *colon_pos = '\0';  // username 부분 분리
-    char *password_part = colon_pos + 1;
-
-    // 길이 체크 및 복사
-    if (strlen(line_buffer) < MAX_ID_LEN && strlen(password_part) < MAX_PW_LEN) {
-      strncpy(current_user.username, line_buffer, MAX_ID_LEN - 1);
-      current_user.username[MAX_ID_LEN - 1] = '\0';
-      strncpy(current_user.password, password_part, MAX_PW_LEN - 1);
-      current_user.password[MAX_PW_LEN - 1] = '\0';
-
-      if (strcmp(current_user.username, username) == 0) {
-        if (found_user != NULL) {
-          *found_user = current_user;
-        }
-        found = 1;
-        break;
-      }
-    }
+  void *state = selected->open(DATA_DIR_PATH, max_batch);
+  if (state == NULL) {
+    LOG_ERROR("Critical: Could not open %s storage in %s. Exiting.", selected->name, DATA_DIR_PATH);
+    exit(EXIT_FAILURE);
   }
-
-  flock(fd, LOCK_UN);  // 락 해제
-  close(fd);
-  pthread_mutex_unlock(&users_file_mutex);
-  return found;
+  engine = selected;
+  engine_state = state;
+  LOG_INFO("Using %s storage engine.", engine->name);
 }
 
-int add_user_to_file(const UserData *user) {
-  pthread_mutex_lock(&users_file_mutex);
-
-  int fd = open(USERS_FILE_PATH, O_WRONLY | O_CREAT | O_APPEND, 0644);
-  if (fd == -1) {
-    perror("[DB_HANDLER] add_user_to_file: open users.txt");
-    pthread_mutex_unlock(&users_file_mutex);
-    return 0;
-  }
-
-  // 파일 락 적용 (배타적 락)
-  if (flock(fd, LOCK_EX) == -1) {
-    perror("[DB_HANDLER] Failed to acquire exclusive lock on users file");
-    close(fd);
-    pthread_mutex_unlock(&users_file_mutex);
-    return 0;
-  }
-
-  int bytes_written = dprintf(fd, "%s:%s\n", user->username, user->password);
-  if (bytes_written <= 0) {
-    perror("[DB_HANDLER] add_user_to_file: write users.txt");
-    flock(fd, LOCK_UN);
-    close(fd);
-    pthread_mutex_unlock(&users_file_mutex);
-    return 0;
-  }
-
-  // 즉시 디스크에 쓰기 (안전성 향상)
-  if (fsync(fd) != 0) {
-    perror("[DB_HANDLER] add_user_to_file: fsync users.txt");
-  }
-
-  flock(fd, LOCK_UN);  // 락 해제
-  if (close(fd) != 0) {
-    perror("[DB_HANDLER] add_user_to_file: close users.txt");
-    pthread_mutex_unlock(&users_file_mutex);
-    return 0;
+void close_db(void) {
+  if (engine != NULL) {
+    engine->close(engine_state);
+    engine = NULL;
+    engine_state = NULL;
   }
-
-  pthread_mutex_unlock(&users_file_mutex);
-  return 1;
 }
 
-int add_score_to_file(const char *username, int score) {
-  pthread_mutex_lock(&scores_file_mutex);
-
-  int fd = open(SCORES_FILE_PATH, O_WRONLY | O_CREAT | O_APPEND, 0644);
-  if (fd == -1) {
-    perror("[DB_HANDLER] add_score_to_file: open scores.txt");
-    pthread_mutex_unlock(&scores_file_mutex);
-    return 0;
-  }
-
-  // 파일 락 적용 (배타적 락)
-  if (flock(fd, LOCK_EX) == -1) {
-    perror("[DB_HANDLER] Failed to acquire exclusive lock on scores file");
-    close(fd);
-    pthread_mutex_unlock(&scores_file_mutex);
-    return 0;
-  }
-
-  int bytes_written = dprintf(fd, "%s:%d\n", username, score);
-  if (bytes_written <= 0) {
-    perror("[DB_HANDLER] add_score_to_file: write scores.txt");
-    flock(fd, LOCK_UN);
-    close(fd);
-    pthread_mutex_unlock(&scores_file_mutex);
-    return 0;
-  }
-
-  // 즉시 디스크에 쓰기 (안전성 향상)
-  if (fsync(fd) != 0) {
-    perror("[DB_HANDLER] add_score_to_file: fsync scores.txt");
-  }
+const char *db_engine_name(void) { return engine ? engine->name : "none"; }
 
-  flock(fd, LOCK_UN);  // 락 해제
-  if (close(fd) != 0) {
-    perror("[DB_HANDLER] add_score_to_file: close scores.txt");
-    pthread_mutex_unlock(&scores_file_mutex);
-    return 0;
+int db_find_user(const char *username, UserData *found_user) {
+  if (engine == NULL) {
+    return -1;  // 저장소가 초기화되지 않음
   }
-
-  pthread_mutex_unlock(&scores_file_mutex);
-  return 1;
+  return engine->find_user(engine_state, username, found_user);
 }
 
-int load_all_scores_from_file(ScoreRecord scores[], int max_records) {
-  pthread_mutex_lock(&scores_file_mutex);
-
-  int fd = open(SCORES_FILE_PATH, O_RDONLY);
-  if (fd == -1) {
-    pthread_mutex_unlock(&scores_file_mutex);
-    if (errno == ENOENT) {
-      return 0;  // 파일이 없음 = 점수 없음
-    }
-    return -1;  // 다른 에러
-  }
-
-  // 파일 락 적용 (공유 락)
-  if (flock(fd, LOCK_SH) == -1) {
-    perror("[DB_HANDLER] Failed to acquire shared lock on scores file");
-    close(fd);
-    pthread_mutex_unlock(&scores_file_mutex);
-    return -1;
-  }
+int db_add_user(const UserData *user) { return engine ? engine->add_user(engine_state, user) : 0; }
 
-  int count = 0;
-  char line_buffer[MAX_ID_LEN + 16];  // username:score\n\0
-  ssize_t line_length;
-
-  while (count < max_records && (line_length = read_line(fd, line_buffer, sizeof(line_buffer))) > 0) {
-    // username:score 형태 파싱
-    char *colon_pos = strchr(line_buffer, ':');
-    if (colon_pos == NULL) {
-      continue;  // 잘못된 형식의 줄은 건너뛰기
-    }
+int db_append_scores(const ScoreRecord records[], int count, DbSyncMode sync_mode) {
+  return engine ? engine->append_scores(engine_state, records, count, sync_mode) : 0;
+}
 
-    *colon_pos = '\0';  // username 부분 분리
-    char *score_part = colon_pos + 1;
+int db_for_each_score(uint64_t start_offset, ScoreVisitor visitor, void *ctx, uint64_t *end_offset) {
+  return engine ? engine->for_each_score(engine_state, start_offset, visitor, ctx, end_offset) : -1;
+}
 
-    // 사용자명 길이 체크 및 복사
-    if (strlen(line_buffer) < MAX_ID_LEN) {
-      strncpy(scores[count].username, line_buffer, MAX_ID_LEN - 1);
-      scores[count].username[MAX_ID_LEN - 1] = '\0';
+int db_score_log_size(uint64_t *size) { return engine ? engine->score_log_size(engine_state, size) : -1; }
 
-      // 점수 파싱
-      char *endptr;
-      long score_value = strtol(score_part, &endptr, 10);
-      if (endptr != score_part && *endptr == '\0') {  // 성공적으로 파싱됨
-        scores[count].score = (int)score_value;
-        count++;
-      }
-    }
-  }
-
-  flock(fd, LOCK_UN);  // 락 해제
-  close(fd);
-  pthread_mutex_unlock(&scores_file_mutex);
-  return count;
-}
\ No newline at end of file
+int db_score_log_fingerprint(uint64_t offset, uint64_t *fingerprint) {
+  return engine ? engine->score_log_fingerprint(engine_state, offset, fingerprint) : -1;
+}
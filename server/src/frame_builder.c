@@ -0,0 +1,67 @@
+// server/src/frame_builder.c
+#include "frame_builder.h"
+
+#include <string.h>
+
+#include "wire_codec.h"
+
+/* header_size 바이트 뒤에 msg 를 인코딩한 버퍼 (헤더 자리는 비워 둠), *body_len 에 바디 길이 */
+static SharedBuffer* encode_after(size_t header_size, int wire_version, uint32_t type, const void* msg, size_t msg_len, size_t* body_len) {
+  // 인코딩 결과는 구조체보다 크지 않음 (문자열 길이 바이트가 NUL 자리를 대신함)
+  // 구조체 크기로 잡고 실제 길이로 줄임
+  SharedBuffer* buf = shared_buffer_create(header_size + msg_len);
+  if (!buf) {
+    return NULL;
+  }
+  uint8_t* body = (uint8_t*)buf->data + header_size;
+
+  long len;
+  if (wire_version == WIRE_VERSION_LEGACY) {
+    if (msg && msg_len > 0) memcpy(body, msg, msg_len);
+    len = (long)msg_len;
+  } else {
+    len = wire_encode_body(type, msg, msg_len, body, msg_len);
+    if (len < 0) {
+      shared_buffer_unref(buf);
+      return NULL;
+    }
+  }
+  buf->len = header_size + (size_t)len;
+  *body_len = (size_t)len;
+  return buf;
+}
+
+SharedBuffer* frame_builder_alloc(int wire_version, uint32_t type, uint32_t request_id, size_t body_len, uint8_t** body) {
+  size_t header_size = wire_frame_header_size(wire_version);
+  SharedBuffer* frame = shared_buffer_create(header_size + body_len);
+  if (!frame) {
+    return NULL;
+  }
+  wire_encode_frame_header(wire_version, (uint8_t*)frame->data, type, request_id, (uint32_t)body_len);
+  *body = (uint8_t*)frame->data + header_size;
+  return frame;
+}
+
+SharedBuffer* frame_builder_encode(int wire_version, uint32_t type, uint32_t request_id, const void* msg, size_t msg_len) {
+  size_t header_size = wire_frame_header_size(wire_version);
+  size_t body_len;
+  SharedBuffer* frame = encode_after(header_size, wire_version, type, msg, msg_len, &body_len);
+  if (frame) {
+    wire_encode_frame_header(wire_version, (uint8_t*)frame->data, type, request_id, (uint32_t)body_len);
+  }
+  return frame;
+}
+
+SharedBuffer* frame_builder_encode_body(int wire_version, uint32_t type, const void* msg, size_t msg_len) {
+  size_t body_len;
+  return encode_after(0, wire_version, type, msg, msg_len, &body_len);
+}
+
+SharedBuffer* frame_builder_header(int wire_version, uint32_t type, uint32_t request_id, size_t body_len) {
+  size_t header_size = wire_frame_header_size(wire_version);
+  SharedBuffer* header = shared_buffer_create(header_size);
+  if (header) {
+    wire_encode_frame_header(wire_version, (uint8_t*)header->data, type, request_id, (uint32_t)body_len);
+  }
+  return header;
+}
@@ -0,0 +1,60 @@
+// server/src/leaderboard_cache.c
+#include "leaderboard_cache.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "frame_builder.h"
+#include "protocol.h"
+#include "score_manager.h"
+
+/*
+ * 바디 인코딩은 두 가지 (레거시 구조체 / 버전 1 이상 필드 직렬화) 이므로 각각 하나씩 보관
+ * 헤더는 요청 ID 가 요청마다 달라 캐시하지 않음
+ */
+#define BODY_ENCODINGS 2
+
+static SharedBuffer* cached_bodies[BODY_ENCODINGS] = {NULL};
+static unsigned long cached_versions[BODY_ENCODINGS] = {0};
+static pthread_mutex_t cache_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+// 현재 리더보드로 바디를 한 번 인코딩
+static SharedBuffer* build_leaderboard_body(int wire_version) {
+  LeaderboardResponse resp_data;
+  memset(&resp_data, 0, sizeof(resp_data));
+  get_leaderboard_impl(resp_data.entries, &resp_data.count, MAX_LEADERBOARD_ENTRIES);
+
+  return frame_builder_encode_body(wire_version, MSG_TYPE_LEADERBOARD_RESP, &resp_data, sizeof(LeaderboardResponse));
+}
+
+SharedBuffer* leaderboard_cache_get_body(int wire_version) {
+  int slot = (wire_version == WIRE_VERSION_LEGACY) ? 0 : 1;
+  pthread_mutex_lock(&cache_mutex);
+
+  unsigned long version = get_leaderboard_version();
+  if (cached_bodies[slot] == NULL || cached_versions[slot] != version) {
+    SharedBuffer* fresh = build_leaderboard_body(wire_version);
+    if (fresh) {
+      shared_buffer_unref(cached_bodies[slot]);
+      cached_bodies[slot] = fresh;
+      cached_versions[slot] = version;
+    } else if (cached_bodies[slot] == NULL) {
+      pthread_mutex_unlock(&cache_mutex);
+      return NULL;
+    }
+  }
+
+  SharedBuffer* result = shared_buffer_ref(cached_bodies[slot]);
+  pthread_mutex_unlock(&cache_mutex);
+  return result;
+}
+
+void leaderboard_cache_cleanup(void) {
+  pthread_mutex_lock(&cache_mutex);
+  for (int i = 0; i < BODY_ENCODINGS; i++) {
+    shared_buffer_unref(cached_bodies[i]);
+    cached_bodies[i] = NULL;
+  }
+  pthread_mutex_unlock(&cache_mutex);
+}
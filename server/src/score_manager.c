@@ -1,93 +1,508 @@
 // server/src/score_manager.c
 #include "score_manager.h"
 
+#include <errno.h>
+#include <pthread.h>
+#include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 
 #include "db_handler.h"
+#include "hash_util.h"
+#include "score_snapshot.h"
+#include "score_wal.h"
+#include "server_log.h"
+#include "server_metrics.h"
 
-void init_score_system() { printf("[SCORE_MANAGER] Score system initialized (using file DB).\n"); }
+#define LOG_MODULE "SCORE_MANAGER"
 
-int submit_score_impl(const char* username, int score, char* response_msg) {
-  if (username == NULL || strlen(username) == 0) {
-    snprintf(response_msg, MAX_MSG_LEN, "Cannot submit score for an anonymous user.");
-    response_msg[MAX_MSG_LEN - 1] = '\0';
-    return 0;
+/*
+ * 사용자별 최고 점수 맵 (open addressing + linear probing)
+ * - 시작 시 압축 스냅샷 + 그 이후의 점수 로그 꼬리로 구성 (스냅샷이 없으면 로그 전체), 이후 제출마다 갱신
+ */
+#define BEST_MAP_INITIAL_CAPACITY 1024 /* 2의 거듭제곱 */
+#define BEST_MAP_MAX_LOAD_PERCENT 70
+
+typedef struct {
+  char username[MAX_ID_LEN]; /* '\0' 이면 빈 슬롯 */
+  int best;
+  uint32_t games; /* 기록된 판 수 */
+  int64_t total;  /* 점수 합계 */
+} BestScoreSlot;
+
+typedef struct {
+  BestScoreSlot* slots;
+  size_t capacity;
+  size_t count;
+} BestScoreMap;
+
+/*
+ * 상위 K 명 (최고 점수 내림차순)
+ * 사용자의 최고 점수는 오르기만 하므로 제출 하나당 O(K) 로 정확히 유지 가능
+ */
+typedef struct {
+  LeaderboardEntry entries[MAX_LEADERBOARD_ENTRIES];
+  int count;
+} TopScores;
+
+static BestScoreMap best_scores = {0};
+static TopScores top_scores = {0};
+static uint64_t total_games = 0;              /* 반영된 전체 판 수 */
+static unsigned long leaderboard_version = 0; /* 상위 K 가 바뀔 때마다 증가 */
+static pthread_rwlock_t score_state_lock = PTHREAD_RWLOCK_INITIALIZER;
+
+/* 압축 스냅샷 (빈 문자열이면 사용 안 함) */
+static char snapshot_path[256] = "";
+static uint64_t snapshot_games = 0; /* 마지막 스냅샷에 반영된 판 수 */
+
+/* 주기적 압축 스레드 */
+static pthread_t compaction_thread;
+static bool compaction_running = false;
+static int compaction_interval_sec = 0;
+static pthread_mutex_t compaction_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t compaction_wake = PTHREAD_COND_INITIALIZER;
+
+// username 이 있는 슬롯, 없으면 삽입할 빈 슬롯 위치 반환
+static size_t best_map_probe(const BestScoreMap* map, const char* username) {
+  size_t mask = map->capacity - 1;
+  size_t pos = hash_string_fnv1a(username) & mask;
+  while (map->slots[pos].username[0] != '\0' && strcmp(map->slots[pos].username, username) != 0) {
+    pos = (pos + 1) & mask;
+  }
+  return pos;
+}
+
+static int best_map_resize(BestScoreMap* map, size_t new_capacity) {
+  BestScoreSlot* new_slots = calloc(new_capacity, sizeof(BestScoreSlot));
+  if (!new_slots) {
+    LOG_ERROR("calloc for best score map failed: %m");
+    return -1;
   }
 
-  if (add_score_to_file(username, score)) {
-    snprintf(response_msg, MAX_MSG_LEN, "Score %d submitted successfully for '%s'.", score, username);
-    response_msg[MAX_MSG_LEN - 1] = '\0';
-    return 1;
+  BestScoreMap grown = {new_slots, new_capacity, 0};
+  for (size_t i = 0; i < map->capacity; i++) {
+    if (map->slots[i].username[0] != '\0') {
+      grown.slots[best_map_probe(&grown, map->slots[i].username)] = map->slots[i];
+      grown.count++;
+    }
+  }
+
+  free(map->slots);
+  *map = grown;
+  return 0;
+}
+
+// 사용자의 점수 반영 후 상위 K 갱신 위치 이동, 상위 K 가 바뀌면 true
+static bool top_scores_update(TopScores* top, const char* username, int score) {
+  int pos = -1;
+  for (int i = 0; i < top->count; i++) {
+    if (strcmp(top->entries[i].username, username) == 0) {
+      pos = i;
+      break;
+    }
+  }
+
+  if (pos == -1) {
+    if (top->count < MAX_LEADERBOARD_ENTRIES) {
+      pos = top->count++;
+    } else if (score > top->entries[MAX_LEADERBOARD_ENTRIES - 1].score) {
+      pos = MAX_LEADERBOARD_ENTRIES - 1;  // 최하위를 밀어냄
+    } else {
+      return false;
+    }
+    snprintf(top->entries[pos].username, MAX_ID_LEN, "%s", username);
+  }
+  top->entries[pos].score = score;
+
+  // 점수가 같으면 먼저 도달한 사용자가 위에 남음
+  while (pos > 0 && top->entries[pos - 1].score < top->entries[pos].score) {
+    LeaderboardEntry tmp = top->entries[pos - 1];
+    top->entries[pos - 1] = top->entries[pos];
+    top->entries[pos] = tmp;
+    pos--;
+  }
+  return true;
+}
+
+/*
+ * 점수 하나를 메모리 상태에 반영 (score_state_lock 쓰기 락 보유 상태에서 호출)
+ * 반환값: 0 성공, -1 메모리 부족
+ */
+static int apply_score_locked(const char* username, int score) {
+  if (best_scores.slots == NULL || (best_scores.count + 1) * 100 > best_scores.capacity * BEST_MAP_MAX_LOAD_PERCENT) {
+    size_t new_capacity = best_scores.capacity ? best_scores.capacity * 2 : BEST_MAP_INITIAL_CAPACITY;
+    if (best_map_resize(&best_scores, new_capacity) != 0) {
+      return -1;
+    }
+  }
+
+  BestScoreSlot* slot = &best_scores.slots[best_map_probe(&best_scores, username)];
+  total_games++;
+  if (slot->username[0] == '\0') {
+    snprintf(slot->username, MAX_ID_LEN, "%s", username);
+    slot->best = score;
+    slot->games = 1;
+    slot->total = score;
+    best_scores.count++;
   } else {
-    snprintf(response_msg, MAX_MSG_LEN, "Failed to save score for '%s'.", username);
-    response_msg[MAX_MSG_LEN - 1] = '\0';
-    return 0;
+    slot->games++;
+    slot->total += score;
+    if (score <= slot->best) {
+      return 0;  // 최고 점수 변화 없음
+    }
+    slot->best = score;
+  }
+
+  if (top_scores_update(&top_scores, username, slot->best)) {
+    __atomic_add_fetch(&leaderboard_version, 1, __ATOMIC_RELEASE);
   }
+  return 0;
 }
 
-static int compare_score_records_for_user_best(const void* a, const void* b) {
-  ScoreRecord* recordA = (ScoreRecord*)a;
-  ScoreRecord* recordB = (ScoreRecord*)b;
+static void load_score_visitor(const char* username, int score, void* ctx) {
+  int* failed = (int*)ctx;
+  if (apply_score_locked(username, score) != 0) {
+    *failed = 1;
+  }
+}
 
-  int user_cmp = strcmp(recordA->username, recordB->username);
-  if (user_cmp != 0) {
-    return user_cmp;
+// 메모리 상태 비우기 (score_state_lock 쓰기 락 보유 상태에서 호출)
+static void reset_score_state_locked(void) {
+  free(best_scores.slots);
+  memset(&best_scores, 0, sizeof(best_scores));
+  memset(&top_scores, 0, sizeof(top_scores));
+  total_games = 0;
+}
+
+/*
+ * 스냅샷 항목으로 빈 메모리 상태 구성 (score_state_lock 쓰기 락 보유 상태에서 호출)
+ * 항목은 리더보드 상위부터 최고 점수 내림차순이므로 앞의 K 개가 그대로 상위 K
+ * 반환값: 0 성공, -1 메모리 부족
+ */
+static int load_snapshot_locked(const ScoreSnapshot* snap) {
+  size_t capacity = BEST_MAP_INITIAL_CAPACITY;
+  while (((size_t)snap->info.player_count + 1) * 100 > capacity * BEST_MAP_MAX_LOAD_PERCENT) {
+    capacity *= 2;
+  }
+  if (best_map_resize(&best_scores, capacity) != 0) {
+    return -1;
   }
-  if (recordB->score > recordA->score) return 1;
-  if (recordB->score < recordA->score) return -1;
+
+  ScoreSnapshotEntry entry;
+  for (uint32_t i = 0; i < snap->info.player_count; i++) {
+    score_snapshot_entry(snap, i, &entry);
+    if (entry.username[0] == '\0') {
+      continue;
+    }
+
+    BestScoreSlot* slot = &best_scores.slots[best_map_probe(&best_scores, entry.username)];
+    if (slot->username[0] == '\0') {
+      best_scores.count++;
+    }
+    memcpy(slot->username, entry.username, MAX_ID_LEN);
+    slot->best = entry.best;
+    slot->games = entry.games;
+    slot->total = entry.total;
+
+    if (top_scores.count < MAX_LEADERBOARD_ENTRIES) {
+      memcpy(top_scores.entries[top_scores.count].username, entry.username, MAX_ID_LEN);
+      top_scores.entries[top_scores.count].score = entry.best;
+      top_scores.count++;
+    }
+  }
+  total_games = snap->info.total_games;
   return 0;
 }
 
-static int compare_leaderboard_entries_final(const void* a, const void* b) {
-  LeaderboardEntry* entryA = (LeaderboardEntry*)a;
-  LeaderboardEntry* entryB = (LeaderboardEntry*)b;
-  if (entryB->score > entryA->score) return 1;
-  if (entryB->score < entryA->score) return -1;
+// 스냅샷이 유효하고 지금의 점수 로그와 이어지면 적재, 반환값: 꼬리 재생을 시작할 로그 위치 (적재하지 못했으면 0)
+static uint64_t load_snapshot_if_valid(void) {
+  ScoreSnapshot snap;
+  if (snapshot_path[0] == '\0' || score_snapshot_open(snapshot_path, &snap) != 0) {
+    return 0;
+  }
+
+  uint64_t replay_from = 0;
+  uint64_t fingerprint;
+  if (db_score_log_fingerprint(snap.info.log_offset, &fingerprint) != 0 || fingerprint != snap.info.log_fingerprint) {
+    LOG_WARN("Snapshot %s does not match the current score log; replaying the full log.", snapshot_path);
+  } else if (load_snapshot_locked(&snap) != 0) {
+    LOG_WARN("Failed to load snapshot %s; replaying the full log.", snapshot_path);
+    reset_score_state_locked();
+  } else {
+    replay_from = snap.info.log_offset;
+    snapshot_games = snap.info.total_games;
+  }
+
+  score_snapshot_close(&snap);
+  return replay_from;
+}
+
+void init_score_system(const char* snapshot) {
+  uint64_t start = metrics_now_ns();
+  snprintf(snapshot_path, sizeof(snapshot_path), "%s", snapshot ? snapshot : "");
+
+  pthread_rwlock_wrlock(&score_state_lock);
+  int failed = 0;
+  uint64_t replay_from = load_snapshot_if_valid();
+  int replayed = db_for_each_score(replay_from, load_score_visitor, &failed, NULL);
+  if (replayed < 0 && replay_from > 0) {
+    // 검증 뒤에 로그가 잘린 경우: 스냅샷을 버리고 처음부터
+    reset_score_state_locked();
+    snapshot_games = 0;
+    failed = 0;
+    replay_from = 0;
+    replayed = db_for_each_score(0, load_score_visitor, &failed, NULL);
+  }
+  if (best_scores.slots == NULL && best_map_resize(&best_scores, BEST_MAP_INITIAL_CAPACITY) != 0) {
+    failed = 1;
+  }
+  size_t players = best_scores.count;
+  uint64_t games = total_games;
+  pthread_rwlock_unlock(&score_state_lock);
+
+  if (replayed < 0 || failed) {
+    LOG_WARN("Failed to load scores from %s storage; leaderboard may be incomplete.", db_engine_name());
+    return;
+  }
+  double elapsed_ms = (metrics_now_ns() - start) / 1e6;
+  if (replay_from > 0) {
+    LOG_INFO("Score system initialized from snapshot %s + %d log record(s): %llu scores, %zu players (%.1f ms).", snapshot_path,
+             replayed, (unsigned long long)games, players, elapsed_ms);
+  } else {
+    LOG_INFO("Score system initialized (using %s storage): %d scores, %zu players (%.1f ms).", db_engine_name(), replayed, players,
+             elapsed_ms);
+  }
+}
+
+/* 배치 경계에서 복사한 메모리 상태 */
+typedef struct {
+  ScoreSnapshotInfo info;
+  ScoreSnapshotEntry* entries;
+  int failed;
+} SnapshotCapture;
+
+static void copy_slot_to_entry(ScoreSnapshotEntry* entry, const BestScoreSlot* slot) {
+  memcpy(entry->username, slot->username, MAX_ID_LEN);
+  entry->best = slot->best;
+  entry->games = slot->games;
+  entry->total = slot->total;
+}
+
+// score_wal_checkpoint 에서 호출: 메모리 상태와 그 상태가 반영한 로그 위치를 함께 복사
+static void capture_snapshot(void* arg) {
+  SnapshotCapture* capture = (SnapshotCapture*)arg;
+
+  pthread_rwlock_rdlock(&score_state_lock);
+  capture->entries = malloc(sizeof(ScoreSnapshotEntry) * (best_scores.count ? best_scores.count : 1));
+  if (!capture->entries || db_score_log_size(&capture->info.log_offset) != 0 ||
+      db_score_log_fingerprint(capture->info.log_offset, &capture->info.log_fingerprint) != 0) {
+    pthread_rwlock_unlock(&score_state_lock);
+    capture->failed = 1;
+    return;
+  }
+
+  // 리더보드 상위를 그 순서대로 먼저, 나머지는 score_snapshot_write 가 정렬
+  size_t top_slots[MAX_LEADERBOARD_ENTRIES];
+  uint32_t n = 0;
+  for (int i = 0; i < top_scores.count; i++) {
+    top_slots[i] = best_map_probe(&best_scores, top_scores.entries[i].username);
+    copy_slot_to_entry(&capture->entries[n++], &best_scores.slots[top_slots[i]]);
+  }
+  for (size_t pos = 0; pos < best_scores.capacity; pos++) {
+    if (best_scores.slots[pos].username[0] == '\0') {
+      continue;
+    }
+    bool is_top = false;
+    for (int i = 0; i < top_scores.count && !is_top; i++) {
+      is_top = (top_slots[i] == pos);
+    }
+    if (!is_top) {
+      copy_slot_to_entry(&capture->entries[n++], &best_scores.slots[pos]);
+    }
+  }
+
+  capture->info.player_count = n;
+  capture->info.top_count = (uint32_t)top_scores.count;
+  capture->info.total_games = total_games;
+  pthread_rwlock_unlock(&score_state_lock);
+}
+
+static uint64_t current_total_games(void) {
+  pthread_rwlock_rdlock(&score_state_lock);
+  uint64_t games = total_games;
+  pthread_rwlock_unlock(&score_state_lock);
+  return games;
+}
+
+// 마지막 스냅샷 이후 반영된 점수가 있으면 새 스냅샷 기록
+static void compact_scores(void) {
+  if (current_total_games() == snapshot_games) {
+    return;
+  }
+
+  SnapshotCapture capture = {0};
+  uint64_t start = metrics_now_ns();
+  score_wal_checkpoint(capture_snapshot, &capture);  // 복사하는 동안만 점수 기록이 멈춤
+  uint64_t captured = metrics_now_ns();
+
+  if (capture.failed) {
+    LOG_ERROR("Failed to capture score state for snapshot %s.", snapshot_path);
+  } else if (score_snapshot_write(snapshot_path, &capture.info, capture.entries) == 0) {
+    snapshot_games = capture.info.total_games;
+    LOG_INFO("Wrote snapshot %s: %u players, %llu scores up to log offset %llu (%.1f ms, writer paused %.1f ms).", snapshot_path,
+             capture.info.player_count, (unsigned long long)capture.info.total_games, (unsigned long long)capture.info.log_offset,
+             (metrics_now_ns() - start) / 1e6, (captured - start) / 1e6);
+  }
+  free(capture.entries);
+}
+
+static void* compaction_thread_func(void* arg) {
+  (void)arg;
+  pthread_mutex_lock(&compaction_mutex);
+  while (compaction_running) {
+    pthread_mutex_unlock(&compaction_mutex);
+    compact_scores();  // 시작 직후에도 한 번 (재생한 로그 꼬리를 바로 접어 둠)
+    pthread_mutex_lock(&compaction_mutex);
+
+    struct timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_sec += compaction_interval_sec;
+    while (compaction_running && pthread_cond_timedwait(&compaction_wake, &compaction_mutex, &deadline) != ETIMEDOUT) {
+    }
+  }
+  pthread_mutex_unlock(&compaction_mutex);
+  return NULL;
+}
+
+int start_score_compaction(int interval_sec) {
+  if (snapshot_path[0] == '\0') {
+    return -1;
+  }
+  compaction_interval_sec = interval_sec > 0 ? interval_sec : 1;
+  compaction_running = true;
+
+  if (pthread_create(&compaction_thread, NULL, compaction_thread_func, NULL) != 0) {
+    LOG_ERROR("pthread_create() error: %m");
+    compaction_running = false;
+    return -1;
+  }
+  LOG_INFO("Compacting scores into %s every %d second(s).", snapshot_path, compaction_interval_sec);
   return 0;
 }
 
-void get_leaderboard_impl(LeaderboardEntry* final_leaderboard_entries, int* final_count, int max_final_entries) {
-  ScoreRecord all_scores[MAX_TOTAL_SCORES];
-  int num_scores_loaded = load_all_scores_from_file(all_scores, MAX_TOTAL_SCORES);
+void stop_score_compaction(void) {
+  pthread_mutex_lock(&compaction_mutex);
+  bool was_running = compaction_running;
+  compaction_running = false;
+  pthread_cond_signal(&compaction_wake);
+  pthread_mutex_unlock(&compaction_mutex);
 
-  *final_count = 0;
+  if (was_running) {
+    pthread_join(compaction_thread, NULL);
+  }
+  if (snapshot_path[0] != '\0') {
+    compact_scores();  // 다음 시작 때 재생할 꼬리가 없도록
+  }
+}
+
+/* WAL 기록 완료를 기다리는 제출 하나 */
+typedef struct {
+  char username[MAX_ID_LEN];
+  int score;
+  ScoreSubmitCallback on_done;
+  void* ctx;
+} PendingSubmit;
 
-  if (num_scores_loaded <= 0) {
-    if (num_scores_loaded == -1) *final_count = -1;
+// WAL 기록 스레드에서 호출: 기록된 점수만 리더보드에 반영
+static void on_score_committed(int success, void* arg) {
+  PendingSubmit* pending = (PendingSubmit*)arg;
+  char response_msg[MAX_MSG_LEN];
+
+  if (success) {
+    pthread_rwlock_wrlock(&score_state_lock);
+    if (apply_score_locked(pending->username, pending->score) != 0) {
+      LOG_ERROR("Failed to index score for '%s' (saved to file).", pending->username);
+    }
+    pthread_rwlock_unlock(&score_state_lock);
+
+    snprintf(response_msg, MAX_MSG_LEN, "Score %d submitted successfully for '%s'.", pending->score, pending->username);
+  } else {
+    snprintf(response_msg, MAX_MSG_LEN, "Failed to save score for '%s'.", pending->username);
+  }
+  response_msg[MAX_MSG_LEN - 1] = '\0';
+
+  pending->on_done(success, response_msg, pending->ctx);
+  free(pending);
+}
+
+void submit_score_async(const char* username, int score, ScoreSubmitCallback on_done, void* ctx) {
+  char response_msg[MAX_MSG_LEN];
+
+  if (username == NULL || strlen(username) == 0) {
+    snprintf(response_msg, MAX_MSG_LEN, "Cannot submit score for an anonymous user.");
+    response_msg[MAX_MSG_LEN - 1] = '\0';
+    on_done(0, response_msg, ctx);
     return;
   }
 
-  qsort(all_scores, num_scores_loaded, sizeof(ScoreRecord), compare_score_records_for_user_best);
-
-  char last_processed_user[MAX_ID_LEN] = {0};
-
-  for (int i = 0; i < num_scores_loaded; i++) {
-    if (strcmp(all_scores[i].username, last_processed_user) != 0) {
-      if (*final_count < max_final_entries) {
-        size_t copy_len = strlen(all_scores[i].username);
-        if (copy_len >= MAX_ID_LEN) {
-          copy_len = MAX_ID_LEN - 1;
-        }
-        memcpy(final_leaderboard_entries[*final_count].username, all_scores[i].username, copy_len);
-        final_leaderboard_entries[*final_count].username[copy_len] = '\0';
-        final_leaderboard_entries[*final_count].username[MAX_ID_LEN - 1] = '\0';
-        final_leaderboard_entries[*final_count].score = all_scores[i].score;
-        (*final_count)++;
-
-        copy_len = strlen(all_scores[i].username);
-        if (copy_len >= MAX_ID_LEN) {
-          copy_len = MAX_ID_LEN - 1;
-        }
-        memcpy(last_processed_user, all_scores[i].username, copy_len);
-        last_processed_user[copy_len] = '\0';
-        last_processed_user[MAX_ID_LEN - 1] = '\0';
-      }
+  PendingSubmit* pending = malloc(sizeof(PendingSubmit));
+  if (pending) {
+    snprintf(pending->username, MAX_ID_LEN, "%s", username);
+    pending->score = score;
+    pending->on_done = on_done;
+    pending->ctx = ctx;
+    if (score_wal_append(username, score, on_score_committed, pending) == 0) {
+      return;  // 결과는 배치 기록 후 on_done 으로 전달
     }
+    free(pending);
   }
 
-  if (*final_count > 0) {
-    qsort(final_leaderboard_entries, *final_count, sizeof(LeaderboardEntry), compare_leaderboard_entries_final);
+  snprintf(response_msg, MAX_MSG_LEN, "Failed to save score for '%s'.", username);
+  response_msg[MAX_MSG_LEN - 1] = '\0';
+  on_done(0, response_msg, ctx);
+}
+
+/* submit_score_impl 용 동기 대기 상태 */
+typedef struct {
+  pthread_mutex_t mutex;
+  pthread_cond_t cond;
+  bool done;
+  int success;
+  char* response_msg;
+} SyncSubmit;
+
+static void on_sync_submit_done(int success, const char* response_msg, void* arg) {
+  SyncSubmit* sync = (SyncSubmit*)arg;
+  pthread_mutex_lock(&sync->mutex);
+  snprintf(sync->response_msg, MAX_MSG_LEN, "%s", response_msg);
+  sync->success = success;
+  sync->done = true;
+  pthread_cond_signal(&sync->cond);
+  pthread_mutex_unlock(&sync->mutex);
+}
+
+int submit_score_impl(const char* username, int score, char* response_msg) {
+  SyncSubmit sync = {PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, false, 0, response_msg};
+
+  submit_score_async(username, score, on_sync_submit_done, &sync);
+
+  pthread_mutex_lock(&sync.mutex);
+  while (!sync.done) {
+    pthread_cond_wait(&sync.cond, &sync.mutex);
   }
-}
\ No newline at end of file
+  pthread_mutex_unlock(&sync.mutex);
+  return sync.success;
+}
+
+void get_leaderboard_impl(LeaderboardEntry* final_leaderboard_entries, int* final_count, int max_final_entries) {
+  pthread_rwlock_rdlock(&score_state_lock);
+  int count = top_scores.count < max_final_entries ? top_scores.count : max_final_entries;
+  memcpy(final_leaderboard_entries, top_scores.entries, sizeof(LeaderboardEntry) * count);
+  pthread_rwlock_unlock(&score_state_lock);
+
+  *final_count = count;
+}
+
+unsigned long get_leaderboard_version(void) { return __atomic_load_n(&leaderboard_version, __ATOMIC_ACQUIRE); }
@@ -0,0 +1,218 @@
+// server/src/score_snapshot.c
+#include "score_snapshot.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "hash_util.h"
+#include "server_log.h"
+#include "wire_codec.h"
+
+#define LOG_MODULE "SCORE_SNAPSHOT"
+
+#define SNAPSHOT_MAGIC "RSNP"
+#define SNAPSHOT_VERSION 1
+#define SNAPSHOT_HEADER_SIZE 64
+#define SNAPSHOT_ENTRY_SIZE 48
+#define SNAPSHOT_HEADER_CHECKSUM_OFFSET 56
+
+// 리더보드 상위가 아닌 항목의 순서: 최고 점수 내림차순, 같으면 사용자명 오름차순
+static int compare_entries(const void* a, const void* b) {
+  const ScoreSnapshotEntry* x = (const ScoreSnapshotEntry*)a;
+  const ScoreSnapshotEntry* y = (const ScoreSnapshotEntry*)b;
+  if (x->best != y->best) {
+    return x->best > y->best ? -1 : 1;
+  }
+  return strcmp(x->username, y->username);
+}
+
+static void encode_entry(uint8_t* p, const ScoreSnapshotEntry* entry) {
+  memset(p, 0, MAX_ID_LEN);
+  memcpy(p, entry->username, strnlen(entry->username, MAX_ID_LEN - 1));
+  wire_put_u32(p + 32, (uint32_t)entry->best);
+  wire_put_u32(p + 36, entry->games);
+  wire_put_u64(p + 40, (uint64_t)entry->total);
+}
+
+// path 가 들어 있는 디렉터리를 fsync (rename 결과를 디스크에 남김)
+static void sync_parent_dir(const char* path) {
+  char dir[256];
+  const char* slash = strrchr(path, '/');
+  if (slash == NULL) {
+    snprintf(dir, sizeof(dir), ".");
+  } else {
+    snprintf(dir, sizeof(dir), "%.*s", (int)(slash - path), path);
+  }
+
+  int fd = open(dir, O_RDONLY | O_DIRECTORY);
+  if (fd == -1) {
+    return;
+  }
+  if (fsync(fd) != 0) {
+    LOG_WARN("fsync(%s) failed: %m", dir);
+  }
+  close(fd);
+}
+
+int score_snapshot_write(const char* path, const ScoreSnapshotInfo* info, ScoreSnapshotEntry* entries) {
+  uint32_t rest = info->player_count - info->top_count;
+  if (rest > 1) {
+    qsort(entries + info->top_count, rest, sizeof(ScoreSnapshotEntry), compare_entries);
+  }
+
+  size_t size = SNAPSHOT_HEADER_SIZE + (size_t)info->player_count * SNAPSHOT_ENTRY_SIZE;
+  uint8_t* buffer = malloc(size);
+  if (!buffer) {
+    LOG_ERROR("malloc for snapshot buffer failed: %m");
+    return -1;
+  }
+
+  uint8_t* body = buffer + SNAPSHOT_HEADER_SIZE;
+  for (uint32_t i = 0; i < info->player_count; i++) {
+    encode_entry(body + (size_t)i * SNAPSHOT_ENTRY_SIZE, &entries[i]);
+  }
+
+  memset(buffer, 0, SNAPSHOT_HEADER_SIZE);
+  memcpy(buffer, SNAPSHOT_MAGIC, 4);
+  wire_put_u16(buffer + 4, SNAPSHOT_VERSION);
+  wire_put_u16(buffer + 6, SNAPSHOT_ENTRY_SIZE);
+  wire_put_u64(buffer + 8, info->log_offset);
+  wire_put_u64(buffer + 16, info->log_fingerprint);
+  wire_put_u64(buffer + 24, info->total_games);
+  wire_put_u32(buffer + 32, info->player_count);
+  wire_put_u32(buffer + 36, info->top_count);
+  wire_put_u64(buffer + 40, (uint64_t)time(NULL));
+  wire_put_u64(buffer + 48, hash_bytes_fnv1a(body, size - SNAPSHOT_HEADER_SIZE));
+  wire_put_u64(buffer + SNAPSHOT_HEADER_CHECKSUM_OFFSET, hash_bytes_fnv1a(buffer, SNAPSHOT_HEADER_CHECKSUM_OFFSET));
+
+  char tmp_path[256];
+  snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", path);
+
+  int fd = open(tmp_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd == -1) {
+    LOG_ERROR("Failed to create %s: %m", tmp_path);
+    free(buffer);
+    return -1;
+  }
+
+  int result = 0;
+  size_t written = 0;
+  while (written < size) {
+    ssize_t n = write(fd, buffer + written, size - written);
+    if (n < 0) {
+      if (errno == EINTR) continue;
+      LOG_ERROR("Failed to write %s: %m", tmp_path);
+      result = -1;
+      break;
+    }
+    written += n;
+  }
+  if (result == 0 && fsync(fd) != 0) {
+    LOG_ERROR("fsync(%s) failed: %m", tmp_path);
+    result = -1;
+  }
+  if (close(fd) != 0 && result == 0) {
+    LOG_ERROR("Failed to close %s: %m", tmp_path);
+    result = -1;
+  }
+  free(buffer);
+
+  if (result == 0 && rename(tmp_path, path) != 0) {
+    LOG_ERROR("Failed to rename %s to %s: %m", tmp_path, path);
+    result = -1;
+  }
+  if (result != 0) {
+    unlink(tmp_path);
+    return -1;
+  }
+
+  sync_parent_dir(path);
+  return 0;
+}
+
+int score_snapshot_open(const char* path, ScoreSnapshot* snap) {
+  memset(snap, 0, sizeof(*snap));
+
+  int fd = open(path, O_RDONLY);
+  if (fd == -1) {
+    if (errno == ENOENT) {
+      return 1;
+    }
+    LOG_WARN("Failed to open snapshot %s: %m", path);
+    return -1;
+  }
+
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    LOG_WARN("fstat(%s) failed: %m", path);
+    close(fd);
+    return -1;
+  }
+  if ((size_t)st.st_size < SNAPSHOT_HEADER_SIZE) {
+    LOG_WARN("Snapshot %s is truncated (%lld bytes).", path, (long long)st.st_size);
+    close(fd);
+    return -1;
+  }
+
+  void* map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);  // 매핑은 fd 를 닫아도 유지됨
+  if (map == MAP_FAILED) {
+    LOG_WARN("mmap(%s) failed: %m", path);
+    return -1;
+  }
+  madvise(map, st.st_size, MADV_SEQUENTIAL);
+
+  const uint8_t* header = (const uint8_t*)map;
+  const char* reason = NULL;
+  size_t body_size = (size_t)st.st_size - SNAPSHOT_HEADER_SIZE;
+
+  if (memcmp(header, SNAPSHOT_MAGIC, 4) != 0) {
+    reason = "bad magic";
+  } else if (wire_get_u16(header + 4) != SNAPSHOT_VERSION || wire_get_u16(header + 6) != SNAPSHOT_ENTRY_SIZE) {
+    reason = "unsupported version";
+  } else if (wire_get_u64(header + SNAPSHOT_HEADER_CHECKSUM_OFFSET) != hash_bytes_fnv1a(header, SNAPSHOT_HEADER_CHECKSUM_OFFSET)) {
+    reason = "header checksum mismatch";
+  } else if ((uint64_t)wire_get_u32(header + 32) * SNAPSHOT_ENTRY_SIZE != body_size || wire_get_u32(header + 36) > wire_get_u32(header + 32)) {
+    reason = "size does not match player count";
+  } else if (wire_get_u64(header + 48) != hash_bytes_fnv1a(header + SNAPSHOT_HEADER_SIZE, body_size)) {
+    reason = "entry checksum mismatch";
+  }
+  if (reason) {
+    LOG_WARN("Ignoring snapshot %s: %s.", path, reason);
+    munmap(map, st.st_size);
+    return -1;
+  }
+
+  snap->info.log_offset = wire_get_u64(header + 8);
+  snap->info.log_fingerprint = wire_get_u64(header + 16);
+  snap->info.total_games = wire_get_u64(header + 24);
+  snap->info.player_count = wire_get_u32(header + 32);
+  snap->info.top_count = wire_get_u32(header + 36);
+  snap->entries = header + SNAPSHOT_HEADER_SIZE;
+  snap->map = map;
+  snap->map_size = st.st_size;
+  return 0;
+}
+
+void score_snapshot_entry(const ScoreSnapshot* snap, uint32_t index, ScoreSnapshotEntry* out) {
+  const uint8_t* p = snap->entries + (size_t)index * SNAPSHOT_ENTRY_SIZE;
+  memcpy(out->username, p, MAX_ID_LEN - 1);
+  out->username[MAX_ID_LEN - 1] = '\0';
+  out->best = (int)wire_get_u32(p + 32);
+  out->games = wire_get_u32(p + 36);
+  out->total = (int64_t)wire_get_u64(p + 40);
+}
+
+void score_snapshot_close(ScoreSnapshot* snap) {
+  if (snap->map) {
+    munmap(snap->map, snap->map_size);
+  }
+  memset(snap, 0, sizeof(*snap));
+}
@@ -0,0 +1,208 @@
+// server/src/score_wal.c
+#include "score_wal.h"
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "server_log.h"
+
+#define LOG_MODULE "SCORE_WAL"
+
+typedef struct WalEntry {
+  ScoreRecord record;
+  WalCommitCallback on_commit;
+  void* ctx;
+  struct WalEntry* next;
+} WalEntry;
+
+/* 제출 스레드들이 쌓고 기록 스레드가 통째로 가져가는 대기열 */
+static WalEntry* pending_head = NULL;
+static WalEntry* pending_tail = NULL;
+
+static pthread_mutex_t wal_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t wal_has_work = PTHREAD_COND_INITIALIZER;
+static bool wal_running = false;
+static bool wal_thread_active = false; /* 기록 스레드가 아직 루프 안에 있음 (wal_running 이 꺼진 뒤에도 남은 배치 처리 중) */
+static pthread_t wal_thread;
+
+/* 배치 경계에서 실행할 체크포인트 요청 (한 번에 하나) */
+static WalCheckpointFn checkpoint_fn = NULL;
+static void* checkpoint_ctx = NULL;
+static pthread_cond_t checkpoint_done = PTHREAD_COND_INITIALIZER;
+
+static DbSyncMode wal_sync_mode = DB_SYNC_FSYNC;
+static int wal_max_batch = 1;
+
+/* 통계 (기록 스레드만 갱신) */
+static unsigned long total_batches = 0;
+static unsigned long total_records = 0;
+
+static void commit_batch(WalEntry* batch, int count, ScoreRecord* records) {
+  int i = 0;
+  for (WalEntry* e = batch; e; e = e->next) {
+    records[i++] = e->record;
+  }
+
+  int success = db_append_scores(records, count, wal_sync_mode);
+  total_batches++;
+  total_records += count;
+
+  // 같은 배치의 모든 제출에 결과 통지
+  while (batch) {
+    WalEntry* next = batch->next;
+    batch->on_commit(success, batch->ctx);
+    free(batch);
+    batch = next;
+  }
+}
+
+/* arg: score_wal_start 가 할당한 배치 버퍼 (스레드가 끝날 때 해제) */
+static void* wal_thread_func(void* arg) {
+  ScoreRecord* records = (ScoreRecord*)arg;
+
+  while (1) {
+    pthread_mutex_lock(&wal_mutex);
+    while (pending_head == NULL && checkpoint_fn == NULL && wal_running) {
+      pthread_cond_wait(&wal_has_work, &wal_mutex);
+    }
+
+    // 앞선 배치의 on_commit 이 모두 끝났고 다음 배치는 아직 쓰지 않은 시점
+    if (checkpoint_fn) {
+      WalCheckpointFn fn = checkpoint_fn;
+      void* fn_ctx = checkpoint_ctx;
+      pthread_mutex_unlock(&wal_mutex);
+      fn(fn_ctx);
+      pthread_mutex_lock(&wal_mutex);
+      checkpoint_fn = NULL;
+      pthread_cond_broadcast(&checkpoint_done);
+      pthread_mutex_unlock(&wal_mutex);
+      continue;
+    }
+
+    if (pending_head == NULL && !wal_running) {
+      wal_thread_active = false;
+      pthread_mutex_unlock(&wal_mutex);
+      break;
+    }
+
+    // 기록 중에 들어온 제출은 다음 배치로 자연스럽게 묶임
+    WalEntry* batch = pending_head;
+    WalEntry* last = batch;
+    int count = 1;
+    while (last->next && count < wal_max_batch) {
+      last = last->next;
+      count++;
+    }
+    pending_head = last->next;
+    if (pending_head == NULL) pending_tail = NULL;
+    last->next = NULL;
+    pthread_mutex_unlock(&wal_mutex);
+
+    commit_batch(batch, count, records);
+  }
+
+  free(records);
+  return NULL;
+}
+
+int score_wal_start(DbSyncMode sync_mode, int max_batch) {
+  wal_sync_mode = sync_mode;
+  wal_max_batch = max_batch > 0 ? max_batch : 1;
+
+  // 스레드 안에서 할당에 실패하면 제출이 쌓이기만 하므로 시작 전에 확보
+  ScoreRecord* records = malloc(sizeof(ScoreRecord) * wal_max_batch);
+  if (!records) {
+    LOG_ERROR("malloc for batch buffer failed: %m");
+    return -1;
+  }
+
+  wal_running = true;
+  wal_thread_active = true;
+
+  if (pthread_create(&wal_thread, NULL, wal_thread_func, records) != 0) {
+    LOG_ERROR("pthread_create() error: %m");
+    wal_running = false;
+    wal_thread_active = false;
+    free(records);
+    return -1;
+  }
+
+  const char* mode_name = (sync_mode == DB_SYNC_FSYNC) ? "fsync" : (sync_mode == DB_SYNC_FDATASYNC) ? "fdatasync" : "none";
+  LOG_INFO("Group commit writer started (sync: %s, max batch: %d).", mode_name, wal_max_batch);
+  return 0;
+}
+
+int score_wal_append(const char* username, int score, WalCommitCallback on_commit, void* ctx) {
+  WalEntry* entry = malloc(sizeof(WalEntry));
+  if (!entry) {
+    return -1;
+  }
+  snprintf(entry->record.username, MAX_ID_LEN, "%s", username);
+  entry->record.score = score;
+  entry->on_commit = on_commit;
+  entry->ctx = ctx;
+  entry->next = NULL;
+
+  pthread_mutex_lock(&wal_mutex);
+  if (!wal_running) {
+    pthread_mutex_unlock(&wal_mutex);
+    free(entry);
+    return -1;
+  }
+  if (pending_tail) {
+    pending_tail->next = entry;
+  } else {
+    pending_head = entry;
+  }
+  pending_tail = entry;
+  pthread_cond_signal(&wal_has_work);
+  pthread_mutex_unlock(&wal_mutex);
+  return 0;
+}
+
+void score_wal_checkpoint(WalCheckpointFn fn, void* ctx) {
+  pthread_mutex_lock(&wal_mutex);
+  while (checkpoint_fn != NULL && wal_thread_active) {
+    pthread_cond_wait(&checkpoint_done, &wal_mutex);  // 다른 요청이 먼저 들어와 있음
+  }
+  if (!wal_thread_active) {
+    // 기록 스레드가 없으면 더 쓰일 배치도 없으므로 지금이 곧 배치 경계
+    pthread_mutex_unlock(&wal_mutex);
+    fn(ctx);
+    return;
+  }
+
+  checkpoint_fn = fn;
+  checkpoint_ctx = ctx;
+  pthread_cond_signal(&wal_has_work);
+  while (checkpoint_fn == fn && wal_thread_active) {
+    pthread_cond_wait(&checkpoint_done, &wal_mutex);
+  }
+  bool orphaned = (checkpoint_fn == fn);  // 기록 스레드가 실행하지 못하고 끝남
+  if (orphaned) {
+    checkpoint_fn = NULL;
+  }
+  pthread_mutex_unlock(&wal_mutex);
+
+  if (orphaned) {
+    fn(ctx);
+  }
+}
+
+void score_wal_stop(void) {
+  pthread_mutex_lock(&wal_mutex);
+  if (!wal_running) {
+    pthread_mutex_unlock(&wal_mutex);
+    return;
+  }
+  wal_running = false;
+  pthread_cond_signal(&wal_has_work);
+  pthread_mutex_unlock(&wal_mutex);
+
+  pthread_join(wal_thread, NULL);
+  LOG_INFO("Writer stopped: %lu scores in %lu batches (avg %.1f per sync).", total_records, total_batches,
+           total_batches ? (double)total_records / total_batches : 0.0);
+}
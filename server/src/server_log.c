@@ -0,0 +1,357 @@
+// server/src/server_log.c
+#include "server_log.h"
+
+#include <errno.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/eventfd.h>
+#include <time.h>
+#include <unistd.h>
+
+#define LOG_RECORD_SIZE 256        /* 레코드 하나 (넘치는 메시지는 잘림) */
+#define LOG_RING_SLOTS 512         /* 스레드별 링 레코드 수 (2의 거듭제곱) */
+#define LOG_FLUSH_INTERVAL_MS 20   /* 기록 스레드가 링을 비우는 주기 */
+#define LOG_OUTPUT_BUFFER 65536    /* 출력 대상(stdout / stderr)별 모아 쓰는 크기 */
+#define LOG_LINE_MAX (LOG_RECORD_SIZE + 96)
+#define LOG_LOST_REPORT_INTERVAL_NS 1000000000ull /* 버린 메시지 수 알림 최소 간격 */
+
+/*
+ * 링 레코드: 포맷된 메시지와 머리 정보만 담은 고정 크기 바이너리 레코드
+ * 시각은 호출한 순간 값이고, 문자열로 바꾸는 일은 기록 스레드가 함
+ */
+typedef struct {
+  uint64_t time_ns;   /* CLOCK_REALTIME */
+  const char* module; /* 문자열 리터럴 */
+  uint8_t level;
+  uint8_t reserved;
+  uint16_t len;
+  char text[LOG_RECORD_SIZE - 20];
+} LogRecord;
+
+_Static_assert(sizeof(LogRecord) == LOG_RECORD_SIZE, "LogRecord must fill one record slot");
+
+/*
+ * 스레드 하나의 링 (단일 생산자 / 단일 소비자)
+ * head 는 그 스레드만, tail 은 기록 스레드만 바꾸고 각자 다른 캐시 라인에 둠
+ */
+typedef struct LogRing {
+  LogRecord records[LOG_RING_SLOTS];
+
+  uint32_t head __attribute__((aligned(64))); /* 다음에 쓸 위치 (생산자) */
+  uint64_t dropped;                           /* 링이 가득 차 버린 수 (생산자만 씀) */
+  uint64_t suppressed;                        /* 초당 한도를 넘어 버린 수 (생산자만 씀) */
+  uint64_t window_sec;                        /* 한도를 세는 현재 초 */
+  uint32_t window_count;
+
+  uint32_t tail __attribute__((aligned(64))); /* 다음에 읽을 위치 (기록 스레드) */
+
+  unsigned id;
+  struct LogRing* next;
+} LogRing;
+
+int server_log_min_level = LOG_LEVEL_INFO;
+static int log_rate_limit = 0; /* 0 이면 제한 없음 */
+
+static __thread LogRing* local_ring;
+static LogRing* all_rings; /* 앞에만 추가 (기록 스레드는 락 없이 따라감) */
+static unsigned ring_count = 0;
+static pthread_mutex_t ring_list_mutex = PTHREAD_MUTEX_INITIALIZER; /* 링 등록 시에만 */
+
+static pthread_t writer_thread;
+static unsigned writer_id; /* 기록 스레드가 직접 남기는 줄의 스레드 번호 */
+static bool writer_running = false;
+static int stop_fd = -1;
+
+static const char* const level_names[] = {"DEBUG", "INFO", "WARN", "ERROR"};
+
+static uint64_t realtime_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_REALTIME, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static int write_all(int fd, const char* data, size_t len) {
+  while (len > 0) {
+    ssize_t n = write(fd, data, len);
+    if (n < 0) {
+      if (errno == EINTR) continue;
+      return -1;
+    }
+    data += n;
+    len -= (size_t)n;
+  }
+  return 0;
+}
+
+// 레코드 → "2026-01-02 15:04:05.123456 INFO  t3 [MODULE] text\n", 줄 길이 반환
+static size_t format_line(char* line, const LogRecord* rec, unsigned thread_id) {
+  /* 같은 초의 레코드가 대부분이므로 날짜 문자열은 초가 바뀔 때만 다시 만듦 (기록 스레드 / 폴백 전용) */
+  static __thread time_t cached_sec = -1;
+  static __thread char cached_date[32];
+
+  time_t sec = (time_t)(rec->time_ns / 1000000000ull);
+  if (sec != cached_sec) {
+    struct tm tm;
+    localtime_r(&sec, &tm);
+    strftime(cached_date, sizeof(cached_date), "%Y-%m-%d %H:%M:%S", &tm);
+    cached_sec = sec;
+  }
+  int n = snprintf(line, LOG_LINE_MAX, "%s.%06u %-5s t%u [%s] %.*s\n", cached_date, (unsigned)(rec->time_ns % 1000000000ull / 1000),
+                   level_names[rec->level], thread_id, rec->module, (int)rec->len, rec->text);
+  return n < LOG_LINE_MAX ? (size_t)n : LOG_LINE_MAX - 1;
+}
+
+// 호출 인자로 레코드 채우기 (포맷은 호출한 스레드에서, errno 도 그대로 보임)
+static void fill_record(LogRecord* rec, uint64_t now, LogLevel level, const char* module, const char* fmt, va_list args) {
+  rec->time_ns = now;
+  rec->module = module;
+  rec->level = (uint8_t)level;
+  int n = vsnprintf(rec->text, sizeof(rec->text), fmt, args);
+  if (n < 0) n = 0;
+  rec->len = (uint16_t)(n < (int)sizeof(rec->text) ? n : (int)sizeof(rec->text) - 1);
+}
+
+// 이 스레드의 링 (처음 로그를 남길 때 만들어 등록), 메모리가 없으면 NULL → 메시지 버림
+static LogRing* thread_ring(void) {
+  LogRing* ring = local_ring;
+  if (ring) return ring;
+
+  ring = calloc(1, sizeof(LogRing));
+  if (!ring) return NULL;
+
+  pthread_mutex_lock(&ring_list_mutex);
+  ring->id = ring_count++;
+  ring->next = all_rings;
+  __atomic_store_n(&all_rings, ring, __ATOMIC_RELEASE);
+  pthread_mutex_unlock(&ring_list_mutex);
+
+  local_ring = ring;
+  return ring;
+}
+
+void server_log(LogLevel level, const char* module, const char* fmt, ...) {
+  uint64_t now = realtime_ns();
+  va_list args;
+
+  if (!__atomic_load_n(&writer_running, __ATOMIC_ACQUIRE)) {
+    // 기록 스레드가 없으면 (시작 전 / 종료 후) 바로 출력
+    LogRecord rec;
+    char line[LOG_LINE_MAX];
+    va_start(args, fmt);
+    fill_record(&rec, now, level, module, fmt, args);
+    va_end(args);
+    size_t len = format_line(line, &rec, local_ring ? local_ring->id : 0);
+    write_all(level >= LOG_LEVEL_WARN ? STDERR_FILENO : STDOUT_FILENO, line, len);
+    return;
+  }
+
+  LogRing* ring = thread_ring();
+  if (!ring) return;
+
+  // 스레드별 초당 한도
+  if (log_rate_limit > 0) {
+    uint64_t sec = now / 1000000000ull;
+    if (sec != ring->window_sec) {
+      ring->window_sec = sec;
+      ring->window_count = 0;
+    }
+    if (ring->window_count >= (uint32_t)log_rate_limit) {
+      __atomic_store_n(&ring->suppressed, ring->suppressed + 1, __ATOMIC_RELAXED);
+      return;
+    }
+    ring->window_count++;
+  }
+
+  uint32_t head = ring->head;
+  if (head - __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE) >= LOG_RING_SLOTS) {
+    __atomic_store_n(&ring->dropped, ring->dropped + 1, __ATOMIC_RELAXED);
+    return;  // 기록 스레드가 따라오지 못하면 기다리지 않고 버림
+  }
+
+  va_start(args, fmt);
+  fill_record(&ring->records[head & (LOG_RING_SLOTS - 1)], now, level, module, fmt, args);
+  va_end(args);
+  __atomic_store_n(&ring->head, head + 1, __ATOMIC_RELEASE);
+}
+
+int server_log_parse_level(const char* name) {
+  for (int i = 0; i < (int)(sizeof(level_names) / sizeof(level_names[0])); i++) {
+    if (strcasecmp(name, level_names[i]) == 0) return i;
+  }
+  return -1;
+}
+
+/* ---------------------------------------------------------------
+ *  기록 스레드
+ * ------------------------------------------------------------- */
+
+/* 출력 대상별 모음 버퍼 (기록 스레드 전용) */
+typedef struct {
+  int fd;
+  size_t used;
+  char data[LOG_OUTPUT_BUFFER];
+} LogOutput;
+
+static LogOutput out_stdout = {STDOUT_FILENO, 0, {0}};
+static LogOutput out_stderr = {STDERR_FILENO, 0, {0}};
+
+static void output_flush(LogOutput* out) {
+  if (out->used > 0) {
+    write_all(out->fd, out->data, out->used);
+    out->used = 0;
+  }
+}
+
+static void output_record(const LogRecord* rec, unsigned thread_id) {
+  LogOutput* out = rec->level >= LOG_LEVEL_WARN ? &out_stderr : &out_stdout;
+  if (out->used + LOG_LINE_MAX > sizeof(out->data)) {
+    output_flush(out);
+  }
+  out->used += format_line(out->data + out->used, rec, thread_id);
+}
+
+/* 지금까지 알린 버린 메시지 수 (기록 스레드 전용) */
+static uint64_t reported_dropped = 0;
+static uint64_t reported_suppressed = 0;
+static uint64_t last_lost_report_ns = 0;
+
+// 모든 링에서 버린 메시지 수가 늘었으면 한 줄로 알림 (force 가 아니면 최소 간격마다 한 번)
+static void report_lost(bool force) {
+  uint64_t now = realtime_ns();
+  if (!force && now - last_lost_report_ns < LOG_LOST_REPORT_INTERVAL_NS) return;
+
+  uint64_t dropped = 0, suppressed = 0;
+  for (LogRing* ring = __atomic_load_n(&all_rings, __ATOMIC_ACQUIRE); ring; ring = ring->next) {
+    dropped += __atomic_load_n(&ring->dropped, __ATOMIC_RELAXED);
+    suppressed += __atomic_load_n(&ring->suppressed, __ATOMIC_RELAXED);
+  }
+  if (dropped == reported_dropped && suppressed == reported_suppressed) return;
+
+  LogRecord rec;
+  rec.time_ns = now;
+  rec.module = "SERVER_LOG";
+  rec.level = LOG_LEVEL_WARN;
+  int n = snprintf(rec.text, sizeof(rec.text), "Discarded %llu message(s): %llu ring full, %llu over %d/s per-thread limit",
+                   (unsigned long long)(dropped - reported_dropped + suppressed - reported_suppressed),
+                   (unsigned long long)(dropped - reported_dropped), (unsigned long long)(suppressed - reported_suppressed), log_rate_limit);
+  rec.len = (uint16_t)(n < (int)sizeof(rec.text) ? n : (int)sizeof(rec.text) - 1);
+  output_record(&rec, writer_id);
+
+  reported_dropped = dropped;
+  reported_suppressed = suppressed;
+  last_lost_report_ns = now;
+}
+
+/* 한 번 비울 때 레코드가 있는 링 목록 (기록 스레드 전용) */
+typedef struct {
+  LogRing* ring;
+  uint32_t pos;
+  uint32_t end;
+} PendingRing;
+
+static PendingRing* pending;
+static size_t pending_cap = 0;
+
+// 지금까지 들어온 레코드를 모든 링에서 시각 순으로 합쳐 출력
+static void drain_rings(bool final) {
+  size_t count = 0;
+  for (LogRing* ring = __atomic_load_n(&all_rings, __ATOMIC_ACQUIRE); ring; ring = ring->next) {
+    uint32_t tail = ring->tail;
+    uint32_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+    if (head != tail) {
+      if (count == pending_cap) {
+        size_t new_cap = pending_cap ? pending_cap * 2 : 16;
+        PendingRing* grown = realloc(pending, new_cap * sizeof(PendingRing));
+        if (!grown) break;  // 나머지 링은 다음 주기에
+        pending = grown;
+        pending_cap = new_cap;
+      }
+      pending[count++] = (PendingRing){ring, tail, head};
+    }
+  }
+
+  // 링마다 시각 순이므로 각 링의 맨 앞 레코드 중 가장 이른 것을 차례로 꺼냄
+  while (count > 0) {
+    size_t best = 0;
+    for (size_t i = 1; i < count; i++) {
+      if (pending[i].ring->records[pending[i].pos & (LOG_RING_SLOTS - 1)].time_ns <
+          pending[best].ring->records[pending[best].pos & (LOG_RING_SLOTS - 1)].time_ns) {
+        best = i;
+      }
+    }
+    PendingRing* p = &pending[best];
+    output_record(&p->ring->records[p->pos & (LOG_RING_SLOTS - 1)], p->ring->id);
+    if (++p->pos == p->end) {
+      __atomic_store_n(&p->ring->tail, p->end, __ATOMIC_RELEASE);
+      pending[best] = pending[--count];
+    }
+  }
+
+  report_lost(final);
+  output_flush(&out_stdout);
+  output_flush(&out_stderr);
+}
+
+static void* log_writer_func(void* arg) {
+  (void)arg;
+  struct pollfd pfd = {stop_fd, POLLIN, 0};
+  while (1) {
+    int ready = poll(&pfd, 1, LOG_FLUSH_INTERVAL_MS);
+    if (ready < 0 && errno != EINTR) break;
+    drain_rings(false);
+    if (ready > 0) break;  // 정지 요청 (직전에 들어온 레코드까지 출력함)
+  }
+  return NULL;
+}
+
+int server_log_start(LogLevel min_level, int rate_limit) {
+  __atomic_store_n(&server_log_min_level, (int)min_level, __ATOMIC_RELAXED);
+  log_rate_limit = rate_limit;
+
+  stop_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (stop_fd == -1) {
+    server_log(LOG_LEVEL_ERROR, "SERVER_LOG", "eventfd failed, logging synchronously: %m");
+    return -1;
+  }
+  pthread_mutex_lock(&ring_list_mutex);
+  writer_id = ring_count++;
+  pthread_mutex_unlock(&ring_list_mutex);
+
+  __atomic_store_n(&writer_running, true, __ATOMIC_RELEASE);
+  int err = pthread_create(&writer_thread, NULL, log_writer_func, NULL);
+  if (err != 0) {
+    __atomic_store_n(&writer_running, false, __ATOMIC_RELEASE);
+    close(stop_fd);
+    stop_fd = -1;
+    server_log(LOG_LEVEL_ERROR, "SERVER_LOG", "Failed to start log writer, logging synchronously: %s", strerror(err));
+    return -1;
+  }
+  atexit(server_log_stop);  // 시작 과정에서 exit() 로 끝나도 남은 레코드를 출력
+  return 0;
+}
+
+void server_log_stop(void) {
+  if (!__atomic_load_n(&writer_running, __ATOMIC_ACQUIRE)) return;
+
+  uint64_t one = 1;
+  ssize_t ignored = write(stop_fd, &one, sizeof(one));
+  (void)ignored;
+  pthread_join(writer_thread, NULL);
+  __atomic_store_n(&writer_running, false, __ATOMIC_RELEASE);
+  close(stop_fd);
+  stop_fd = -1;
+
+  // 정지 요청 뒤 들어온 레코드까지 출력
+  // 링은 해제하지 않음: 다른 스레드가 아직 자기 링(local_ring)을 쥐고 있거나
+  // writer_running 확인을 막 지나 기록 중일 수 있음 (atexit 경로), 프로세스 종료 시 회수
+  drain_rings(true);
+  free(pending);
+  pending = NULL;
+  pending_cap = 0;
+}
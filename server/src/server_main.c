@@ -1,22 +1,49 @@
 // server/src/server_main.c
 #include <arpa/inet.h>
-#include <pthread.h>
 #include <signal.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/resource.h>
 #include <sys/socket.h>
 #include <unistd.h>
 
 #include "auth_manager.h"
 #include "db_handler.h"
 #include "hash_util.h" /* 암호화 시스템 정리를 위해 추가 */
+#include "leaderboard_cache.h"
 #include "score_manager.h"
+#include "score_wal.h"
+#include "server_log.h"
+#include "server_metrics.h"
 #include "server_network.h"
+#include "session_registry.h"
 #include "word_manager.h"
 
+#define LOG_MODULE "SERVER_MAIN"
+
 #define PORT 8080
-#define MAX_CLIENTS 10
+#define LISTEN_BACKLOG 1024   /* accept 대기열 길이 (동시 접속 수 제한 아님) */
+
+/* 기본 스레드 구성 (환경 변수 RAIN_REACTORS / RAIN_WORKERS / RAIN_QUEUE_CAPACITY 로 변경 가능) */
+#define DEFAULT_REACTOR_THREADS 4
+#define DEFAULT_WORKER_THREADS 8
+#define DEFAULT_QUEUE_CAPACITY 1024
+
+/* 점수 WAL 그룹 커밋 (RAIN_WAL_SYNC=fsync|fdatasync|none, RAIN_WAL_MAX_BATCH) */
+#define DEFAULT_WAL_MAX_BATCH 4096
+
+/* 로그 (RAIN_LOG_LEVEL=debug|info|warn|error, RAIN_LOG_RATE: 스레드마다 초당 최대 메시지 수) */
+#define DEFAULT_LOG_RATE 1000
+
+/* 지표 덤프 Unix 소켓 (RAIN_METRICS_SOCKET=경로, none 이면 끔) */
+#define DEFAULT_METRICS_SOCKET "data/metrics.sock"
+
+/* 저장소 백엔드: RAIN_STORAGE=text(기본, users.txt / scores.txt) | log(users.log / scores.log) */
+
+/* 점수 압축 스냅샷 (RAIN_SNAPSHOT_PATH=경로, none 이면 끔 / RAIN_SNAPSHOT_INTERVAL: 초) */
+#define DEFAULT_SNAPSHOT_PATH "data/scores.snap"
+#define DEFAULT_SNAPSHOT_INTERVAL 300
 
 volatile sig_atomic_t server_shutdown_requested = 0;
 int server_sock_fd = -1;
@@ -24,25 +51,78 @@ int server_sock_fd = -1;
 void handle_server_sigint(int sig) {
   (void)sig;
   server_shutdown_requested = 1;
-  if (server_sock_fd != -1) {
-    printf("\n[SERVER_MAIN] SIGINT received. Closing server socket to stop accept() loop.\n");
-    close(server_sock_fd);
-    server_sock_fd = -1;
+  /* eventfd 에 write 만 하므로 시그널 핸들러에서 안전 */
+  request_server_shutdown();
+}
+
+void handle_server_sighup(int sig) {
+  (void)sig;
+  request_wordlist_reload();
+}
+
+/* 양의 정수 환경 변수를 읽고, 없거나 잘못된 값이면 기본값 사용 */
+static int env_int(const char *name, int default_value) {
+  const char *value = getenv(name);
+  if (value == NULL || *value == '\0') return default_value;
+
+  char *endptr;
+  long parsed = strtol(value, &endptr, 10);
+  if (*endptr != '\0' || parsed <= 0 || parsed > 65536) {
+    LOG_WARN("Ignoring invalid %s=%s (using %d)", name, value, default_value);
+    return default_value;
+  }
+  return (int)parsed;
+}
+
+/* RAIN_WAL_SYNC 값을 동기화 방식으로 변환 (기본 fsync) */
+static DbSyncMode wal_sync_mode_from_env(void) {
+  const char *value = getenv("RAIN_WAL_SYNC");
+  if (value == NULL || *value == '\0' || strcmp(value, "fsync") == 0) return DB_SYNC_FSYNC;
+  if (strcmp(value, "fdatasync") == 0) return DB_SYNC_FDATASYNC;
+  if (strcmp(value, "none") == 0) return DB_SYNC_NONE;
+  LOG_WARN("Ignoring invalid RAIN_WAL_SYNC=%s (using fsync)", value);
+  return DB_SYNC_FSYNC;
+}
+
+/* RAIN_LOG_LEVEL 값을 로그 수준으로 변환 (기본 info) */
+static LogLevel log_level_from_env(void) {
+  const char *value = getenv("RAIN_LOG_LEVEL");
+  if (value == NULL || *value == '\0') return LOG_LEVEL_INFO;
+  int level = server_log_parse_level(value);
+  if (level < 0) {
+    LOG_WARN("Ignoring invalid RAIN_LOG_LEVEL=%s (using info)", value);
+    return LOG_LEVEL_INFO;
+  }
+  return (LogLevel)level;
+}
+
+/* 수만 개의 연결을 받을 수 있도록 fd 소프트 한도를 하드 한도까지 올림 */
+static void raise_fd_limit(void) {
+  struct rlimit rl;
+  if (getrlimit(RLIMIT_NOFILE, &rl) == 0 && rl.rlim_cur < rl.rlim_max) {
+    rl.rlim_cur = rl.rlim_max;
+    if (setrlimit(RLIMIT_NOFILE, &rl) != 0) {
+      LOG_ERROR("setrlimit(RLIMIT_NOFILE) failed: %m");
+    }
   }
 }
 
 int main() {
-  int client_sock;
-  struct sockaddr_in server_addr, client_addr;
-  socklen_t client_addr_size;
-  pthread_t tid;
+  struct sockaddr_in server_addr;
 
   signal(SIGINT, handle_server_sigint);
   signal(SIGTERM, handle_server_sigint);
+  signal(SIGHUP, handle_server_sighup); /* 단어 파일 다시 읽기 */
+  signal(SIGPIPE, SIG_IGN);
+
+  /* 아직 stdio 로 출력하는 모듈(시작/종료 메시지)도 로그와 순서가 섞이지 않게 줄 단위로 내보냄 */
+  setvbuf(stdout, NULL, _IOLBF, 0);
+  server_log_start(log_level_from_env(), env_int("RAIN_LOG_RATE", DEFAULT_LOG_RATE));
+  raise_fd_limit();
 
   server_sock_fd = socket(PF_INET, SOCK_STREAM, 0);
   if (server_sock_fd == -1) {
-    perror("socket() error");
+    LOG_ERROR("socket() error: %m");
     exit(EXIT_FAILURE);
   }
 
@@ -55,70 +135,75 @@ int main() {
   setsockopt(server_sock_fd, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
 
   if (bind(server_sock_fd, (struct sockaddr *)&server_addr, sizeof(server_addr)) == -1) {
-    perror("bind() error");
+    LOG_ERROR("bind() error: %m");
     close(server_sock_fd);
     exit(EXIT_FAILURE);
   }
 
-  if (listen(server_sock_fd, MAX_CLIENTS) == -1) {
-    perror("listen() error");
+  if (listen(server_sock_fd, LISTEN_BACKLOG) == -1) {
+    LOG_ERROR("listen() error: %m");
     close(server_sock_fd);
     exit(EXIT_FAILURE);
   }
 
-  printf("Rain Typing Game Server started on port %d...\n", PORT);
-  printf("Press Ctrl+C to shut down the server.\n");
+  LOG_INFO("Rain Typing Game Server started on port %d...", PORT);
+  LOG_INFO("Press Ctrl+C to shut down the server.");
 
   /* 시스템 초기화 */
-  init_db_files();
+  int wal_max_batch = env_int("RAIN_WAL_MAX_BATCH", DEFAULT_WAL_MAX_BATCH);
+  init_db(getenv("RAIN_STORAGE"), wal_max_batch);
 
   if (load_wordlist_from_file("data/words.txt") <= 0) {
-    fprintf(stderr, "[SERVER] data/words.txt load failed\n");
+    LOG_ERROR("data/words.txt load failed");
     exit(EXIT_FAILURE);
   }
+  if (start_wordlist_watcher("data/words.txt") != 0) {
+    LOG_WARN("Word list reload disabled.");
+  }
 
-  extern void init_logged_in_users();
-  init_logged_in_users();
+  session_registry_init();
   init_auth_system(); /* 암호화 시스템도 여기서 초기화됨 */
-  init_score_system();
 
-  while (!server_shutdown_requested) {
-    client_addr_size = sizeof(client_addr);
-    client_sock = accept(server_sock_fd, (struct sockaddr *)&client_addr, &client_addr_size);
+  const char *snapshot_path = getenv("RAIN_SNAPSHOT_PATH");
+  if (snapshot_path == NULL || *snapshot_path == '\0') snapshot_path = DEFAULT_SNAPSHOT_PATH;
+  if (strcmp(snapshot_path, "none") == 0) snapshot_path = NULL;
+  init_score_system(snapshot_path);
+  if (score_wal_start(wal_sync_mode_from_env(), wal_max_batch) != 0) {
+    LOG_ERROR("Failed to start score writer.");
+    exit(EXIT_FAILURE);
+  }
+  if (snapshot_path && start_score_compaction(env_int("RAIN_SNAPSHOT_INTERVAL", DEFAULT_SNAPSHOT_INTERVAL)) != 0) {
+    LOG_WARN("Periodic score compaction disabled.");
+  }
 
-    if (server_shutdown_requested) {
-      if (client_sock != -1) close(client_sock);
-      break;
-    }
+  const char *metrics_socket = getenv("RAIN_METRICS_SOCKET");
+  if (metrics_socket == NULL || *metrics_socket == '\0') metrics_socket = DEFAULT_METRICS_SOCKET;
+  if (strcmp(metrics_socket, "none") != 0 && metrics_start_socket(metrics_socket) != 0) {
+    LOG_WARN("Metrics socket disabled.");
+  }
 
-    if (client_sock == -1) {
-      if (server_shutdown_requested) {
-        printf("[SERVER_MAIN] accept() interrupted by shutdown signal. Exiting loop.\n");
-      } else {
-        perror("accept() error");
-      }
-      continue;
-    }
+  /* 종료 요청이 들어올 때까지 이벤트 루프 실행 */
+  ServerNetworkConfig net_config;
+  net_config.num_reactors = env_int("RAIN_REACTORS", DEFAULT_REACTOR_THREADS);
+  net_config.num_workers = env_int("RAIN_WORKERS", DEFAULT_WORKER_THREADS);
+  net_config.queue_capacity = env_int("RAIN_QUEUE_CAPACITY", DEFAULT_QUEUE_CAPACITY);
 
-    printf("[SERVER_MAIN] Client connected: %s:%d (socket: %d)\n", inet_ntoa(client_addr.sin_addr), ntohs(client_addr.sin_port), client_sock);
+  if (run_server_event_loop(server_sock_fd, &net_config) != 0) {
+    LOG_ERROR("Event loop failed to start.");
+  }
 
-    int *p_client_sock = malloc(sizeof(int));
-    if (!p_client_sock) {
-      perror("malloc for client_sock failed");
-      close(client_sock);
-      continue;
-    }
-    *p_client_sock = client_sock;
+  LOG_INFO("Shutdown sequence initiated.");
 
-    if (pthread_create(&tid, NULL, handle_client, (void *)p_client_sock) != 0) {
-      perror("pthread_create() error");
-      free(p_client_sock);
-      close(client_sock);
-    }
-    pthread_detach(tid);
-  }
+  metrics_stop_socket();
 
-  printf("[SERVER_MAIN] Shutdown sequence initiated.\n");
+  /* 대기 중인 점수 기록 마무리 후 마지막 스냅샷 (보통은 이벤트 루프가 이미 멈춤, 루프가 시작하지 못한 경우 대비) */
+  score_wal_stop();
+  stop_score_compaction();
+  close_db();
+  leaderboard_cache_cleanup();
+  stop_wordlist_watcher();
+  session_registry_destroy();
+  metrics_cleanup();
 
   if (server_sock_fd != -1) {
     close(server_sock_fd);
@@ -128,6 +213,7 @@ int main() {
   /* 암호화 시스템 정리 */
   crypto_cleanup();
 
-  printf("[SERVER_MAIN] Server has shut down.\n");
+  LOG_INFO("Server has shut down.");
+  server_log_stop();
   return 0;
 }
\ No newline at end of file
@@ -0,0 +1,356 @@
+// server/src/server_metrics.c
+#define _GNU_SOURCE /* accept4() */
+#include "server_metrics.h"
+
+#include <errno.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "latency_histogram.h"
+#include "protocol.h"
+#include "server_log.h"
+#include "session_registry.h"
+
+#define LOG_MODULE "SERVER_METRICS"
+
+#define METRICS_REQUEST_WAIT_MS 100 /* 덤프 소켓에서 요청 줄("GET ...")을 기다리는 시간 */
+#define METRICS_SEND_TIMEOUT_SEC 1  /* 읽지 않는 상대 때문에 소켓 스레드가 멈추지 않게 */
+
+/* 요청 종류 → 지표 칸 (알려진 요청 타입마다 하나 + 나머지) */
+typedef enum {
+  METRIC_MSG_REGISTER = 0,
+  METRIC_MSG_LOGIN,
+  METRIC_MSG_SCORE_SUBMIT,
+  METRIC_MSG_LEADERBOARD,
+  METRIC_MSG_LOGOUT,
+  METRIC_MSG_WORDLIST,
+  METRIC_MSG_WORDLIST_PACKED,
+  METRIC_MSG_WORDLIST_COND,
+  METRIC_MSG_WORD_SAMPLE,
+  METRIC_MSG_WORD_STREAM,
+  METRIC_MSG_METRICS,
+  METRIC_MSG_OTHER,
+  METRIC_MSG_SLOTS
+} MetricMessageSlot;
+
+static const char* const message_slot_names[METRIC_MSG_SLOTS] = {
+    "register",        "login",         "score_submit", "leaderboard", "logout",  "wordlist",
+    "wordlist_packed", "wordlist_cond", "word_sample",  "word_stream", "metrics", "other",
+};
+
+static const char* const db_op_names[METRIC_DB_OP_COUNT] = {"lock_wait", "read", "write", "fsync"};
+
+/* 스레드 하나가 기록하는 지표 (그 스레드만 쓰고, 읽는 쪽은 relaxed 로 읽음) */
+typedef struct MetricsThread {
+  LatencyHistogram request_latency[METRIC_MSG_SLOTS];
+  LatencyHistogram db_time[METRIC_DB_OP_COUNT];
+  uint64_t counters[METRIC_COUNTER_COUNT];
+  struct MetricsThread* next;
+} MetricsThread;
+
+static __thread MetricsThread* local_metrics;
+static MetricsThread* all_metrics; /* 등록된 모든 블록 */
+static pthread_mutex_t metrics_list_mutex = PTHREAD_MUTEX_INITIALIZER; /* 등록 / 합산 시에만 */
+
+static MetricMessageSlot message_slot(uint32_t type) {
+  switch (type) {
+    case MSG_TYPE_REGISTER_REQ: return METRIC_MSG_REGISTER;
+    case MSG_TYPE_LOGIN_REQ: return METRIC_MSG_LOGIN;
+    case MSG_TYPE_SCORE_SUBMIT_REQ: return METRIC_MSG_SCORE_SUBMIT;
+    case MSG_TYPE_LEADERBOARD_REQ: return METRIC_MSG_LEADERBOARD;
+    case MSG_TYPE_LOGOUT_REQ: return METRIC_MSG_LOGOUT;
+    case MSG_TYPE_WORDLIST_REQ: return METRIC_MSG_WORDLIST;
+    case MSG_TYPE_WORDLIST_PACKED_REQ: return METRIC_MSG_WORDLIST_PACKED;
+    case MSG_TYPE_WORDLIST_COND_REQ: return METRIC_MSG_WORDLIST_COND;
+    case MSG_TYPE_WORD_SAMPLE_REQ: return METRIC_MSG_WORD_SAMPLE;
+    case MSG_TYPE_WORD_STREAM_REQ: return METRIC_MSG_WORD_STREAM;
+    case MSG_TYPE_METRICS_REQ: return METRIC_MSG_METRICS;
+    default: return METRIC_MSG_OTHER;
+  }
+}
+
+// 이 스레드의 블록 (처음 기록할 때 만들어 등록), 메모리가 없으면 NULL → 기록 생략
+static MetricsThread* thread_metrics(void) {
+  MetricsThread* block = local_metrics;
+  if (block) return block;
+
+  block = calloc(1, sizeof(MetricsThread));
+  if (!block) return NULL;
+
+  pthread_mutex_lock(&metrics_list_mutex);
+  block->next = all_metrics;
+  all_metrics = block;
+  pthread_mutex_unlock(&metrics_list_mutex);
+
+  local_metrics = block;
+  return block;
+}
+
+uint64_t metrics_now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+void metrics_count(MetricCounter counter, uint64_t amount) {
+  MetricsThread* block = thread_metrics();
+  if (!block) return;
+  uint64_t* field = &block->counters[counter];
+  __atomic_store_n(field, __atomic_load_n(field, __ATOMIC_RELAXED) + amount, __ATOMIC_RELAXED);
+}
+
+void metrics_record_request(uint32_t type, uint64_t elapsed_ns) {
+  MetricsThread* block = thread_metrics();
+  if (block) latency_hist_record_shared(&block->request_latency[message_slot(type)], elapsed_ns / 1000);
+}
+
+void metrics_record_db(MetricDbOp op, uint64_t elapsed_ns) {
+  MetricsThread* block = thread_metrics();
+  if (block) latency_hist_record_shared(&block->db_time[op], elapsed_ns / 1000);
+}
+
+/* ---------------------------------------------------------------
+ *  Prometheus 텍스트 출력
+ * ------------------------------------------------------------- */
+
+// 모든 스레드 블록을 하나로 합산 (호출자가 free)
+static MetricsThread* collect_metrics(void) {
+  MetricsThread* total = calloc(1, sizeof(MetricsThread));
+  if (!total) return NULL;
+
+  pthread_mutex_lock(&metrics_list_mutex);
+  for (const MetricsThread* block = all_metrics; block; block = block->next) {
+    for (int i = 0; i < METRIC_MSG_SLOTS; i++) {
+      latency_hist_merge_shared(&total->request_latency[i], &block->request_latency[i]);
+    }
+    for (int i = 0; i < METRIC_DB_OP_COUNT; i++) {
+      latency_hist_merge_shared(&total->db_time[i], &block->db_time[i]);
+    }
+    for (int i = 0; i < METRIC_COUNTER_COUNT; i++) {
+      total->counters[i] += __atomic_load_n(&block->counters[i], __ATOMIC_RELAXED);
+    }
+  }
+  pthread_mutex_unlock(&metrics_list_mutex);
+  return total;
+}
+
+// 히스토그램 하나를 summary 의 한 계열로 (분위수, _sum, _count)
+static void write_summary(FILE* out, const char* metric, const char* label, const char* value, const LatencyHistogram* hist) {
+  static const double quantiles[] = {0.5, 0.9, 0.99, 0.999};
+  for (size_t i = 0; i < sizeof(quantiles) / sizeof(quantiles[0]); i++) {
+    fprintf(out, "%s{%s=\"%s\",quantile=\"%g\"} %llu\n", metric, label, value, quantiles[i],
+            (unsigned long long)latency_hist_percentile(hist, quantiles[i] * 100.0));
+  }
+  fprintf(out, "%s_sum{%s=\"%s\"} %llu\n", metric, label, value, (unsigned long long)hist->sum);
+  fprintf(out, "%s_count{%s=\"%s\"} %llu\n", metric, label, value, (unsigned long long)hist->total);
+}
+
+char* metrics_render(size_t* len) {
+  MetricsThread* total = collect_metrics();
+  if (!total) return NULL;
+
+  char* text = NULL;
+  size_t text_len = 0;
+  FILE* out = open_memstream(&text, &text_len);
+  if (!out) {
+    free(total);
+    return NULL;
+  }
+
+  fprintf(out, "# HELP rain_request_latency_us Time from request decode to response ready, by message type.\n");
+  fprintf(out, "# TYPE rain_request_latency_us summary\n");
+  for (int i = 0; i < METRIC_MSG_SLOTS; i++) {
+    write_summary(out, "rain_request_latency_us", "type", message_slot_names[i], &total->request_latency[i]);
+  }
+
+  fprintf(out, "# HELP rain_db_time_us Time spent in the file database, by operation.\n");
+  fprintf(out, "# TYPE rain_db_time_us summary\n");
+  for (int i = 0; i < METRIC_DB_OP_COUNT; i++) {
+    write_summary(out, "rain_db_time_us", "op", db_op_names[i], &total->db_time[i]);
+  }
+
+  uint64_t opened = total->counters[METRIC_CONN_OPENED];
+  uint64_t closed = total->counters[METRIC_CONN_CLOSED];
+  fprintf(out, "# HELP rain_connections_active Open client connections.\n");
+  fprintf(out, "# TYPE rain_connections_active gauge\n");
+  fprintf(out, "rain_connections_active %llu\n", (unsigned long long)(opened > closed ? opened - closed : 0));
+  fprintf(out, "# HELP rain_connections_total Accepted client connections.\n");
+  fprintf(out, "# TYPE rain_connections_total counter\n");
+  fprintf(out, "rain_connections_total %llu\n", (unsigned long long)opened);
+  fprintf(out, "# HELP rain_sessions_active Logged-in sessions.\n");
+  fprintf(out, "# TYPE rain_sessions_active gauge\n");
+  fprintf(out, "rain_sessions_active %zu\n", session_registry_count());
+  fprintf(out, "# HELP rain_bytes_received_total Bytes read from client sockets.\n");
+  fprintf(out, "# TYPE rain_bytes_received_total counter\n");
+  fprintf(out, "rain_bytes_received_total %llu\n", (unsigned long long)total->counters[METRIC_BYTES_IN]);
+  fprintf(out, "# HELP rain_bytes_sent_total Bytes written to client sockets.\n");
+  fprintf(out, "# TYPE rain_bytes_sent_total counter\n");
+  fprintf(out, "rain_bytes_sent_total %llu\n", (unsigned long long)total->counters[METRIC_BYTES_OUT]);
+
+  free(total);
+  if (fclose(out) != 0) {
+    free(text);
+    return NULL;
+  }
+  *len = text_len;
+  return text;
+}
+
+void metrics_cleanup(void) {
+  pthread_mutex_lock(&metrics_list_mutex);
+  MetricsThread* block = all_metrics;
+  all_metrics = NULL;
+  pthread_mutex_unlock(&metrics_list_mutex);
+
+  while (block) {
+    MetricsThread* next = block->next;
+    free(block);
+    block = next;
+  }
+  local_metrics = NULL;
+}
+
+/* ---------------------------------------------------------------
+ *  덤프 소켓 스레드
+ * ------------------------------------------------------------- */
+
+static char socket_path[sizeof(((struct sockaddr_un*)0)->sun_path)];
+static pthread_t socket_thread;
+static bool socket_running = false;
+static int listen_fd = -1;
+static int stop_fd = -1; /* 정지 알림 eventfd */
+
+static int write_all(int fd, const char* data, size_t len) {
+  while (len > 0) {
+    ssize_t n = write(fd, data, len);
+    if (n < 0) {
+      if (errno == EINTR) continue;
+      return -1;
+    }
+    data += n;
+    len -= (size_t)n;
+  }
+  return 0;
+}
+
+// 접속 하나에 지표를 한 번 쓰고 닫음
+static void serve_metrics_client(int fd) {
+  // nc -U 처럼 아무것도 보내지 않는 상대도 있으므로 잠깐만 기다림
+  char request[64];
+  ssize_t received = 0;
+  struct pollfd pfd = {fd, POLLIN, 0};
+  if (poll(&pfd, 1, METRICS_REQUEST_WAIT_MS) > 0) {
+    received = recv(fd, request, sizeof(request), MSG_DONTWAIT);
+  }
+  bool http = received >= 3 && memcmp(request, "GET", 3) == 0;
+
+  struct timeval timeout = {METRICS_SEND_TIMEOUT_SEC, 0};
+  setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+  size_t len;
+  char* text = metrics_render(&len);
+  if (!text) {
+    if (http) write_all(fd, "HTTP/1.0 500 Internal Server Error\r\n\r\n", 38);
+    return;
+  }
+  if (http) {
+    char head[160];
+    int head_len = snprintf(head, sizeof(head),
+                            "HTTP/1.0 200 OK\r\nContent-Type: text/plain; version=0.0.4\r\nContent-Length: %zu\r\nConnection: close\r\n\r\n", len);
+    if (write_all(fd, head, (size_t)head_len) != 0) {
+      free(text);
+      return;
+    }
+  }
+  write_all(fd, text, len);
+  free(text);
+}
+
+static void* metrics_socket_func(void* arg) {
+  (void)arg;
+  struct pollfd fds[2] = {{stop_fd, POLLIN, 0}, {listen_fd, POLLIN, 0}};
+  while (1) {
+    if (poll(fds, 2, -1) < 0) {
+      if (errno == EINTR) continue;
+      LOG_ERROR("poll failed: %m");
+      break;
+    }
+    if (fds[0].revents & POLLIN) break;
+    if (fds[1].revents & POLLIN) {
+      int client_fd = accept4(listen_fd, NULL, NULL, SOCK_CLOEXEC);
+      if (client_fd == -1) continue;
+      serve_metrics_client(client_fd);
+      close(client_fd);
+    }
+  }
+  return NULL;
+}
+
+int metrics_start_socket(const char* path) {
+  if (strlen(path) >= sizeof(socket_path)) {
+    LOG_ERROR("Socket path too long: %s", path);
+    return -1;
+  }
+  snprintf(socket_path, sizeof(socket_path), "%s", path);
+
+  listen_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  if (listen_fd == -1) {
+    LOG_ERROR("socket() failed: %m");
+    return -1;
+  }
+
+  struct sockaddr_un addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  memcpy(addr.sun_path, socket_path, strlen(socket_path));
+
+  unlink(socket_path);  // 이전 실행이 남긴 소켓 파일
+  if (bind(listen_fd, (struct sockaddr*)&addr, sizeof(addr)) == -1 || chmod(socket_path, 0600) == -1 || listen(listen_fd, 16) == -1) {
+    LOG_ERROR("Failed to open metrics socket: %m");
+    close(listen_fd);
+    listen_fd = -1;
+    unlink(socket_path);
+    return -1;
+  }
+
+  stop_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (stop_fd == -1 || pthread_create(&socket_thread, NULL, metrics_socket_func, NULL) != 0) {
+    LOG_ERROR("Failed to start metrics socket thread: %m");
+    if (stop_fd != -1) close(stop_fd);
+    stop_fd = -1;
+    close(listen_fd);
+    listen_fd = -1;
+    unlink(socket_path);
+    return -1;
+  }
+  socket_running = true;
+  LOG_INFO("Serving metrics on unix socket %s", socket_path);
+  return 0;
+}
+
+void metrics_stop_socket(void) {
+  if (!socket_running) return;
+
+  uint64_t one = 1;
+  ssize_t ignored = write(stop_fd, &one, sizeof(one));
+  (void)ignored;
+  pthread_join(socket_thread, NULL);
+  socket_running = false;
+
+  close(stop_fd);
+  stop_fd = -1;
+  close(listen_fd);
+  listen_fd = -1;
+  unlink(socket_path);
+}
@@ -1,318 +1,1270 @@
 // server/src/server_network.c
+#define _GNU_SOURCE /* accept4() */
 #include "server_network.h"
 
+#include <arpa/inet.h>
 #include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
 #include <pthread.h>
+#include <signal.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <unistd.h>
 
 #include "auth_manager.h"
+#include "frame_builder.h"
+#include "leaderboard_cache.h"
 #include "protocol.h"
 #include "score_manager.h"
+#include "score_wal.h"
+#include "server_log.h"
+#include "server_metrics.h"
+#include "session_registry.h"
+#include "shared_buffer.h"
+#include "wire_codec.h"
 #include "word_manager.h"
+#include "worker_pool.h"
 
-// 로그인된 사용자 관리 구조체
-typedef struct {
-  char username[MAX_ID_LEN];
-  int client_sock;
-  bool is_active;
-} LoggedInUser;
+#define LOG_MODULE "SERVER_NETWORK"
 
-#define MAX_LOGGED_IN_USERS 100
-static LoggedInUser logged_in_users[MAX_LOGGED_IN_USERS];
-static pthread_mutex_t logged_in_users_mutex = PTHREAD_MUTEX_INITIALIZER;
+/* ---------- 이벤트 루프 설정값 ---------- */
+#define MAX_EPOLL_EVENTS 256
+#define RECV_CHUNK_SIZE 16384
+#define MAX_MESSAGE_BODY_LEN 10240 /* 10KB 제한 */
+#define MAX_REACTORS 64
+#define SHUTDOWN_DRAIN_TIMEOUT_MS 5000
+#define MAX_RESPONSE_CHUNKS 4  /* 요청 하나가 만드는 응답 프레임 수 상한 */
+#define MAX_WRITEV_CHUNKS 64   /* writev 한 번에 넘기는 iovec 수 */
+#define MAX_PIPELINED_REQUESTS 32 /* 연결 하나에서 동시에 처리하는 요청 수 상한 */
 
-// 정확한 바이트 수만큼 송신하는 함수
-static int send_all(int sock, const void* buf, size_t len) {
-  size_t total_sent = 0;
-  const char* ptr = (const char*)buf;
+/* 연결별 수신 상태 머신 (접속 직후 hello 로 프로토콜 버전 결정) */
+typedef enum { READ_STATE_HELLO = 0, READ_STATE_HEADER, READ_STATE_BODY } ReadState;
 
-  while (total_sent < len) {
-    ssize_t sent = send(sock, ptr + total_sent, len - total_sent, 0);
-    if (sent == -1) {
-      if (errno == EINTR) continue;  // 시그널에 의한 중단은 재시도
-      return -1;
-    }
-    if (sent == 0) {
-      return -1;  // 연결 종료
+struct Reactor;
+
+/*
+ * 연결 하나의 상태
+ * - 스레드 스택 대신 이 구조체만 연결마다 유지되므로 유휴 연결 비용이 작다
+ * - body / out_queue / in_buf 는 필요할 때만 할당하고 다 쓰면 해제
+ * - 송신 대기열은 공유 버퍼 참조만 들고 있으므로 캐시된 응답은 복사 없이 전송
+ * - 요청 처리 중(in_flight > 0)에는 워커가 연결을 참조하므로
+ *   리액터는 연결을 해제하지 않고 closing 표시만 한다
+ * - 세션(current_user)이나 단어 스트림 위치를 읽거나 바꾸는 요청은 단독으로(exclusive) 처리하고,
+ *   그 외 요청은 버전 2 클라이언트가 파이프라이닝하면 워커들이 동시에 처리
+ */
+typedef struct Connection {
+  int fd;
+  char current_user[MAX_ID_LEN];
+  struct Reactor* reactor;
+  struct Connection* prev; /* 리액터별 연결 목록 (종료 시 정리용) */
+  struct Connection* next;
+
+  int in_flight;            /* 워커에서 처리 중인 요청 수 */
+  bool exclusive_in_flight; /* 처리 중인 요청 중 단독 처리 요청이 있음 */
+  struct Request* held;     /* 앞 요청이 끝나길 기다리는 디코딩된 요청 (최대 하나) */
+  bool closing;             /* 처리 완료 후 닫아야 함 */
+  uint32_t registered_events;
+
+  /* 더 받을 수 없는 동안 도착한 나머지 바이트 (순서 보장을 위해 보관) */
+  char* in_buf;
+  size_t in_len;
+
+  /* 수신 상태 */
+  int wire_version; /* hello 전에는 -1, 레거시 클라이언트는 WIRE_VERSION_LEGACY */
+  ReadState read_state;
+  uint8_t header_buf[WIRE_MAX_FRAME_HEADER_SIZE]; /* hello 도 여기에 모음 */
+  size_t header_received;
+  WireFrameHeader header;
+  char* body;
+  size_t body_received;
+
+  /* 송신 대기열: out_queue[out_head .. out_head + out_count) 순서로 전송 */
+  SharedBuffer** out_queue;
+  int out_head;
+  int out_count;
+  int out_cap;
+  size_t out_offset; /* 맨 앞 버퍼에서 이미 보낸 바이트 수 */
+  bool want_write;
+
+  bool is_local; /* 루프백에서 접속 (관리용 MSG_TYPE_METRICS_REQ 허용) */
+  WordStreamCursor word_stream; /* MSG_TYPE_WORD_STREAM_* 위치 (단독 처리 요청에서만 접근) */
+} Connection;
+
+/* 요청 처리 결과 */
+typedef enum {
+  REQUEST_DONE = 0,   /* 응답 준비 완료 */
+  REQUEST_DISCONNECT, /* 응답 후 연결 종료 */
+  REQUEST_DEFERRED    /* 다른 스레드(예: WAL 기록)가 나중에 완료 */
+} RequestResult;
+
+/* 워커로 넘기는 디코딩된 요청 + 처리 결과 */
+typedef struct Request {
+  Connection* conn;
+  WireFrameHeader header;
+  char* body;
+
+  /* 워커가 채우는 응답 프레임 */
+  SharedBuffer* out[MAX_RESPONSE_CHUNKS];
+  int out_count;
+  bool disconnect;
+  bool exclusive; /* 같은 연결의 다른 요청과 겹치지 않게 처리 */
+  uint64_t received_ns; /* 디코딩 완료 시각 (metrics_now_ns, 요청 지연 측정용) */
+
+  struct Request* next; /* 완료 목록 연결용 */
+} Request;
+
+typedef struct Reactor {
+  int index;
+  int epoll_fd;
+  pthread_t tid;
+  int listen_fd;
+  int active_connections;
+  int in_flight_requests;
+  Connection* connections;
+
+  /* 워커 → 리액터 완료 통지 */
+  int wake_fd;
+  pthread_mutex_t done_mutex;
+  Request* done_head;
+  Request* done_tail;
+} Reactor;
+
+static Reactor reactors[MAX_REACTORS];
+static int reactor_count = 0;
+
+static int shutdown_event_fd = -1;
+static volatile sig_atomic_t shutdown_requested = 0;
+
+/* epoll data.ptr 로 연결과 구분하기 위한 태그 */
+static int listen_tag;
+static int shutdown_tag;
+
+static int set_nonblocking(int fd) {
+  int flags = fcntl(fd, F_GETFL, 0);
+  if (flags == -1) return -1;
+  return fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+}
+
+// 새 요청을 더 받을 수 있는지 (대기 중인 요청이 있거나 동시 처리 상한이면 읽기 중단)
+static bool connection_can_read(const Connection* conn) { return conn->held == NULL && conn->in_flight < MAX_PIPELINED_REQUESTS; }
+
+// 연결 상태에 맞게 epoll 관심 이벤트 갱신
+static void update_connection_events(Reactor* reactor, Connection* conn) {
+  if (conn->closing) return;
+
+  uint32_t events = EPOLLRDHUP;
+  if (connection_can_read(conn)) events |= EPOLLIN;
+  if (conn->want_write) events |= EPOLLOUT;
+  if (events == conn->registered_events) return;
+
+  struct epoll_event ev;
+  memset(&ev, 0, sizeof(ev));
+  ev.events = events;
+  ev.data.ptr = conn;
+  if (epoll_ctl(reactor->epoll_fd, EPOLL_CTL_MOD, conn->fd, &ev) == -1) {
+    LOG_ERROR("epoll_ctl(MOD) failed: %m");
+    return;
+  }
+  conn->registered_events = events;
+}
+
+static void free_request(Request* req) {
+  free(req->body);
+  for (int i = 0; i < req->out_count; i++) {
+    shared_buffer_unref(req->out[i]);
+  }
+  free(req);
+}
+
+// 송신 대기열의 남은 버퍼 참조를 모두 해제
+static void release_output_queue(Connection* conn) {
+  for (int i = 0; i < conn->out_count; i++) {
+    shared_buffer_unref(conn->out_queue[conn->out_head + i]);
+  }
+  free(conn->out_queue);
+  conn->out_queue = NULL;
+  conn->out_head = conn->out_count = conn->out_cap = 0;
+  conn->out_offset = 0;
+}
+
+// 송신 대기열 끝에 버퍼 추가 (참조 소유권을 넘겨받음)
+static int enqueue_output(Connection* conn, SharedBuffer* buf) {
+  if (conn->out_head + conn->out_count == conn->out_cap) {
+    if (conn->out_head > 0) {
+      // 앞쪽 빈 자리를 재사용
+      memmove(conn->out_queue, conn->out_queue + conn->out_head, sizeof(SharedBuffer*) * conn->out_count);
+      conn->out_head = 0;
+    } else {
+      int new_cap = conn->out_cap ? conn->out_cap * 2 : MAX_RESPONSE_CHUNKS;
+      SharedBuffer** new_queue = realloc(conn->out_queue, sizeof(SharedBuffer*) * new_cap);
+      if (!new_queue) {
+        return -1;
+      }
+      conn->out_queue = new_queue;
+      conn->out_cap = new_cap;
     }
-    total_sent += sent;
   }
+  conn->out_queue[conn->out_head + conn->out_count++] = buf;
   return 0;
 }
 
-// 정확한 바이트 수만큼 수신하는 함수
-static int recv_all(int sock, void* buf, size_t len) {
-  size_t total_received = 0;
-  char* ptr = (char*)buf;
+static void close_connection(Reactor* reactor, Connection* conn) {
+  // 워커가 아직 요청을 처리 중이면 마지막 완료 통지를 받은 뒤 닫음
+  if (conn->in_flight > 0) {
+    if (!conn->closing) {
+      conn->closing = true;
+      epoll_ctl(reactor->epoll_fd, EPOLL_CTL_DEL, conn->fd, NULL);
+    }
+    return;
+  }
+
+  // 연결 종료 처리
+  if (strlen(conn->current_user) > 0) {
+    LOG_INFO("Cleaning up session for user %s on socket %d due to disconnect/error.", conn->current_user, conn->fd);
+    session_registry_release(conn->current_user, conn->fd);
+  }
 
-  while (total_received < len) {
-    ssize_t received = recv(sock, ptr + total_received, len - total_received, 0);
-    if (received == -1) {
+  LOG_INFO("Client disconnected from socket %d", conn->fd);
+  if (!conn->closing) {
+    epoll_ctl(reactor->epoll_fd, EPOLL_CTL_DEL, conn->fd, NULL);
+  }
+  if (conn->prev) {
+    conn->prev->next = conn->next;
+  } else {
+    reactor->connections = conn->next;
+  }
+  if (conn->next) conn->next->prev = conn->prev;
+  close(conn->fd);
+  free(conn->body);
+  free(conn->in_buf);
+  if (conn->held) free_request(conn->held);
+  release_output_queue(conn);
+  free(conn);
+  reactor->active_connections--;
+  metrics_count(METRIC_CONN_CLOSED, 1);
+}
+
+/*
+ * 송신 대기열을 가능한 만큼 소켓으로 내보냄 (블록하지 않음)
+ * 대기 중인 프레임들을 writev 한 번으로 묶어 보냄
+ * 소켓은 SIGPIPE 를 막기 위해 서버 시작 시 SIG_IGN 처리되어 있음
+ */
+static int flush_connection(Reactor* reactor, Connection* conn) {
+  while (conn->out_count > 0) {
+    struct iovec iov[MAX_WRITEV_CHUNKS];
+    int iov_count = conn->out_count < MAX_WRITEV_CHUNKS ? conn->out_count : MAX_WRITEV_CHUNKS;
+    for (int i = 0; i < iov_count; i++) {
+      SharedBuffer* buf = conn->out_queue[conn->out_head + i];
+      size_t skip = (i == 0) ? conn->out_offset : 0;
+      iov[i].iov_base = buf->data + skip;
+      iov[i].iov_len = buf->len - skip;
+    }
+
+    ssize_t sent = writev(conn->fd, iov, iov_count);
+    if (sent == -1) {
       if (errno == EINTR) continue;  // 시그널에 의한 중단은 재시도
+      if (errno == EAGAIN || errno == EWOULDBLOCK) break;
       return -1;
     }
-    if (received == 0) {
+    if (sent == 0) {
       return -1;  // 연결 종료
     }
-    total_received += received;
+    metrics_count(METRIC_BYTES_OUT, (uint64_t)sent);
+
+    // 다 보낸 버퍼는 참조 해제, 일부만 보낸 버퍼는 오프셋 기록
+    size_t remaining = sent;
+    while (remaining > 0) {
+      SharedBuffer* head = conn->out_queue[conn->out_head];
+      size_t left = head->len - conn->out_offset;
+      if (remaining < left) {
+        conn->out_offset += remaining;
+        break;
+      }
+      remaining -= left;
+      shared_buffer_unref(head);
+      conn->out_head++;
+      conn->out_count--;
+      conn->out_offset = 0;
+    }
+  }
+
+  bool pending = conn->out_count > 0;
+  if (!pending && conn->out_queue) {
+    // 다 보낸 대기열은 해제하여 유휴 연결의 메모리를 일정하게 유지
+    release_output_queue(conn);
+  }
+
+  if (pending != conn->want_write) {
+    conn->want_write = pending;
+    update_connection_events(reactor, conn);
   }
   return 0;
 }
 
-// 응답 전송 함수
-static int send_response(int client_sock, MessageType msg_type, const void* response_data, size_t data_len) {
-  MessageHeader header;
-  header.type = msg_type;
-  header.length = data_len;
+// 이미 인코딩된 프레임을 요청의 결과에 추가 (참조 소유권을 넘겨받음)
+static int send_shared_response(Request* req, SharedBuffer* frame) {
+  if (frame == NULL || req->out_count >= MAX_RESPONSE_CHUNKS) {
+    shared_buffer_unref(frame);
+    return -1;
+  }
+  req->out[req->out_count++] = frame;
+  return 0;
+}
 
-  // 헤더 전송
-  if (send_all(client_sock, &header, sizeof(MessageHeader)) != 0) {
+// 응답을 연결의 프로토콜 버전으로 인코딩해 요청의 결과 버퍼에 추가 (실제 전송은 리액터에서)
+static int send_response(Request* req, MessageType msg_type, const void* response_data, size_t data_len) {
+  return send_shared_response(req, frame_builder_encode(req->conn->wire_version, msg_type, req->header.request_id, response_data, data_len));
+}
+
+// 여러 응답이 공유하는 바디 앞에 이 요청의 헤더를 붙여 추가 (바디 참조 소유권을 넘겨받음)
+static int send_shared_body(Request* req, MessageType msg_type, SharedBuffer* body) {
+  if (body == NULL) {
     return -1;
   }
+  SharedBuffer* header = frame_builder_header(req->conn->wire_version, msg_type, req->header.request_id, body->len);
+  if (send_shared_response(req, header) != 0) {
+    shared_buffer_unref(body);
+    return -1;
+  }
+  return send_shared_response(req, body);
+}
 
-  // 데이터 전송 (있는 경우)
-  if (response_data && data_len > 0) {
-    if (send_all(client_sock, response_data, data_len) != 0) {
-      return -1;
-    }
+/*
+ * 압축 단어 리스트 응답 프레임 (start 번째 단어부터 WORDLIST_PACKED_MAX_BODY 안에 들어가는 만큼)
+ * conditional 이면 조건부 응답 (앞에 status, etag 를 붙인 MSG_TYPE_WORDLIST_COND_RESP)
+ */
+static SharedBuffer* build_packed_wordlist_frame(const WordList* list, int wire_version, uint32_t request_id, uint32_t start,
+                                                 bool conditional) {
+  size_t prefix = conditional ? WORDLIST_COND_HEADER_SIZE : 0;
+  int count;
+  size_t bytes;
+  const uint8_t* words = word_list_packed_range(list, (int)start, WORDLIST_PACKED_MAX_BODY - prefix - WORDLIST_PACKED_HEADER_SIZE, &count, &bytes);
+
+  uint8_t* body;
+  uint32_t type = conditional ? MSG_TYPE_WORDLIST_COND_RESP : MSG_TYPE_WORDLIST_PACKED_RESP;
+  SharedBuffer* frame = frame_builder_alloc(wire_version, type, request_id, prefix + WORDLIST_PACKED_HEADER_SIZE + bytes, &body);
+  if (!frame) {
+    return NULL;
   }
 
-  return 0;
+  if (conditional) {
+    wire_put_u8(body, WORDLIST_COND_MODIFIED);
+    wire_put_u64(body + 1, list->etag);
+    body += prefix;
+  }
+  wire_put_u32(body, (uint32_t)list->count);
+  wire_put_u32(body + 4, start);
+  wire_put_u16(body + 8, (uint16_t)count);
+  if (bytes > 0) {
+    memcpy(body + WORDLIST_PACKED_HEADER_SIZE, words, bytes);
+  }
+  return frame;
 }
 
-// 사용자가 이미 로그인되어 있는지 확인하는 함수
-static int is_user_already_logged_in(const char* username) {
-  int result = -1;
-  pthread_mutex_lock(&logged_in_users_mutex);
-  for (int i = 0; i < MAX_LOGGED_IN_USERS; i++) {
-    if (logged_in_users[i].is_active && strcmp(logged_in_users[i].username, username) == 0) {
-      result = i;
-      break;
-    }
+// 조건부 단어 리스트 요청: 처음부터 받으려는데 etag 가 같으면 목록 없이 not modified 만 응답
+static SharedBuffer* build_conditional_wordlist_frame(const WordList* list, int wire_version, uint32_t request_id, uint32_t start,
+                                                      uint64_t if_none_match) {
+  uint64_t etag = list->etag;
+  if (start != 0 || if_none_match != etag) {
+    return build_packed_wordlist_frame(list, wire_version, request_id, start, true);
   }
-  pthread_mutex_unlock(&logged_in_users_mutex);
-  return result;
+
+  uint8_t* body;
+  SharedBuffer* frame = frame_builder_alloc(wire_version, MSG_TYPE_WORDLIST_COND_RESP, request_id, WORDLIST_COND_HEADER_SIZE, &body);
+  if (!frame) {
+    return NULL;
+  }
+  wire_put_u8(body, WORDLIST_COND_NOT_MODIFIED);
+  wire_put_u64(body + 1, etag);
+  return frame;
 }
 
-// 사용자를 로그인 목록에 추가하는 함수
-static int add_logged_in_user(const char* username, int client_sock) {
-  int result = 0;
-  pthread_mutex_lock(&logged_in_users_mutex);
-  for (int i = 0; i < MAX_LOGGED_IN_USERS; i++) {
-    if (!logged_in_users[i].is_active) {
-      snprintf(logged_in_users[i].username, MAX_ID_LEN, "%s", username);
-      logged_in_users[i].username[MAX_ID_LEN - 1] = '\0';
-      logged_in_users[i].client_sock = client_sock;
-      logged_in_users[i].is_active = true;
-      result = 1;
-      break;
-    }
+// 골라낸 단어 번호들로 표본/스트림 응답 프레임 (아레나에서 [u8 len][bytes] 그대로 복사)
+static SharedBuffer* build_word_picks_frame(const WordList* list, int wire_version, uint32_t type, uint32_t request_id, uint8_t band,
+                                            uint32_t available, const uint32_t* picks, int count) {
+  size_t bytes = 0;
+  for (int i = 0; i < count; i++) {
+    bytes += list->offsets[picks[i] + 1] - list->offsets[picks[i]];
   }
-  pthread_mutex_unlock(&logged_in_users_mutex);
-  return result;
+
+  uint8_t* body;
+  SharedBuffer* frame = frame_builder_alloc(wire_version, type, request_id, WORD_SAMPLE_HEADER_SIZE + bytes, &body);
+  if (!frame) {
+    return NULL;
+  }
+
+  wire_put_u8(body, band);
+  wire_put_u32(body + 1, available);
+  wire_put_u16(body + 5, (uint16_t)count);
+  uint8_t* pos = body + WORD_SAMPLE_HEADER_SIZE;
+  for (int i = 0; i < count; i++) {
+    uint32_t begin = list->offsets[picks[i]];
+    size_t len = list->offsets[picks[i] + 1] - begin;
+    memcpy(pos, list->packed + begin, len);
+    pos += len;
+  }
+  return frame;
 }
 
-// 사용자를 로그인 목록에서 제거하는 함수
-static void remove_logged_in_user(const char* username) {
-  pthread_mutex_lock(&logged_in_users_mutex);
-  for (int i = 0; i < MAX_LOGGED_IN_USERS; i++) {
-    if (logged_in_users[i].is_active && strcmp(logged_in_users[i].username, username) == 0) {
-      logged_in_users[i].is_active = false;
-      memset(logged_in_users[i].username, 0, sizeof(logged_in_users[i].username));
-      break;
-    }
+// 난이도 구간 표본 응답 프레임
+static SharedBuffer* build_word_sample_frame(const WordList* list, int wire_version, uint32_t request_id, const uint8_t* req_body) {
+  uint8_t band = wire_get_u8(req_body);
+  uint32_t picks[WORD_SAMPLE_MAX];
+  uint32_t available;
+  int count = word_list_sample(list, band, wire_get_u8(req_body + 1), wire_get_u8(req_body + 2), picks, wire_get_u16(req_body + 3),
+                               &available);
+  return build_word_picks_frame(list, wire_version, MSG_TYPE_WORD_SAMPLE_RESP, request_id, band, available, picks, count);
+}
+
+// 스트림의 다음 단어들 응답 프레임 (연결의 스트림 위치를 옮김, 단독 처리 요청이라 연결마다 하나씩만 실행)
+static SharedBuffer* build_word_stream_frame(const WordList* list, WordStreamCursor* cursor, int wire_version, uint32_t request_id,
+                                             const uint8_t* req_body) {
+  if ((wire_get_u8(req_body) & WORD_STREAM_RESTART) || cursor->generation == 0) {
+    word_stream_reset(cursor, list, wire_get_u8(req_body + 1));
   }
-  pthread_mutex_unlock(&logged_in_users_mutex);
+  uint32_t picks[WORD_SAMPLE_MAX];
+  uint32_t available;
+  int count = word_stream_next(cursor, list, picks, wire_get_u16(req_body + 2), &available);
+  return build_word_picks_frame(list, wire_version, MSG_TYPE_WORD_STREAM_RESP, request_id, (uint8_t)cursor->band, available, picks, count);
 }
 
-// 서버 시작 시 로그인 사용자 목록 초기화
-void init_logged_in_users() {
-  pthread_mutex_lock(&logged_in_users_mutex);
-  for (int i = 0; i < MAX_LOGGED_IN_USERS; i++) {
-    logged_in_users[i].is_active = false;
-    memset(logged_in_users[i].username, 0, sizeof(logged_in_users[i].username));
+// 요청 바디 크기가 기대한 크기 이상인지 확인
+static bool has_body_of_size(const Request* req, size_t expected) { return req->body != NULL && req->header.length >= expected; }
+
+// 요청 바디를 구조체로 읽음 (레거시는 구조체 그대로, 버전 1 이상은 필드 단위 디코딩)
+static bool read_request_body(const Request* req, void* msg, size_t msg_size) {
+  if (req->conn->wire_version == WIRE_VERSION_LEGACY) {
+    if (!has_body_of_size(req, msg_size)) return false;
+    memcpy(msg, req->body, msg_size);
+    return true;
   }
-  pthread_mutex_unlock(&logged_in_users_mutex);
+  return wire_decode_body(req->header.type, (const uint8_t*)req->body, req->header.length, msg, msg_size) == (long)msg_size;
 }
 
-void* handle_client(void* arg) {
-  int client_sock = *((int*)arg);
-  free(arg);
+static void post_completion(Request* req);
 
-  char current_user[MAX_ID_LEN] = {0};
-  MessageHeader header;
+// 점수 기록 완료 콜백 (WAL 기록 스레드에서 호출)
+static void on_score_submitted(int success, const char* response_msg, void* ctx) {
+  Request* request = (Request*)ctx;
+  ScoreSubmitResponse resp_data;
+  resp_data.success = success;
+  snprintf(resp_data.message, MAX_MSG_LEN, "%s", response_msg);
 
-  printf("[SERVER_NETWORK] Client connected on socket %d\n", client_sock);
+  if (send_response(request, MSG_TYPE_SCORE_SUBMIT_RESP, &resp_data, sizeof(ScoreSubmitResponse)) != 0) {
+    request->disconnect = true;
+  }
+  post_completion(request);
+}
 
-  while (1) {
-    // 헤더 수신
-    if (recv_all(client_sock, &header, sizeof(MessageHeader)) != 0) {
-      if (errno == EINTR) {
-        printf("[SERVER_NETWORK] recv header on socket %d interrupted. Assuming shutdown.\n", client_sock);
-      } else {
-        printf("[SERVER_NETWORK] Failed to receive header from socket %d (user: %s), errno: %d\n", client_sock,
-               strlen(current_user) > 0 ? current_user : "N/A", errno);
+/*
+ * 완성된 메시지 하나를 처리 (워커 스레드에서 실행)
+ * 반환값: 처리 완료 / 연결 종료 필요 / 다른 스레드에서 완료 예정
+ */
+static RequestResult process_message(Request* request) {
+  Connection* conn = request->conn;
+  WireFrameHeader header = request->header;
+  void* message_body = request->body;
+  char* current_user = conn->current_user;
+  int client_sock = conn->fd;
+  bool should_disconnect = false;
+
+  switch (header.type) {
+    case MSG_TYPE_REGISTER_REQ: {
+      RegisterRequest req;
+      if (!read_request_body(request, &req, sizeof(req))) {
+        should_disconnect = true;
+        break;
+      }
+      req.username[MAX_ID_LEN - 1] = '\0';
+      req.password[MAX_PW_LEN - 1] = '\0';
+      RegisterResponse resp_data;
+      resp_data.success = register_user_impl(req.username, req.password, resp_data.message);
+
+      if (send_response(request, MSG_TYPE_REGISTER_RESP, &resp_data, sizeof(RegisterResponse)) != 0) {
+        should_disconnect = true;
       }
       break;
     }
 
-    // 메시지 바디 버퍼 할당
-    void* message_body = NULL;
-    if (header.length > 0) {
-      if (header.length > 10240) {  // 10KB 제한
-        printf("[SERVER_NETWORK] Message too large from socket %d: %d bytes\n", client_sock, header.length);
+    case MSG_TYPE_LOGIN_REQ: {
+      LoginRequest req;
+      if (!read_request_body(request, &req, sizeof(req))) {
+        should_disconnect = true;
         break;
       }
+      req.username[MAX_ID_LEN - 1] = '\0';
+      req.password[MAX_PW_LEN - 1] = '\0';
+      LoginResponse resp_data;
 
-      message_body = malloc(header.length);
-      if (!message_body) {
-        printf("[SERVER_NETWORK] Memory allocation failed for socket %d\n", client_sock);
-        break;
+      // 이 연결의 이전 세션은 먼저 정리 (로그인 결과와 무관하게 등록이 남지 않도록)
+      if (current_user[0] != '\0') {
+        session_registry_release(current_user, client_sock);
+        current_user[0] = '\0';
+      }
+
+      // 이미 로그인된 사용자인지 확인 (비밀번호 확인 전에 빠르게 거절)
+      if (session_registry_contains(req.username)) {
+        resp_data.success = 0;
+        strncpy(resp_data.message, "이 ID는 이미 다른 세션에서 로그인 중입니다.", MAX_MSG_LEN - 1);
+        resp_data.message[MAX_MSG_LEN - 1] = '\0';
+      } else {
+        resp_data.success = login_user_impl(req.username, req.password, resp_data.message, current_user);
+        if (resp_data.success) {
+          // 로그인 성공 시 세션 등록 (그 사이 다른 연결이 같은 ID 로 먼저 등록했으면 실패)
+          int claimed = session_registry_claim(current_user, client_sock);
+          if (claimed != 1) {
+            resp_data.success = 0;
+            current_user[0] = '\0';
+            strncpy(resp_data.message, claimed == 0 ? "이 ID는 이미 다른 세션에서 로그인 중입니다." : "서버 오류로 로그인하지 못했습니다. 나중에 다시 시도하세요.",
+                    MAX_MSG_LEN - 1);
+            resp_data.message[MAX_MSG_LEN - 1] = '\0';
+          } else {
+            LOG_INFO("User '%s' logged in on socket %d.", current_user, client_sock);
+          }
+        } else {
+          current_user[0] = '\0';
+        }
       }
 
-      if (recv_all(client_sock, message_body, header.length) != 0) {
-        printf("[SERVER_NETWORK] Failed to receive body from socket %d\n", client_sock);
-        free(message_body);
+      if (send_response(request, MSG_TYPE_LOGIN_RESP, &resp_data, sizeof(LoginResponse)) != 0) {
+        should_disconnect = true;
+      }
+      break;
+    }
+
+    case MSG_TYPE_SCORE_SUBMIT_REQ: {
+      ScoreSubmitRequest req;
+      if (!read_request_body(request, &req, sizeof(req))) {
+        should_disconnect = true;
         break;
       }
+      ScoreSubmitResponse resp_data;
+
+      if (strlen(current_user) == 0) {
+        resp_data.success = 0;
+        strncpy(resp_data.message, "Not logged in. Cannot submit score.", MAX_MSG_LEN - 1);
+        resp_data.message[MAX_MSG_LEN - 1] = '\0';
+      } else {
+        // 응답은 WAL 그룹 커밋이 끝난 뒤 on_score_submitted 에서 전송
+        submit_score_async(current_user, req.score, on_score_submitted, request);
+        return REQUEST_DEFERRED;
+      }
+
+      if (send_response(request, MSG_TYPE_SCORE_SUBMIT_RESP, &resp_data, sizeof(ScoreSubmitResponse)) != 0) {
+        should_disconnect = true;
+      }
+      break;
     }
 
-    // 메시지 처리
-    bool should_disconnect = false;
+    case MSG_TYPE_LEADERBOARD_REQ: {
+      // 상위 K 가 바뀌지 않았다면 캐시된 바디를 참조만 추가해 그대로 전송
+      if (send_shared_body(request, MSG_TYPE_LEADERBOARD_RESP, leaderboard_cache_get_body(conn->wire_version)) != 0) {
+        should_disconnect = true;
+      }
+      break;
+    }
 
-    switch (header.type) {
-      case MSG_TYPE_REGISTER_REQ: {
-        RegisterRequest* req = (RegisterRequest*)message_body;
-        RegisterResponse resp_data;
-        resp_data.success = register_user_impl(req->username, req->password, resp_data.message);
+    case MSG_TYPE_WORDLIST_REQ: {
+      // 응답 프레임에 복사한 뒤 놓으므로 그 사이 리로드가 일어나도 한 목록만 보임
+      int read_slot;
+      const WordList* list = word_list_acquire(&read_slot);
+      int ret = send_response(request, MSG_TYPE_WORDLIST_RESP, &list->legacy, sizeof(WordListResponse));
+      word_list_release(read_slot);
+      if (ret != 0) {
+        should_disconnect = true;
+      }
+      break;
+    }
 
-        if (send_response(client_sock, MSG_TYPE_REGISTER_RESP, &resp_data, sizeof(RegisterResponse)) != 0) {
-          should_disconnect = true;
-        }
-        break;
+    case MSG_TYPE_WORDLIST_PACKED_REQ: {
+      // 바디가 없으면 처음부터 (바이트 단위로 정의된 바디라 모든 버전에서 동일)
+      uint32_t start = has_body_of_size(request, WORDLIST_PACKED_REQ_SIZE) ? wire_get_u32((const uint8_t*)message_body) : 0;
+      int read_slot;
+      const WordList* list = word_list_acquire(&read_slot);
+      SharedBuffer* frame = build_packed_wordlist_frame(list, conn->wire_version, header.request_id, start, false);
+      word_list_release(read_slot);
+      if (send_shared_response(request, frame) != 0) {
+        should_disconnect = true;
       }
+      break;
+    }
 
-      case MSG_TYPE_LOGIN_REQ: {
-        LoginRequest* req = (LoginRequest*)message_body;
-        LoginResponse resp_data;
+    case MSG_TYPE_WORDLIST_COND_REQ: {
+      const uint8_t* body = (const uint8_t*)message_body;
+      uint32_t start = 0;
+      uint64_t if_none_match = 0;
+      if (has_body_of_size(request, WORDLIST_COND_REQ_SIZE)) {
+        start = wire_get_u32(body);
+        if_none_match = wire_get_u64(body + 4);
+      }
+      int read_slot;
+      const WordList* list = word_list_acquire(&read_slot);
+      SharedBuffer* frame = build_conditional_wordlist_frame(list, conn->wire_version, header.request_id, start, if_none_match);
+      word_list_release(read_slot);
+      if (send_shared_response(request, frame) != 0) {
+        should_disconnect = true;
+      }
+      break;
+    }
 
-        // 이미 로그인된 사용자인지 확인
-        if (is_user_already_logged_in(req->username) != -1) {
-          resp_data.success = 0;
-          strncpy(resp_data.message, "이 ID는 이미 다른 세션에서 로그인 중입니다.", MAX_MSG_LEN - 1);
-          resp_data.message[MAX_MSG_LEN - 1] = '\0';
-        } else {
-          resp_data.success = login_user_impl(req->username, req->password, resp_data.message, current_user);
-          if (resp_data.success) {
-            // 로그인 성공 시 목록에 추가
-            if (!add_logged_in_user(current_user, client_sock)) {
-              // 로그인 목록에 추가 실패 (목록이 꽉 참)
-              resp_data.success = 0;
-              strncpy(current_user, "", MAX_ID_LEN);
-              strncpy(resp_data.message, "서버 로그인 제한에 도달했습니다. 나중에 다시 시도하세요.", MAX_MSG_LEN - 1);
-              resp_data.message[MAX_MSG_LEN - 1] = '\0';
-            } else {
-              printf("[SERVER_NETWORK] User '%s' logged in on socket %d.\n", current_user, client_sock);
-            }
-          } else {
-            current_user[0] = '\0';
-          }
-        }
+    case MSG_TYPE_WORD_SAMPLE_REQ: {
+      // 바디가 모자라면 0 개 요청으로 취급 (조건에 맞는 단어 수만 응답)
+      uint8_t sample_req[WORD_SAMPLE_REQ_SIZE] = {WORD_BAND_ANY, 0, 0, 0, 0};
+      if (has_body_of_size(request, WORD_SAMPLE_REQ_SIZE)) {
+        memcpy(sample_req, message_body, WORD_SAMPLE_REQ_SIZE);
+      }
+      int read_slot;
+      const WordList* list = word_list_acquire(&read_slot);
+      SharedBuffer* frame = build_word_sample_frame(list, conn->wire_version, header.request_id, sample_req);
+      word_list_release(read_slot);
+      if (send_shared_response(request, frame) != 0) {
+        should_disconnect = true;
+      }
+      break;
+    }
 
-        if (send_response(client_sock, MSG_TYPE_LOGIN_RESP, &resp_data, sizeof(LoginResponse)) != 0) {
+    case MSG_TYPE_WORD_STREAM_REQ: {
+      // 바디가 모자라면 이어서 0 개 요청 (구간의 단어 수만 응답)
+      uint8_t stream_req[WORD_STREAM_REQ_SIZE] = {0, WORD_BAND_ANY, 0, 0};
+      if (has_body_of_size(request, WORD_STREAM_REQ_SIZE)) {
+        memcpy(stream_req, message_body, WORD_STREAM_REQ_SIZE);
+      }
+      int read_slot;
+      const WordList* list = word_list_acquire(&read_slot);
+      SharedBuffer* frame = build_word_stream_frame(list, &conn->word_stream, conn->wire_version, header.request_id, stream_req);
+      word_list_release(read_slot);
+      if (send_shared_response(request, frame) != 0) {
+        should_disconnect = true;
+      }
+      break;
+    }
+
+    case MSG_TYPE_METRICS_REQ: {
+      // 관리용: 루프백 연결만 허용
+      size_t text_len = 0;
+      char* text = conn->is_local ? metrics_render(&text_len) : NULL;
+      if (text == NULL || text_len > METRICS_MAX_BODY) {
+        ErrorResponse err_resp;
+        snprintf(err_resp.message, MAX_MSG_LEN, "%s", !conn->is_local ? "Metrics are only available from localhost." : "Metrics unavailable.");
+        free(text);
+        if (send_response(request, MSG_TYPE_ERROR, &err_resp, sizeof(ErrorResponse)) != 0) {
           should_disconnect = true;
         }
         break;
       }
+      uint8_t* body;
+      SharedBuffer* frame = frame_builder_alloc(conn->wire_version, MSG_TYPE_METRICS_RESP, header.request_id, text_len, &body);
+      if (frame) memcpy(body, text, text_len);
+      free(text);
+      if (send_shared_response(request, frame) != 0) {
+        should_disconnect = true;
+      }
+      break;
+    }
 
-      case MSG_TYPE_SCORE_SUBMIT_REQ: {
-        ScoreSubmitRequest* req = (ScoreSubmitRequest*)message_body;
-        ScoreSubmitResponse resp_data;
+    case MSG_TYPE_LOGOUT_REQ: {
+      LogoutResponse resp_data;
+      if (strlen(current_user) > 0) {
+        LOG_INFO("User %s logged out from socket %d.", current_user, client_sock);
+        session_registry_release(current_user, client_sock);
+        memset(conn->current_user, 0, sizeof(conn->current_user));
+        resp_data.success = 1;
+        strncpy(resp_data.message, "Logged out successfully.", MAX_MSG_LEN - 1);
+      } else {
+        resp_data.success = 0;
+        strncpy(resp_data.message, "Not logged in, cannot log out.", MAX_MSG_LEN - 1);
+      }
+      resp_data.message[MAX_MSG_LEN - 1] = '\0';
 
-        if (strlen(current_user) == 0) {
-          resp_data.success = 0;
-          strncpy(resp_data.message, "Not logged in. Cannot submit score.", MAX_MSG_LEN - 1);
-          resp_data.message[MAX_MSG_LEN - 1] = '\0';
-        } else {
-          resp_data.success = submit_score_impl(current_user, req->score, resp_data.message);
-        }
+      if (send_response(request, MSG_TYPE_LOGOUT_RESP, &resp_data, sizeof(LogoutResponse)) != 0) {
+        should_disconnect = true;
+      }
+      break;
+    }
 
-        if (send_response(client_sock, MSG_TYPE_SCORE_SUBMIT_RESP, &resp_data, sizeof(ScoreSubmitResponse)) != 0) {
-          should_disconnect = true;
-        }
-        break;
+    default: {
+      ErrorResponse err_resp;
+      snprintf(err_resp.message, MAX_MSG_LEN, "Unknown or unsupported message type: %u", header.type);
+      LOG_WARN("Error on socket %d: %s", client_sock, err_resp.message);
+
+      if (send_response(request, MSG_TYPE_ERROR, &err_resp, sizeof(ErrorResponse)) != 0) {
+        should_disconnect = true;
       }
+      break;
+    }
+  }
 
-      case MSG_TYPE_LEADERBOARD_REQ: {
-        LeaderboardResponse resp_data;
-        get_leaderboard_impl(resp_data.entries, &resp_data.count, MAX_LEADERBOARD_ENTRIES);
+  return should_disconnect ? REQUEST_DISCONNECT : REQUEST_DONE;
+}
 
-        if (send_response(client_sock, MSG_TYPE_LEADERBOARD_RESP, &resp_data, sizeof(LeaderboardResponse)) != 0) {
-          should_disconnect = true;
+// 처리 결과를 소유 리액터의 완료 목록에 넣고 eventfd 로 깨움
+static void post_completion(Request* req) {
+  Reactor* reactor = req->conn->reactor;
+  req->next = NULL;
+  metrics_record_request(req->header.type, metrics_now_ns() - req->received_ns);
+
+  pthread_mutex_lock(&reactor->done_mutex);
+  if (reactor->done_tail) {
+    reactor->done_tail->next = req;
+  } else {
+    reactor->done_head = req;
+  }
+  reactor->done_tail = req;
+  pthread_mutex_unlock(&reactor->done_mutex);
+
+  uint64_t one = 1;
+  ssize_t ignored = write(reactor->wake_fd, &one, sizeof(one));
+  (void)ignored;
+}
+
+// 워커 스레드 작업: 요청 처리 후 리액터에 결과 반환
+static void execute_request(void* arg) {
+  Request* req = (Request*)arg;
+  RequestResult result = process_message(req);
+  if (result == REQUEST_DEFERRED) {
+    return;  // 완료 콜백에서 post_completion 호출
+  }
+  req->disconnect = (result == REQUEST_DISCONNECT);
+  post_completion(req);
+}
+
+/*
+ * 같은 연결의 다른 요청과 겹치면 안 되는 요청인지
+ * 세션(current_user)을 읽거나 바꾸는 요청은 앞뒤 요청과 순서가 보장되어야 하고,
+ * 요청 ID 가 없는 버전 0 / 1 은 응답 순서로 짝을 맞추므로 모든 요청을 하나씩 처리
+ */
+static bool is_exclusive_request(const Connection* conn, uint32_t type) {
+  if (conn->wire_version < 2) return true;
+  switch (type) {
+    case MSG_TYPE_LOGIN_REQ:
+    case MSG_TYPE_LOGOUT_REQ:
+    case MSG_TYPE_SCORE_SUBMIT_REQ:
+    case MSG_TYPE_WORD_STREAM_REQ:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// 요청을 워커 풀로 넘김
+static int dispatch_request(Connection* conn, Request* req) {
+  conn->in_flight++;
+  if (req->exclusive) conn->exclusive_in_flight = true;
+  conn->reactor->in_flight_requests++;
+
+  // 큐가 가득 차면 여기서 대기 → 이 리액터의 읽기가 멈춰 클라이언트 쪽으로 backpressure 전달
+  if (worker_pool_submit(execute_request, req) != 0) {
+    conn->in_flight--;
+    if (req->exclusive) conn->exclusive_in_flight = false;
+    conn->reactor->in_flight_requests--;
+    free_request(req);
+    return -1;
+  }
+  return 0;
+}
+
+// 지금 처리해도 되는지 (단독 요청은 처리 중인 요청이 없을 때만, 단독 요청 처리 중에는 아무것도 시작하지 않음)
+static bool can_dispatch(const Connection* conn, const Request* req) {
+  if (conn->exclusive_in_flight) return false;
+  return !req->exclusive || conn->in_flight == 0;
+}
+
+/*
+ * 완성된 hello 처리: 버전을 정하고 같은 형식으로 응답
+ * 반환값: 정상 0, 연결을 끊어야 하면 -1
+ */
+static int complete_hello(Connection* conn) {
+  uint16_t client_version = 0;
+  wire_decode_hello(conn->header_buf, &client_version);
+  if (client_version < 1) {
+    LOG_WARN("Unsupported protocol version %u from socket %d", client_version, conn->fd);
+    return -1;
+  }
+  conn->wire_version = client_version < RAIN_PROTOCOL_VERSION ? client_version : RAIN_PROTOCOL_VERSION;
+
+  SharedBuffer* ack = shared_buffer_create(WIRE_HELLO_SIZE);
+  if (!ack) {
+    return -1;
+  }
+  wire_encode_hello((uint8_t*)ack->data, (uint16_t)conn->wire_version);
+  if (enqueue_output(conn, ack) != 0) {
+    shared_buffer_unref(ack);
+    return -1;
+  }
+  return flush_connection(conn->reactor, conn);
+}
+
+/*
+ * 접속 직후 첫 바이트들로 프로토콜 결정
+ * "RAIN" 으로 시작하면 hello 전체를 받아 버전 협상, 아니면 레거시 클라이언트이므로
+ * 이미 받은 바이트를 MessageHeader 의 앞부분으로 그대로 사용
+ * 반환값: 소비한 바이트 수, 연결을 끊어야 하면 -1
+ */
+static long consume_hello(Connection* conn, const char* data, size_t len) {
+  size_t pos = 0;
+  while (pos < len) {
+    bool is_hello = conn->header_received >= 4 && memcmp(conn->header_buf, RAIN_WIRE_MAGIC, 4) == 0;
+    size_t target = is_hello ? WIRE_HELLO_SIZE : 4;
+    size_t need = target - conn->header_received;
+    size_t take = (len - pos < need) ? len - pos : need;
+    memcpy(conn->header_buf + conn->header_received, data + pos, take);
+    conn->header_received += take;
+    pos += take;
+
+    if (conn->header_received < target) break;
+    if (target == 4 && memcmp(conn->header_buf, RAIN_WIRE_MAGIC, 4) == 0) continue;
+
+    if (is_hello) {
+      conn->header_received = 0;
+      if (complete_hello(conn) != 0) return -1;
+    } else {
+      conn->wire_version = WIRE_VERSION_LEGACY;
+    }
+    conn->read_state = READ_STATE_HEADER;
+    break;
+  }
+  return (long)pos;
+}
+
+/*
+ * 수신한 바이트를 상태 머신에 공급하여 프레임을 점진적으로 조립
+ * 헤더/바디가 여러 recv 에 걸쳐 나뉘어 도착해도 처리 가능
+ * 프레임이 완성되면 워커 풀에 넘기고, 처리 중에는 나머지 바이트를 보관
+ * 반환값: 정상 0, 연결을 끊어야 하면 -1
+ */
+static int consume_input(Connection* conn, const char* data, size_t len) {
+  size_t pos = 0;
+
+  while (pos < len && connection_can_read(conn)) {
+    if (conn->read_state == READ_STATE_HELLO) {
+      long used = consume_hello(conn, data + pos, len - pos);
+      if (used < 0) return -1;
+      pos += used;
+      continue;
+    }
+
+    if (conn->read_state == READ_STATE_HEADER) {
+      size_t header_size = wire_frame_header_size(conn->wire_version);
+      size_t need = header_size - conn->header_received;
+      size_t take = (len - pos < need) ? len - pos : need;
+      memcpy(conn->header_buf + conn->header_received, data + pos, take);
+      conn->header_received += take;
+      pos += take;
+
+      if (conn->header_received < header_size) break;
+      wire_decode_frame_header(conn->wire_version, conn->header_buf, &conn->header);
+
+      // 메시지 바디 버퍼 할당
+      if (conn->header.length > 0) {
+        if (conn->header.length > MAX_MESSAGE_BODY_LEN) {
+          LOG_WARN("Message too large from socket %d: %u bytes", conn->fd, conn->header.length);
+          return -1;
         }
-        break;
+        conn->body = malloc(conn->header.length);
+        if (!conn->body) {
+          LOG_ERROR("Memory allocation failed for socket %d", conn->fd);
+          return -1;
+        }
+        conn->body_received = 0;
+        conn->read_state = READ_STATE_BODY;
+        continue;
       }
+    } else {
+      size_t need = conn->header.length - conn->body_received;
+      size_t take = (len - pos < need) ? len - pos : need;
+      memcpy(conn->body + conn->body_received, data + pos, take);
+      conn->body_received += take;
+      pos += take;
 
-      case MSG_TYPE_WORDLIST_REQ: {
-        if (send_response(client_sock, MSG_TYPE_WORDLIST_RESP, &g_wordlist, sizeof(WordListResponse)) != 0) {
-          should_disconnect = true;
-        }
-        break;
+      if (conn->body_received < conn->header.length) break;
+    }
+
+    // 완성된 요청을 워커 풀로 전달 (앞 요청과 겹치면 안 되면 끝날 때까지 보관)
+    Request* req = calloc(1, sizeof(Request));
+    if (!req) {
+      LOG_ERROR("Memory allocation failed for socket %d", conn->fd);
+      return -1;
+    }
+    req->conn = conn;
+    req->header = conn->header;
+    req->body = conn->body;
+    req->exclusive = is_exclusive_request(conn, conn->header.type);
+    req->received_ns = metrics_now_ns();
+
+    conn->body = NULL;
+    conn->body_received = 0;
+    conn->header_received = 0;
+    conn->read_state = READ_STATE_HEADER;
+
+    if (!can_dispatch(conn, req)) {
+      conn->held = req;
+    } else if (dispatch_request(conn, req) != 0) {
+      return -1;
+    }
+  }
+
+  // 더 받을 수 없어 소비하지 못한 바이트는 보관 (다음 요청으로 처리)
+  if (pos < len) {
+    char* rest = malloc(len - pos);
+    if (!rest) return -1;
+    memcpy(rest, data + pos, len - pos);
+    conn->in_buf = rest;
+    conn->in_len = len - pos;
+  }
+  return 0;
+}
+
+// 보관해 둔 입력이 있으면 이어서 처리
+static int resume_pending_input(Connection* conn) {
+  if (conn->in_len == 0) return 0;
+
+  char* pending = conn->in_buf;
+  size_t pending_len = conn->in_len;
+  conn->in_buf = NULL;
+  conn->in_len = 0;
+
+  int result = consume_input(conn, pending, pending_len);
+  free(pending);
+  return result;
+}
+
+// 워커가 처리를 마친 요청의 응답을 송신 버퍼로 옮기고 연결을 재개
+static void complete_request(Reactor* reactor, Request* req) {
+  Connection* conn = req->conn;
+  conn->in_flight--;
+  if (req->exclusive) conn->exclusive_in_flight = false;
+  reactor->in_flight_requests--;
+
+  if (conn->closing) {
+    free_request(req);
+    close_connection(reactor, conn);
+    return;
+  }
+
+  // 응답 프레임 참조를 송신 대기열로 옮김 (복사 없음)
+  for (int i = 0; i < req->out_count; i++) {
+    if (enqueue_output(conn, req->out[i]) != 0) {
+      // 옮기지 못한 프레임은 요청과 함께 해제
+      for (int j = i; j < req->out_count; j++) {
+        shared_buffer_unref(req->out[j]);
       }
+      req->out_count = 0;
+      free_request(req);
+      close_connection(reactor, conn);
+      return;
+    }
+  }
+  req->out_count = 0;
 
-      case MSG_TYPE_LOGOUT_REQ: {
-        LogoutResponse resp_data;
-        if (strlen(current_user) > 0) {
-          printf("[SERVER_NETWORK] User %s logged out from socket %d.\n", current_user, client_sock);
-          remove_logged_in_user(current_user);
-          memset(current_user, 0, sizeof(current_user));
-          resp_data.success = 1;
-          strncpy(resp_data.message, "Logged out successfully.", MAX_MSG_LEN - 1);
-        } else {
-          resp_data.success = 0;
-          strncpy(resp_data.message, "Not logged in, cannot log out.", MAX_MSG_LEN - 1);
-        }
-        resp_data.message[MAX_MSG_LEN - 1] = '\0';
+  bool disconnect = req->disconnect;
+  free_request(req);
 
-        if (send_response(client_sock, MSG_TYPE_LOGOUT_RESP, &resp_data, sizeof(LogoutResponse)) != 0) {
-          should_disconnect = true;
-        }
-        break;
+  if (flush_connection(reactor, conn) != 0 || disconnect) {
+    close_connection(reactor, conn);
+    return;
+  }
+
+  // 기다리던 요청을 시작한 뒤 보관해 둔 입력을 이어서 처리
+  if (conn->held && can_dispatch(conn, conn->held)) {
+    Request* held = conn->held;
+    conn->held = NULL;
+    if (dispatch_request(conn, held) != 0) {
+      close_connection(reactor, conn);
+      return;
+    }
+  }
+  if (connection_can_read(conn) && resume_pending_input(conn) != 0) {
+    close_connection(reactor, conn);
+    return;
+  }
+  update_connection_events(reactor, conn);
+}
+
+static void drain_completions(Reactor* reactor) {
+  uint64_t count;
+  ssize_t ignored = read(reactor->wake_fd, &count, sizeof(count));
+  (void)ignored;
+
+  pthread_mutex_lock(&reactor->done_mutex);
+  Request* req = reactor->done_head;
+  reactor->done_head = reactor->done_tail = NULL;
+  pthread_mutex_unlock(&reactor->done_mutex);
+
+  while (req) {
+    Request* next = req->next;
+    complete_request(reactor, req);
+    req = next;
+  }
+}
+
+static void accept_new_connections(Reactor* reactor) {
+  while (1) {
+    struct sockaddr_in client_addr;
+    socklen_t client_addr_size = sizeof(client_addr);
+    int client_sock = accept4(reactor->listen_fd, (struct sockaddr*)&client_addr, &client_addr_size, SOCK_NONBLOCK | SOCK_CLOEXEC);
+
+    if (client_sock == -1) {
+      if (errno == EINTR) continue;
+      // 다른 리액터가 먼저 가져갔거나 더 이상 대기 연결이 없음
+      if (errno != EAGAIN && errno != EWOULDBLOCK) {
+        LOG_ERROR("accept() error: %m");
       }
+      return;
+    }
 
-      default: {
-        ErrorResponse err_resp;
-        snprintf(err_resp.message, MAX_MSG_LEN, "Unknown or unsupported message type: %d", header.type);
-        printf("[SERVER_NETWORK] Error on socket %d: %s\n", client_sock, err_resp.message);
+    Connection* conn = calloc(1, sizeof(Connection));
+    if (!conn) {
+      LOG_ERROR("calloc for connection failed: %m");
+      close(client_sock);
+      continue;
+    }
+    conn->fd = client_sock;
+    conn->reactor = reactor;
+    conn->wire_version = -1;
+    conn->read_state = READ_STATE_HELLO;
+    conn->registered_events = EPOLLIN | EPOLLRDHUP;
+    conn->is_local = (ntohl(client_addr.sin_addr.s_addr) >> 24) == 127;
 
-        if (send_response(client_sock, MSG_TYPE_ERROR, &err_resp, sizeof(ErrorResponse)) != 0) {
-          should_disconnect = true;
-        }
-        break;
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = conn->registered_events;
+    ev.data.ptr = conn;
+    if (epoll_ctl(reactor->epoll_fd, EPOLL_CTL_ADD, client_sock, &ev) == -1) {
+      LOG_ERROR("epoll_ctl(ADD) failed: %m");
+      close(client_sock);
+      free(conn);
+      continue;
+    }
+
+    conn->next = reactor->connections;
+    if (conn->next) conn->next->prev = conn;
+    reactor->connections = conn;
+    reactor->active_connections++;
+    metrics_count(METRIC_CONN_OPENED, 1);
+    LOG_INFO("Client connected: %s:%d (socket: %d, reactor: %d)", inet_ntoa(client_addr.sin_addr), ntohs(client_addr.sin_port),
+             client_sock, reactor->index);
+  }
+}
+
+static void handle_connection_event(Reactor* reactor, Connection* conn, uint32_t events, char* recv_buf) {
+  if ((events & EPOLLIN) && connection_can_read(conn)) {
+    ssize_t received = recv(conn->fd, recv_buf, RECV_CHUNK_SIZE, 0);
+    if (received == 0) {
+      close_connection(reactor, conn);
+      return;
+    }
+    if (received < 0) {
+      if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+        LOG_WARN("Failed to receive from socket %d (user: %s): %m", conn->fd, strlen(conn->current_user) > 0 ? conn->current_user : "N/A");
+        close_connection(reactor, conn);
+        return;
+      }
+    } else {
+      metrics_count(METRIC_BYTES_IN, (uint64_t)received);
+      if (consume_input(conn, recv_buf, received) != 0) {
+        close_connection(reactor, conn);
+        return;
       }
     }
+  } else if (events & (EPOLLERR | EPOLLHUP | EPOLLRDHUP)) {
+    close_connection(reactor, conn);
+    return;
+  }
 
-    if (message_body) {
-      free(message_body);
+  // EPOLLOUT 이 온 경우 남은 응답 송신
+  if (events & EPOLLOUT) {
+    if (flush_connection(reactor, conn) != 0) {
+      close_connection(reactor, conn);
+      return;
     }
+  }
+  update_connection_events(reactor, conn);
+}
+
+static void* reactor_thread_func(void* arg) {
+  Reactor* reactor = (Reactor*)arg;
+  struct epoll_event events[MAX_EPOLL_EVENTS];
+  char* recv_buf = malloc(RECV_CHUNK_SIZE);
+  if (!recv_buf) {
+    LOG_ERROR("malloc for recv buffer failed: %m");
+    return NULL;
+  }
 
-    if (should_disconnect) {
+  while (!shutdown_requested) {
+    int n = epoll_wait(reactor->epoll_fd, events, MAX_EPOLL_EVENTS, -1);
+    if (n == -1) {
+      if (errno == EINTR) continue;
+      LOG_ERROR("epoll_wait failed: %m");
       break;
     }
-  }
 
-  // 연결 종료 처리
-  if (strlen(current_user) > 0) {
-    printf("[SERVER_NETWORK] Cleaning up session for user %s on socket %d due to disconnect/error.\n", current_user, client_sock);
-    remove_logged_in_user(current_user);
+    for (int i = 0; i < n; i++) {
+      void* tag = events[i].data.ptr;
+      if (tag == &shutdown_tag) {
+        continue;  // 루프 조건에서 종료 처리
+      }
+      if (tag == &listen_tag) {
+        accept_new_connections(reactor);
+        continue;
+      }
+      if (tag == reactor) {
+        drain_completions(reactor);
+        continue;
+      }
+      handle_connection_event(reactor, (Connection*)tag, events[i].events, recv_buf);
+    }
   }
 
-  printf("[SERVER_NETWORK] Client disconnected from socket %d\n", client_sock);
-  close(client_sock);
+  free(recv_buf);
   return NULL;
-}
\ No newline at end of file
+}
+
+static int add_to_epoll(int epoll_fd, int fd, uint32_t events, void* tag) {
+  struct epoll_event ev;
+  memset(&ev, 0, sizeof(ev));
+  ev.events = events;
+  ev.data.ptr = tag;
+  return epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &ev);
+}
+
+static int init_reactor(Reactor* reactor, int index, int listen_fd) {
+  reactor->index = index;
+  reactor->listen_fd = listen_fd;
+  reactor->active_connections = 0;
+  reactor->in_flight_requests = 0;
+  reactor->connections = NULL;
+  reactor->done_head = reactor->done_tail = NULL;
+  pthread_mutex_init(&reactor->done_mutex, NULL);
+
+  reactor->wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  reactor->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+  if (reactor->wake_fd == -1 || reactor->epoll_fd == -1) {
+    LOG_ERROR("eventfd/epoll_create1 failed: %m");
+    goto fail;
+  }
+
+  // 모든 리액터가 같은 listen 소켓을 감시, EPOLLEXCLUSIVE 로 thundering herd 방지
+  // 종료 eventfd 는 레벨 트리거로 등록하여 모든 리액터를 깨움
+  // 완료 eventfd 는 리액터 자신을 태그로 사용
+  if (add_to_epoll(reactor->epoll_fd, listen_fd, EPOLLIN | EPOLLEXCLUSIVE, &listen_tag) == -1 ||
+      add_to_epoll(reactor->epoll_fd, shutdown_event_fd, EPOLLIN, &shutdown_tag) == -1 ||
+      add_to_epoll(reactor->epoll_fd, reactor->wake_fd, EPOLLIN, reactor) == -1) {
+    LOG_ERROR("epoll_ctl(ADD) failed: %m");
+    goto fail;
+  }
+  return 0;
+
+fail:
+  if (reactor->epoll_fd != -1) close(reactor->epoll_fd);
+  if (reactor->wake_fd != -1) close(reactor->wake_fd);
+  pthread_mutex_destroy(&reactor->done_mutex);
+  return -1;
+}
+
+// 종료 시 남은 완료 통지와 연결을 모두 정리 (워커 풀 정지 후 호출)
+static void close_all_connections(Reactor* reactor) {
+  // 워커 밖에서 완료된 요청(WAL 기록 등)의 통지를 처리
+  int waited_ms = 0;
+  drain_completions(reactor);
+  while (reactor->in_flight_requests > 0 && waited_ms < SHUTDOWN_DRAIN_TIMEOUT_MS) {
+    struct pollfd pfd = {reactor->wake_fd, POLLIN, 0};
+    if (poll(&pfd, 1, 100) > 0) {
+      drain_completions(reactor);
+    } else {
+      waited_ms += 100;
+    }
+  }
+  if (reactor->in_flight_requests > 0) {
+    LOG_WARN("Reactor %d: %d requests still pending at shutdown.", reactor->index, reactor->in_flight_requests);
+  }
+
+  while (reactor->connections) {
+    reactor->connections->in_flight = 0;  // 시간 초과 시 강제 정리
+    close_connection(reactor, reactor->connections);
+  }
+  close(reactor->epoll_fd);
+  close(reactor->wake_fd);
+  pthread_mutex_destroy(&reactor->done_mutex);
+}
+
+void request_server_shutdown(void) {
+  shutdown_requested = 1;
+  if (shutdown_event_fd != -1) {
+    uint64_t one = 1;
+    ssize_t ignored = write(shutdown_event_fd, &one, sizeof(one));
+    (void)ignored;
+  }
+}
+
+int run_server_event_loop(int listen_fd, const ServerNetworkConfig* config) {
+  int num_reactors = config->num_reactors;
+  if (num_reactors < 1) num_reactors = 1;
+  if (num_reactors > MAX_REACTORS) num_reactors = MAX_REACTORS;
+
+  if (set_nonblocking(listen_fd) == -1) {
+    LOG_ERROR("Failed to set listen socket non-blocking: %m");
+    return -1;
+  }
+
+  shutdown_event_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (shutdown_event_fd == -1) {
+    LOG_ERROR("eventfd failed: %m");
+    return -1;
+  }
+  if (shutdown_requested) {
+    request_server_shutdown();
+  }
+
+  if (worker_pool_start(config->num_workers, config->queue_capacity) != 0) {
+    close(shutdown_event_fd);
+    shutdown_event_fd = -1;
+    return -1;
+  }
+
+  for (reactor_count = 0; reactor_count < num_reactors; reactor_count++) {
+    if (init_reactor(&reactors[reactor_count], reactor_count, listen_fd) != 0) {
+      break;
+    }
+  }
+  if (reactor_count == 0) {
+    worker_pool_stop();
+    close(shutdown_event_fd);
+    shutdown_event_fd = -1;
+    return -1;
+  }
+
+  // 0번 리액터는 호출 스레드에서 실행
+  for (int i = 1; i < reactor_count; i++) {
+    if (pthread_create(&reactors[i].tid, NULL, reactor_thread_func, &reactors[i]) != 0) {
+      LOG_ERROR("pthread_create() error: %m");
+      reactors[i].tid = 0;
+    }
+  }
+  LOG_INFO("Event loop running with %d reactor thread(s).", reactor_count);
+
+  reactor_thread_func(&reactors[0]);
+
+  for (int i = 1; i < reactor_count; i++) {
+    if (reactors[i].tid != 0) pthread_join(reactors[i].tid, NULL);
+  }
+
+  // 큐에 남은 요청을 모두 처리하고, WAL 에 남은 점수도 기록해 완료 통지를 받은 뒤 연결 정리
+  // (WAL 대기 요청이 가리키는 연결이 해제된 뒤에 통지가 오지 않도록 연결보다 먼저 멈춤)
+  worker_pool_stop();
+  score_wal_stop();
+  for (int i = 0; i < reactor_count; i++) {
+    close_all_connections(&reactors[i]);
+  }
+
+  close(shutdown_event_fd);
+  shutdown_event_fd = -1;
+  return 0;
+}
@@ -0,0 +1,177 @@
+// server/src/session_registry.c
+#include "session_registry.h"
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "hash_util.h"
+#include "protocol.h"
+#include "server_log.h"
+
+#define LOG_MODULE "SESSION_REGISTRY"
+
+/*
+ * 샤드 = open addressing + linear probing 테이블 하나 (user_index.c 의 사용자 인덱스와 같은 방식)
+ * - 해시 상위 비트로 샤드, 하위 비트로 샤드 안의 슬롯을 고름
+ * - 제거 시 뒤쪽 항목을 당겨 채우므로 삭제 표시가 쌓이지 않음
+ * - 샤드마다 캐시 라인을 따로 써서 다른 샤드의 락과 거짓 공유하지 않음
+ */
+#define SESSION_SHARD_COUNT 16 /* 2의 거듭제곱 */
+#define SESSION_SHARD_INITIAL_CAPACITY 16
+#define SESSION_MAX_LOAD_PERCENT 70
+
+typedef struct {
+  char username[MAX_ID_LEN]; /* username[0] == '\0' 이면 빈 슬롯 */
+  uint64_t hash;
+  int client_sock;
+} SessionEntry;
+
+typedef struct {
+  pthread_mutex_t lock;
+  SessionEntry* slots;
+  size_t capacity;
+  size_t count;
+} __attribute__((aligned(64))) SessionShard;
+
+static SessionShard shards[SESSION_SHARD_COUNT] = {
+    [0 ... SESSION_SHARD_COUNT - 1] = {.lock = PTHREAD_MUTEX_INITIALIZER},
+};
+
+static SessionShard* shard_for(uint64_t hash) { return &shards[(hash >> 56) & (SESSION_SHARD_COUNT - 1)]; }
+
+// username 이 있는 슬롯, 없으면 삽입할 빈 슬롯 위치 반환 (slots 가 있어야 함)
+static size_t shard_probe(const SessionShard* shard, const char* username, uint64_t hash) {
+  size_t mask = shard->capacity - 1;
+  size_t pos = hash & mask;
+  while (shard->slots[pos].username[0] != '\0' &&
+         (shard->slots[pos].hash != hash || strcmp(shard->slots[pos].username, username) != 0)) {
+    pos = (pos + 1) & mask;
+  }
+  return pos;
+}
+
+static int shard_resize(SessionShard* shard, size_t new_capacity) {
+  SessionEntry* new_slots = calloc(new_capacity, sizeof(SessionEntry));
+  if (!new_slots) {
+    LOG_ERROR("calloc for session shard failed: %m");
+    return -1;
+  }
+
+  SessionShard grown = {.slots = new_slots, .capacity = new_capacity, .count = 0};
+  for (size_t i = 0; i < shard->capacity; i++) {
+    if (shard->slots[i].username[0] != '\0') {
+      grown.slots[shard_probe(&grown, shard->slots[i].username, shard->slots[i].hash)] = shard->slots[i];
+      grown.count++;
+    }
+  }
+
+  free(shard->slots);
+  shard->slots = grown.slots;
+  shard->capacity = grown.capacity;
+  shard->count = grown.count;
+  return 0;
+}
+
+// 비운 pos 뒤의 연속 구간에서 원래 자리(home)가 빈 칸 이전인 항목을 당겨 탐사 사슬 유지
+static void shard_remove_at(SessionShard* shard, size_t hole) {
+  size_t mask = shard->capacity - 1;
+  for (size_t j = (hole + 1) & mask; shard->slots[j].username[0] != '\0'; j = (j + 1) & mask) {
+    size_t home = shard->slots[j].hash & mask;
+    bool stays = (hole <= j) ? (hole < home && home <= j) : (hole < home || home <= j);
+    if (!stays) {
+      shard->slots[hole] = shard->slots[j];
+      hole = j;
+    }
+  }
+  memset(&shard->slots[hole], 0, sizeof(SessionEntry));
+  shard->count--;
+}
+
+void session_registry_init(void) {
+  for (int i = 0; i < SESSION_SHARD_COUNT; i++) {
+    pthread_mutex_lock(&shards[i].lock);
+    if (shards[i].slots) {
+      memset(shards[i].slots, 0, shards[i].capacity * sizeof(SessionEntry));
+    }
+    shards[i].count = 0;
+    pthread_mutex_unlock(&shards[i].lock);
+  }
+}
+
+void session_registry_destroy(void) {
+  for (int i = 0; i < SESSION_SHARD_COUNT; i++) {
+    pthread_mutex_lock(&shards[i].lock);
+    free(shards[i].slots);
+    shards[i].slots = NULL;
+    shards[i].capacity = 0;
+    shards[i].count = 0;
+    pthread_mutex_unlock(&shards[i].lock);
+  }
+}
+
+bool session_registry_contains(const char* username) {
+  uint64_t hash = hash_string_fnv1a(username);
+  SessionShard* shard = shard_for(hash);
+
+  pthread_mutex_lock(&shard->lock);
+  bool found = shard->slots != NULL && shard->slots[shard_probe(shard, username, hash)].username[0] != '\0';
+  pthread_mutex_unlock(&shard->lock);
+  return found;
+}
+
+int session_registry_claim(const char* username, int client_sock) {
+  uint64_t hash = hash_string_fnv1a(username);
+  SessionShard* shard = shard_for(hash);
+
+  pthread_mutex_lock(&shard->lock);
+  if (shard->slots == NULL || (shard->count + 1) * 100 > shard->capacity * SESSION_MAX_LOAD_PERCENT) {
+    size_t new_capacity = shard->capacity ? shard->capacity * 2 : SESSION_SHARD_INITIAL_CAPACITY;
+    if (shard_resize(shard, new_capacity) != 0) {
+      pthread_mutex_unlock(&shard->lock);
+      return -1;
+    }
+  }
+
+  int result = 0;
+  size_t pos = shard_probe(shard, username, hash);
+  if (shard->slots[pos].username[0] == '\0') {
+    SessionEntry* entry = &shard->slots[pos];
+    snprintf(entry->username, MAX_ID_LEN, "%s", username);
+    entry->hash = hash;
+    entry->client_sock = client_sock;
+    shard->count++;
+    result = 1;
+  }
+  pthread_mutex_unlock(&shard->lock);
+  return result;
+}
+
+bool session_registry_release(const char* username, int client_sock) {
+  uint64_t hash = hash_string_fnv1a(username);
+  SessionShard* shard = shard_for(hash);
+
+  pthread_mutex_lock(&shard->lock);
+  bool removed = false;
+  if (shard->slots != NULL) {
+    size_t pos = shard_probe(shard, username, hash);
+    if (shard->slots[pos].username[0] != '\0' && shard->slots[pos].client_sock == client_sock) {
+      shard_remove_at(shard, pos);
+      removed = true;
+    }
+  }
+  pthread_mutex_unlock(&shard->lock);
+  return removed;
+}
+
+size_t session_registry_count(void) {
+  size_t total = 0;
+  for (int i = 0; i < SESSION_SHARD_COUNT; i++) {
+    pthread_mutex_lock(&shards[i].lock);
+    total += shards[i].count;
+    pthread_mutex_unlock(&shards[i].lock);
+  }
+  return total;
+}
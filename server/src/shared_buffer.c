@@ -0,0 +1,25 @@
+// server/src/shared_buffer.c
+#include "shared_buffer.h"
+
+#include <stdlib.h>
+
+SharedBuffer* shared_buffer_create(size_t len) {
+  SharedBuffer* buf = malloc(sizeof(SharedBuffer) + len);
+  if (!buf) {
+    return NULL;
+  }
+  atomic_init(&buf->refs, 1);
+  buf->len = len;
+  return buf;
+}
+
+SharedBuffer* shared_buffer_ref(SharedBuffer* buf) {
+  atomic_fetch_add_explicit(&buf->refs, 1, memory_order_relaxed);
+  return buf;
+}
+
+void shared_buffer_unref(SharedBuffer* buf) {
+  if (buf && atomic_fetch_sub_explicit(&buf->refs, 1, memory_order_acq_rel) == 1) {
+    free(buf);
+  }
+}
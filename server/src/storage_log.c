@@ -0,0 +1,510 @@
+// server/src/storage_log.c
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/file.h>  // flock()
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "hash_util.h"
+#include "server_log.h"
+#include "server_metrics.h"
+#include "storage_engine.h"
+#include "user_index.h"
+#include "wire_codec.h"
+
+#define LOG_MODULE "STORAGE_LOG"
+
+/*
+ * 추가 전용 로그 백엔드
+ * - users.log(사용자, 가변 길이 레코드)와 scores.log(점수, 고정 길이 레코드)를 시작할 때 열어 두고
+ *   배타적 flock 으로 소유 → 기록마다 open/flock/close 없이 write 한 번 (+ 동기화)
+ * - 레코드마다 체크섬이 있어 비정상 종료로 찢어진 꼬리(마지막 기록 한 번 분량)는 열 때 잘라 냄,
+ *   그보다 많이 깨졌으면 손상으로 보고 열지 않음
+ * - users.log 는 열 때 전부 읽어 메모리 인덱스(user_index)를 만들고,
+ *   scores.log 는 고정 길이라 끝의 레코드만 확인하면 되므로 여는 비용이 기록된 판 수와 무관
+ * - 점수 로그 위치는 scores.log 의 바이트 위치 (파일 헤더 포함)
+ *
+ * 파일 구성 (little-endian):
+ *   파일 헤더 8바이트: "RLOGUSR1" / "RLOGSCR1"
+ *   사용자 레코드: [0] 체크섬(u32) [4] 사용자명 길이(u8) [5] 비밀번호 길이(u8) [6] 예약(u16) [8] 사용자명, 비밀번호
+ *   점수 레코드 40바이트: [0] 체크섬(u32) [4] 점수(i32) [8] 사용자명(MAX_ID_LEN, '\0' 채움)
+ *   체크섬은 레코드의 [4, 끝) 구간 FNV-1a 의 하위 32비트
+ */
+#define LOG_FILE_HEADER_SIZE 8
+#define USERS_LOG_MAGIC "RLOGUSR1"
+#define SCORES_LOG_MAGIC "RLOGSCR1"
+
+#define USER_RECORD_HEADER_SIZE 8
+#define USER_RECORD_MAX_SIZE (USER_RECORD_HEADER_SIZE + MAX_ID_LEN - 1 + MAX_PW_LEN - 1)
+#define SCORE_RECORD_SIZE (8 + MAX_ID_LEN)
+
+#define LOG_READ_BLOCK 65536
+
+typedef struct {
+  char users_path[256];
+  char scores_path[256];
+  int users_fd;
+  int scores_fd;
+
+  pthread_mutex_t users_mutex;  /* users.log 기록 */
+  pthread_mutex_t scores_mutex; /* scores.log 기록 */
+  uint64_t scores_end;          /* 기록을 마친 점수 레코드의 끝 (scores_mutex 아래에서 갱신, 읽기는 원자적) */
+  int max_batch;                /* append_scores 한 번의 최대 레코드 수 */
+
+  UserIndex user_index; /* 조회는 읽기 락, 추가(파일 기록 + 인덱스 삽입)는 쓰기 락 */
+  pthread_rwlock_t user_index_lock;
+} LogStorage;
+
+static uint32_t record_checksum(const uint8_t* data, size_t len) { return (uint32_t)hash_bytes_fnv1a(data, len); }
+
+/* pread 기반 블록 단위 순차 읽기 (레코드가 블록 경계에 걸치면 남은 부분을 앞으로 당겨 이어 읽음) */
+typedef struct {
+  int fd;
+  uint8_t* buf;
+  size_t start;   /* 아직 처리하지 않은 데이터 시작 */
+  size_t end;     /* 버퍼에 채워진 데이터 끝 */
+  uint64_t pos;   /* 다음에 읽을 파일 위치 */
+  uint64_t limit; /* 이 위치까지만 읽음 */
+} BlockReader;
+
+// buf[start] 부터 need 바이트 이상 확보, 반환값: 확보 1, limit 도달 0, 읽기 에러 -1
+static int block_reader_ensure(BlockReader* reader, size_t need) {
+  while (reader->end - reader->start < need) {
+    if (reader->pos >= reader->limit) {
+      return 0;
+    }
+    if (reader->start > 0) {
+      memmove(reader->buf, reader->buf + reader->start, reader->end - reader->start);
+      reader->end -= reader->start;
+      reader->start = 0;
+    }
+    size_t want = LOG_READ_BLOCK - reader->end;
+    if (want > reader->limit - reader->pos) {
+      want = (size_t)(reader->limit - reader->pos);
+    }
+    ssize_t n = pread(reader->fd, reader->buf + reader->end, want, (off_t)reader->pos);
+    if (n < 0) {
+      if (errno == EINTR) continue;
+      return -1;
+    }
+    if (n == 0) {
+      return 0;
+    }
+    reader->end += n;
+    reader->pos += n;
+  }
+  return 1;
+}
+
+static int write_all(int fd, const uint8_t* data, size_t len) {
+  size_t written = 0;
+  while (written < len) {
+    ssize_t n = write(fd, data + written, len - written);
+    if (n < 0) {
+      if (errno == EINTR) continue;
+      return -1;
+    }
+    written += n;
+  }
+  return 0;
+}
+
+static int sync_fd(int fd, DbSyncMode sync_mode) {
+  if (sync_mode == DB_SYNC_NONE) {
+    return 0;
+  }
+  uint64_t sync_start = metrics_now_ns();
+  int result = (sync_mode == DB_SYNC_FDATASYNC) ? fdatasync(fd) : fsync(fd);
+  metrics_record_db(METRIC_DB_FSYNC, metrics_now_ns() - sync_start);
+  return result;
+}
+
+/*
+ * 로그 파일 열기: 배타적 flock 으로 소유하고, 비어 있으면 헤더 기록, 헤더가 다르면 실패
+ * size: 현재 파일 길이
+ * 반환값: fd, 실패 시 -1
+ */
+static int open_log_file(const char* path, const char* magic, uint64_t* size) {
+  int fd = open(path, O_RDWR | O_CREAT | O_APPEND, 0644);
+  if (fd == -1) {
+    LOG_ERROR("Failed to open/create %s: %m", path);
+    return -1;
+  }
+  if (flock(fd, LOCK_EX | LOCK_NB) == -1) {
+    LOG_ERROR("Failed to lock %s (in use by another process?): %m", path);
+    close(fd);
+    return -1;
+  }
+
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    LOG_ERROR("fstat(%s) failed: %m", path);
+    close(fd);
+    return -1;
+  }
+
+  if ((uint64_t)st.st_size < LOG_FILE_HEADER_SIZE) {
+    // 새 파일 (또는 헤더를 쓰다 만 파일)
+    if (ftruncate(fd, 0) != 0 || write_all(fd, (const uint8_t*)magic, LOG_FILE_HEADER_SIZE) != 0 || fsync(fd) != 0) {
+      LOG_ERROR("Failed to initialize %s: %m", path);
+      close(fd);
+      return -1;
+    }
+    *size = LOG_FILE_HEADER_SIZE;
+    return fd;
+  }
+
+  char header[LOG_FILE_HEADER_SIZE];
+  if (pread(fd, header, LOG_FILE_HEADER_SIZE, 0) != LOG_FILE_HEADER_SIZE || memcmp(header, magic, LOG_FILE_HEADER_SIZE) != 0) {
+    LOG_ERROR("%s is not a %.8s log.", path, magic);
+    close(fd);
+    return -1;
+  }
+  *size = (uint64_t)st.st_size;
+  return fd;
+}
+
+// 마지막으로 온전한 레코드 뒤를 잘라 냄
+static int truncate_torn_tail(int fd, const char* path, uint64_t good_end, uint64_t size) {
+  LOG_WARN("Dropping %llu torn byte(s) at the end of %s.", (unsigned long long)(size - good_end), path);
+  if (ftruncate(fd, (off_t)good_end) != 0) {
+    LOG_ERROR("ftruncate(%s) failed: %m", path);
+    return -1;
+  }
+  return 0;
+}
+
+// users.log 전체를 읽어 인덱스 구성, 반환값: 적재한 사용자 수, 실패 시 -1
+static int load_users(LogStorage* store, uint64_t size) {
+  uint8_t* buf = malloc(LOG_READ_BLOCK);
+  if (!buf) {
+    LOG_ERROR("malloc for read buffer failed: %m");
+    return -1;
+  }
+
+  BlockReader reader = {store->users_fd, buf, 0, 0, LOG_FILE_HEADER_SIZE, size};
+  uint64_t good_end = LOG_FILE_HEADER_SIZE;
+  int loaded = 0;
+  int got;
+
+  while ((got = block_reader_ensure(&reader, USER_RECORD_HEADER_SIZE)) > 0) {
+    const uint8_t* p = reader.buf + reader.start;
+    size_t name_len = p[4];
+    size_t password_len = p[5];
+    size_t record_len = USER_RECORD_HEADER_SIZE + name_len + password_len;
+    if (name_len == 0 || name_len >= MAX_ID_LEN || password_len >= MAX_PW_LEN) {
+      break;
+    }
+    if ((got = block_reader_ensure(&reader, record_len)) <= 0) {
+      break;
+    }
+    p = reader.buf + reader.start;
+    if (wire_get_u32(p) != record_checksum(p + 4, record_len - 4)) {
+      break;
+    }
+
+    // 중복된 username 은 먼저 기록된 레코드 우선 (텍스트 백엔드와 같음)
+    UserData user;
+    memset(&user, 0, sizeof(user));
+    memcpy(user.username, p + USER_RECORD_HEADER_SIZE, name_len);
+    memcpy(user.password, p + USER_RECORD_HEADER_SIZE + name_len, password_len);
+    if (user_index_insert(&store->user_index, &user) < 0) {
+      free(buf);
+      return -1;
+    }
+    reader.start += record_len;
+    good_end += record_len;
+    loaded++;
+  }
+  free(buf);
+
+  if (got < 0) {
+    LOG_ERROR("Failed to read %s: %m", store->users_path);
+    return -1;
+  }
+  if (good_end < size) {
+    // 레코드 하나 크기보다 많이 남았으면 찢어진 꼬리가 아니라 손상 (자르지 않고 중단)
+    if (size - good_end > USER_RECORD_MAX_SIZE) {
+      LOG_ERROR("Corrupt record at offset %llu of %s.", (unsigned long long)good_end, store->users_path);
+      return -1;
+    }
+    if (truncate_torn_tail(store->users_fd, store->users_path, good_end, size) != 0) {
+      return -1;
+    }
+  }
+  return loaded;
+}
+
+// 점수 레코드 하나 확인 (체크섬, 사용자명)
+static int score_record_valid(const uint8_t* p) {
+  return wire_get_u32(p) == record_checksum(p + 4, SCORE_RECORD_SIZE - 4) && p[8] != '\0';
+}
+
+/*
+ * scores.log 끝의 찢어진 레코드 정리 (고정 길이라 끝에서부터 확인하면 됨)
+ * 찢어진 기록은 마지막 배치 하나뿐이므로 깨진 레코드가 max_batch 개를 넘으면 자르지 않고 손상으로 처리
+ * 반환값: 정리 후 길이, 실패 시 0
+ */
+static uint64_t recover_scores_tail(LogStorage* store, uint64_t size) {
+  uint64_t good_end = LOG_FILE_HEADER_SIZE + (size - LOG_FILE_HEADER_SIZE) / SCORE_RECORD_SIZE * SCORE_RECORD_SIZE;
+  uint8_t record[SCORE_RECORD_SIZE];
+  int invalid = 0;
+
+  while (good_end > LOG_FILE_HEADER_SIZE) {
+    if (pread(store->scores_fd, record, SCORE_RECORD_SIZE, (off_t)(good_end - SCORE_RECORD_SIZE)) != SCORE_RECORD_SIZE) {
+      LOG_ERROR("Failed to read %s: %m", store->scores_path);
+      return 0;
+    }
+    if (score_record_valid(record)) {
+      break;
+    }
+    if (++invalid > store->max_batch) {
+      LOG_ERROR("Corrupt record at offset %llu of %s (more than %d invalid records at the end).",
+                (unsigned long long)(good_end - SCORE_RECORD_SIZE), store->scores_path, store->max_batch);
+      return 0;
+    }
+    good_end -= SCORE_RECORD_SIZE;
+  }
+
+  if (good_end < size && truncate_torn_tail(store->scores_fd, store->scores_path, good_end, size) != 0) {
+    return 0;
+  }
+  return good_end;
+}
+
+static void log_close(void* state) {
+  LogStorage* store = (LogStorage*)state;
+  if (store == NULL) {
+    return;
+  }
+  if (store->users_fd != -1) close(store->users_fd);  // flock 도 함께 풀림
+  if (store->scores_fd != -1) close(store->scores_fd);
+  pthread_mutex_destroy(&store->users_mutex);
+  pthread_mutex_destroy(&store->scores_mutex);
+  pthread_rwlock_destroy(&store->user_index_lock);
+  user_index_free(&store->user_index);
+  free(store);
+}
+
+static void* log_open(const char* dir, int max_batch) {
+  LogStorage* store = calloc(1, sizeof(LogStorage));
+  if (!store) {
+    LOG_ERROR("calloc for log storage failed: %m");
+    return NULL;
+  }
+  snprintf(store->users_path, sizeof(store->users_path), "%s/users.log", dir);
+  snprintf(store->scores_path, sizeof(store->scores_path), "%s/scores.log", dir);
+  store->users_fd = -1;
+  store->scores_fd = -1;
+  store->max_batch = max_batch > 0 ? max_batch : 1;
+  pthread_mutex_init(&store->users_mutex, NULL);
+  pthread_mutex_init(&store->scores_mutex, NULL);
+  pthread_rwlock_init(&store->user_index_lock, NULL);
+
+  uint64_t users_size, scores_size;
+  store->users_fd = open_log_file(store->users_path, USERS_LOG_MAGIC, &users_size);
+  store->scores_fd = store->users_fd == -1 ? -1 : open_log_file(store->scores_path, SCORES_LOG_MAGIC, &scores_size);
+  if (store->scores_fd == -1 || user_index_init(&store->user_index) != 0) {
+    log_close(store);
+    return NULL;
+  }
+
+  int loaded = load_users(store, users_size);
+  store->scores_end = loaded < 0 ? 0 : recover_scores_tail(store, scores_size);
+  if (loaded < 0 || store->scores_end == 0) {
+    log_close(store);
+    return NULL;
+  }
+
+  LOG_INFO("Opened %s (%d users indexed) and %s (%llu scores).", store->users_path, loaded, store->scores_path,
+           (unsigned long long)((store->scores_end - LOG_FILE_HEADER_SIZE) / SCORE_RECORD_SIZE));
+  return store;
+}
+
+static int log_find_user(void* state, const char* username, UserData* found_user) {
+  LogStorage* store = (LogStorage*)state;
+  if (username == NULL) {
+    return 0;
+  }
+
+  pthread_rwlock_rdlock(&store->user_index_lock);
+  const UserData* user = user_index_find(&store->user_index, username);
+  if (user != NULL && found_user != NULL) {
+    *found_user = *user;
+  }
+  int found = user != NULL;
+  pthread_rwlock_unlock(&store->user_index_lock);
+  return found;
+}
+
+static int log_add_user(void* state, const UserData* user) {
+  LogStorage* store = (LogStorage*)state;
+  size_t name_len = strnlen(user->username, MAX_ID_LEN);
+  size_t password_len = strnlen(user->password, MAX_PW_LEN);
+  if (name_len == 0 || name_len >= MAX_ID_LEN || password_len >= MAX_PW_LEN) {
+    return 0;
+  }
+
+  uint8_t record[USER_RECORD_MAX_SIZE];
+  size_t record_len = USER_RECORD_HEADER_SIZE + name_len + password_len;
+  record[4] = (uint8_t)name_len;
+  record[5] = (uint8_t)password_len;
+  wire_put_u16(record + 6, 0);
+  memcpy(record + USER_RECORD_HEADER_SIZE, user->username, name_len);
+  memcpy(record + USER_RECORD_HEADER_SIZE + name_len, user->password, password_len);
+  wire_put_u32(record, record_checksum(record + 4, record_len - 4));
+
+  // 파일 기록과 인덱스 삽입을 하나의 쓰기 락 안에서 수행하여 둘이 어긋나지 않게 함
+  pthread_rwlock_wrlock(&store->user_index_lock);
+  if (user_index_find(&store->user_index, user->username) != NULL) {
+    pthread_rwlock_unlock(&store->user_index_lock);
+    return 0;  // 동시에 같은 이름으로 가입한 경우
+  }
+
+  storage_lock_mutex(&store->users_mutex);
+  uint64_t write_start = metrics_now_ns();
+  int result = write_all(store->users_fd, record, record_len) == 0;
+  metrics_record_db(METRIC_DB_WRITE, metrics_now_ns() - write_start);
+  if (!result) {
+    LOG_ERROR("add_user: write %s: %m", store->users_path);
+  } else if (sync_fd(store->users_fd, DB_SYNC_FSYNC) != 0) {
+    LOG_ERROR("add_user: fsync %s: %m", store->users_path);
+  }
+  pthread_mutex_unlock(&store->users_mutex);
+
+  if (result && user_index_insert(&store->user_index, user) < 0) {
+    // 파일에는 기록되었으므로 다음 시작 시 인덱스에 반영됨
+    LOG_ERROR("add_user: failed to index '%s'", user->username);
+  }
+  pthread_rwlock_unlock(&store->user_index_lock);
+  return result;
+}
+
+static int log_append_scores(void* state, const ScoreRecord records[], int count, DbSyncMode sync_mode) {
+  LogStorage* store = (LogStorage*)state;
+  if (count <= 0) {
+    return 1;
+  }
+
+  size_t len = (size_t)count * SCORE_RECORD_SIZE;
+  uint8_t* buffer = calloc(count, SCORE_RECORD_SIZE);
+  if (!buffer) {
+    LOG_ERROR("append_scores: calloc: %m");
+    return 0;
+  }
+  for (int i = 0; i < count; i++) {
+    uint8_t* p = buffer + (size_t)i * SCORE_RECORD_SIZE;
+    wire_put_u32(p + 4, (uint32_t)records[i].score);
+    memcpy(p + 8, records[i].username, strnlen(records[i].username, MAX_ID_LEN - 1));
+    wire_put_u32(p, record_checksum(p + 4, SCORE_RECORD_SIZE - 4));
+  }
+
+  storage_lock_mutex(&store->scores_mutex);
+  int result = 1;
+  uint64_t write_start = metrics_now_ns();
+  if (write_all(store->scores_fd, buffer, len) != 0) {
+    LOG_ERROR("append_scores: write %s: %m", store->scores_path);
+    result = 0;
+  }
+  metrics_record_db(METRIC_DB_WRITE, metrics_now_ns() - write_start);
+
+  // 배치당 한 번만 디스크에 동기화
+  if (result && sync_fd(store->scores_fd, sync_mode) != 0) {
+    LOG_ERROR("append_scores: sync %s: %m", store->scores_path);
+    result = 0;
+  }
+
+  if (result) {
+    __atomic_store_n(&store->scores_end, store->scores_end + len, __ATOMIC_RELEASE);
+  } else if (ftruncate(store->scores_fd, (off_t)store->scores_end) != 0) {
+    // 일부만 쓰인 배치를 되돌리지 못하면 다음 시작 때 찢어진 꼬리로 정리됨
+    LOG_ERROR("append_scores: rollback %s: %m", store->scores_path);
+  }
+  pthread_mutex_unlock(&store->scores_mutex);
+
+  free(buffer);
+  return result;
+}
+
+static int log_for_each_score(void* state, uint64_t start_offset, ScoreVisitor visitor, void* ctx, uint64_t* end_offset) {
+  LogStorage* store = (LogStorage*)state;
+  uint64_t end = __atomic_load_n(&store->scores_end, __ATOMIC_ACQUIRE);
+  if (start_offset < LOG_FILE_HEADER_SIZE) {
+    start_offset = LOG_FILE_HEADER_SIZE;
+  }
+  if (start_offset > end || (start_offset - LOG_FILE_HEADER_SIZE) % SCORE_RECORD_SIZE != 0) {
+    return -1;
+  }
+
+  uint8_t* buf = malloc(LOG_READ_BLOCK);
+  if (!buf) {
+    LOG_ERROR("malloc for read buffer failed: %m");
+    return -1;
+  }
+
+  // 이미 기록을 마친 구간만 읽으므로 기록과 동시에 진행해도 됨
+  BlockReader reader = {store->scores_fd, buf, 0, 0, start_offset, end};
+  int count = 0;
+  unsigned long skipped = 0;
+  int got;
+  char username[MAX_ID_LEN];
+  uint64_t read_start = metrics_now_ns();
+
+  while ((got = block_reader_ensure(&reader, SCORE_RECORD_SIZE)) > 0) {
+    const uint8_t* p = reader.buf + reader.start;
+    reader.start += SCORE_RECORD_SIZE;
+    if (!score_record_valid(p)) {
+      skipped++;
+      continue;
+    }
+    memcpy(username, p + 8, MAX_ID_LEN - 1);
+    username[MAX_ID_LEN - 1] = '\0';
+    visitor(username, (int)wire_get_u32(p + 4), ctx);
+    count++;
+  }
+  metrics_record_db(METRIC_DB_READ, metrics_now_ns() - read_start);
+  free(buf);
+
+  if (got < 0) {
+    LOG_ERROR("Failed to read %s: %m", store->scores_path);
+    return -1;
+  }
+  if (skipped > 0) {
+    LOG_WARN("Skipped %lu corrupt record(s) in %s.", skipped, store->scores_path);
+  }
+  if (end_offset) {
+    *end_offset = end;
+  }
+  return count;
+}
+
+static int log_score_log_size(void* state, uint64_t* size) {
+  LogStorage* store = (LogStorage*)state;
+  *size = __atomic_load_n(&store->scores_end, __ATOMIC_ACQUIRE);
+  return 0;
+}
+
+static int log_score_log_fingerprint(void* state, uint64_t offset, uint64_t* fingerprint) {
+  LogStorage* store = (LogStorage*)state;
+  if (offset > __atomic_load_n(&store->scores_end, __ATOMIC_ACQUIRE)) {
+    return -1;
+  }
+  return storage_fingerprint_fd(store->scores_fd, offset, fingerprint);
+}
+
+const StorageEngine storage_log_engine = {
+    .name = "log",
+    .open = log_open,
+    .close = log_close,
+    .find_user = log_find_user,
+    .add_user = log_add_user,
+    .append_scores = log_append_scores,
+    .for_each_score = log_for_each_score,
+    .score_log_size = log_score_log_size,
+    .score_log_fingerprint = log_score_log_fingerprint,
+};
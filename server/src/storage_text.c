@@ -0,0 +1,436 @@
+// server/src/storage_text.c
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/file.h>  // flock()
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include "line_reader.h"
+#include "server_log.h"
+#include "server_metrics.h"
+#include "storage_engine.h"
+#include "user_index.h"
+
+#define LOG_MODULE "STORAGE_TEXT"
+
+/*
+ * 텍스트 파일 백엔드
+ * - users.txt: username:password 줄, scores.txt: username:score 줄 (둘 다 추가 전용)
+ * - 기록마다 파일을 열고 flock 을 건 뒤 닫으므로 외부 도구로 파일을 같이 읽거나 고쳐도 안전
+ * - 점수 로그 위치는 scores.txt 의 바이트 위치
+ */
+
+typedef struct {
+  char users_path[256];
+  char scores_path[256];
+
+  // 파일 접근 동기화를 위한 mutex들
+  pthread_mutex_t users_file_mutex;
+  pthread_mutex_t scores_file_mutex;
+
+  UserIndex user_index; /* 조회는 읽기 락, 추가(파일 기록 + 인덱스 삽입)는 쓰기 락 */
+  pthread_rwlock_t user_index_lock;
+} TextStorage;
+
+// users.txt 전체를 읽어 인덱스 구성 (시작 시 1회)
+static int load_user_index(TextStorage *store) {
+  int fd = open(store->users_path, O_RDONLY);
+  if (fd == -1) {
+    if (errno == ENOENT) {
+      return 0;  // 파일이 없음 = 사용자 없음
+    }
+    LOG_ERROR("Failed to open users file for indexing: %m");
+    return -1;
+  }
+
+  if (flock(fd, LOCK_SH) == -1) {
+    LOG_ERROR("Failed to acquire shared lock on users file: %m");
+    close(fd);
+    return -1;
+  }
+
+  LineReader reader;
+  if (line_reader_init(&reader, fd, 0) != 0) {
+    LOG_ERROR("Failed to allocate line reader: %m");
+    flock(fd, LOCK_UN);
+    close(fd);
+    return -1;
+  }
+
+  UserData current_user;
+  char *line_buffer;
+  size_t line_length;
+  int loaded = 0;
+  int read_result;
+
+  while ((read_result = line_reader_next(&reader, &line_buffer, &line_length)) > 0) {
+    // username:password 형태 파싱
+    char *colon_pos = strchr(line_buffer, ':');
+    if (colon_pos == NULL) {
+      continue;  // 잘못된 형식의 줄은 건너뛰기
+    }
+
+    *colon_pos = '\0';  // username 부분 분리
+    char *password_part = colon_pos + 1;
+
+    // 길이 체크 및 복사 (중복된 username 은 먼저 기록된 줄 우선)
+    if (line_buffer[0] != '\0' && strlen(line_buffer) < MAX_ID_LEN && strlen(password_part) < MAX_PW_LEN) {
+      memset(&current_user, 0, sizeof(current_user));
+      strncpy(current_user.username, line_buffer, MAX_ID_LEN - 1);
+      strncpy(current_user.password, password_part, MAX_PW_LEN - 1);
+      if (user_index_insert(&store->user_index, &current_user) < 0) {
+        loaded = -1;
+        break;
+      }
+      loaded++;
+    }
+  }
+  if (read_result < 0) {
+    LOG_ERROR("Failed to read users file: %m");
+    loaded = -1;
+  }
+
+  line_reader_free(&reader);
+  flock(fd, LOCK_UN);  // 락 해제
+  close(fd);
+  return loaded;
+}
+
+static void text_close(void *state) {
+  TextStorage *store = (TextStorage *)state;
+  if (store == NULL) {
+    return;
+  }
+  pthread_mutex_destroy(&store->users_file_mutex);
+  pthread_mutex_destroy(&store->scores_file_mutex);
+  pthread_rwlock_destroy(&store->user_index_lock);
+  user_index_free(&store->user_index);
+  free(store);
+}
+
+// 파일이 없으면 빈 파일 생성
+static int touch_file(const char *path) {
+  int fd = open(path, O_WRONLY | O_CREAT | O_APPEND, 0644);
+  if (fd == -1) {
+    LOG_ERROR("Failed to open/create %s: %m", path);
+    return -1;
+  }
+  close(fd);
+  return 0;
+}
+
+static void *text_open(const char *dir, int max_batch) {
+  (void)max_batch;  // 줄 단위 파일은 꼬리를 검사하지 않음
+  TextStorage *store = calloc(1, sizeof(TextStorage));
+  if (!store) {
+    LOG_ERROR("calloc for text storage failed: %m");
+    return NULL;
+  }
+  snprintf(store->users_path, sizeof(store->users_path), "%s/users.txt", dir);
+  snprintf(store->scores_path, sizeof(store->scores_path), "%s/scores.txt", dir);
+  pthread_mutex_init(&store->users_file_mutex, NULL);
+  pthread_mutex_init(&store->scores_file_mutex, NULL);
+  pthread_rwlock_init(&store->user_index_lock, NULL);
+
+  if (touch_file(store->users_path) != 0 || touch_file(store->scores_path) != 0) {
+    text_close(store);
+    return NULL;
+  }
+  LOG_INFO("Checked/Initialized data files: %s, %s", store->users_path, store->scores_path);
+
+  // 사용자 인덱스 적재
+  int loaded = user_index_init(&store->user_index) == 0 ? load_user_index(store) : -1;
+  if (loaded < 0) {
+    LOG_ERROR("Could not build user index from %s.", store->users_path);
+    text_close(store);
+    return NULL;
+  }
+  LOG_INFO("Indexed %d users in memory.", loaded);
+  return store;
+}
+
+static int text_find_user(void *state, const char *username, UserData *found_user) {
+  TextStorage *store = (TextStorage *)state;
+  if (username == NULL) {
+    return 0;
+  }
+
+  pthread_rwlock_rdlock(&store->user_index_lock);
+  const UserData *user = user_index_find(&store->user_index, username);
+  if (user != NULL && found_user != NULL) {
+    *found_user = *user;
+  }
+  int found = user != NULL;
+
+  pthread_rwlock_unlock(&store->user_index_lock);
+  return found;
+}
+
+static int append_user_line(TextStorage *store, const UserData *user) {
+  storage_lock_mutex(&store->users_file_mutex);
+
+  int fd = open(store->users_path, O_WRONLY | O_CREAT | O_APPEND, 0644);
+  if (fd == -1) {
+    LOG_ERROR("add_user: open users.txt: %m");
+    pthread_mutex_unlock(&store->users_file_mutex);
+    return 0;
+  }
+
+  // 파일 락 적용 (배타적 락)
+  if (flock(fd, LOCK_EX) == -1) {
+    LOG_ERROR("Failed to acquire exclusive lock on users file: %m");
+    close(fd);
+    pthread_mutex_unlock(&store->users_file_mutex);
+    return 0;
+  }
+
+  uint64_t write_start = metrics_now_ns();
+  int bytes_written = dprintf(fd, "%s:%s\n", user->username, user->password);
+  metrics_record_db(METRIC_DB_WRITE, metrics_now_ns() - write_start);
+  if (bytes_written <= 0) {
+    LOG_ERROR("add_user: write users.txt: %m");
+    flock(fd, LOCK_UN);
+    close(fd);
+    pthread_mutex_unlock(&store->users_file_mutex);
+    return 0;
+  }
+
+  // 즉시 디스크에 쓰기 (안전성 향상)
+  uint64_t sync_start = metrics_now_ns();
+  if (fsync(fd) != 0) {
+    LOG_ERROR("add_user: fsync users.txt: %m");
+  }
+  metrics_record_db(METRIC_DB_FSYNC, metrics_now_ns() - sync_start);
+
+  flock(fd, LOCK_UN);  // 락 해제
+  if (close(fd) != 0) {
+    LOG_ERROR("add_user: close users.txt: %m");
+    pthread_mutex_unlock(&store->users_file_mutex);
+    return 0;
+  }
+
+  pthread_mutex_unlock(&store->users_file_mutex);
+  return 1;
+}
+
+static int text_add_user(void *state, const UserData *user) {
+  TextStorage *store = (TextStorage *)state;
+
+  // 파일 기록과 인덱스 삽입을 하나의 쓰기 락 안에서 수행하여 둘이 어긋나지 않게 함
+  pthread_rwlock_wrlock(&store->user_index_lock);
+  if (user_index_find(&store->user_index, user->username) != NULL) {
+    pthread_rwlock_unlock(&store->user_index_lock);
+    return 0;  // 동시에 같은 이름으로 가입한 경우
+  }
+
+  int result = append_user_line(store, user);
+  if (result && user_index_insert(&store->user_index, user) < 0) {
+    // 파일에는 기록되었으므로 다음 시작 시 인덱스에 반영됨
+    LOG_ERROR("add_user: failed to index '%s'", user->username);
+  }
+
+  pthread_rwlock_unlock(&store->user_index_lock);
+  return result;
+}
+
+static int text_append_scores(void *state, const ScoreRecord records[], int count, DbSyncMode sync_mode) {
+  TextStorage *store = (TextStorage *)state;
+  if (count <= 0) {
+    return 1;
+  }
+
+  // 배치 전체를 한 버퍼로 직렬화
+  size_t buffer_size = (size_t)count * (MAX_ID_LEN + 16);
+  char *buffer = malloc(buffer_size);
+  if (!buffer) {
+    LOG_ERROR("append_scores: malloc: %m");
+    return 0;
+  }
+  size_t used = 0;
+  for (int i = 0; i < count; i++) {
+    used += snprintf(buffer + used, buffer_size - used, "%s:%d\n", records[i].username, records[i].score);
+  }
+
+  storage_lock_mutex(&store->scores_file_mutex);
+
+  int fd = open(store->scores_path, O_WRONLY | O_CREAT | O_APPEND, 0644);
+  if (fd == -1) {
+    LOG_ERROR("append_scores: open scores.txt: %m");
+    pthread_mutex_unlock(&store->scores_file_mutex);
+    free(buffer);
+    return 0;
+  }
+
+  // 파일 락 적용 (배타적 락)
+  if (flock(fd, LOCK_EX) == -1) {
+    LOG_ERROR("Failed to acquire exclusive lock on scores file: %m");
+    close(fd);
+    pthread_mutex_unlock(&store->scores_file_mutex);
+    free(buffer);
+    return 0;
+  }
+
+  int result = 1;
+  size_t written = 0;
+  uint64_t write_start = metrics_now_ns();
+  while (written < used) {
+    ssize_t n = write(fd, buffer + written, used - written);
+    if (n < 0) {
+      if (errno == EINTR) continue;
+      LOG_ERROR("append_scores: write scores.txt: %m");
+      result = 0;
+      break;
+    }
+    written += n;
+  }
+  metrics_record_db(METRIC_DB_WRITE, metrics_now_ns() - write_start);
+
+  // 배치당 한 번만 디스크에 동기화
+  if (result && sync_mode != DB_SYNC_NONE) {
+    uint64_t sync_start = metrics_now_ns();
+    int sync_result = 0;
+    if (sync_mode == DB_SYNC_FSYNC) {
+      sync_result = fsync(fd);
+    } else if (sync_mode == DB_SYNC_FDATASYNC) {
+      sync_result = fdatasync(fd);
+    }
+    metrics_record_db(METRIC_DB_FSYNC, metrics_now_ns() - sync_start);
+    if (sync_result != 0) {
+      LOG_ERROR("append_scores: sync scores.txt: %m");
+      result = 0;
+    }
+  }
+
+  flock(fd, LOCK_UN);  // 락 해제
+  if (close(fd) != 0) {
+    LOG_ERROR("append_scores: close scores.txt: %m");
+    result = 0;
+  }
+
+  pthread_mutex_unlock(&store->scores_file_mutex);
+  free(buffer);
+  return result;
+}
+
+static int text_for_each_score(void *state, uint64_t start_offset, ScoreVisitor visitor, void *ctx, uint64_t *end_offset) {
+  TextStorage *store = (TextStorage *)state;
+  storage_lock_mutex(&store->scores_file_mutex);
+
+  int fd = open(store->scores_path, O_RDONLY);
+  if (fd == -1) {
+    pthread_mutex_unlock(&store->scores_file_mutex);
+    if (errno == ENOENT && start_offset == 0) {
+      if (end_offset) *end_offset = 0;
+      return 0;  // 파일이 없음 = 점수 없음
+    }
+    return -1;  // 다른 에러
+  }
+
+  // 파일 락 적용 (공유 락)
+  if (flock(fd, LOCK_SH) == -1) {
+    LOG_ERROR("Failed to acquire shared lock on scores file: %m");
+    close(fd);
+    pthread_mutex_unlock(&store->scores_file_mutex);
+    return -1;
+  }
+
+  // 공유 락을 잡은 동안에는 기록이 없으므로 지금 길이가 이번에 읽을 구간의 끝
+  struct stat st;
+  if (fstat(fd, &st) != 0 || (uint64_t)st.st_size < start_offset ||
+      (start_offset > 0 && lseek(fd, (off_t)start_offset, SEEK_SET) == (off_t)-1)) {
+    flock(fd, LOCK_UN);
+    close(fd);
+    pthread_mutex_unlock(&store->scores_file_mutex);
+    return -1;
+  }
+
+  LineReader reader;
+  if (line_reader_init(&reader, fd, 0) != 0) {
+    LOG_ERROR("Failed to allocate line reader: %m");
+    flock(fd, LOCK_UN);
+    close(fd);
+    pthread_mutex_unlock(&store->scores_file_mutex);
+    return -1;
+  }
+
+  int count = 0;
+  char *line_buffer;
+  size_t line_length;
+  int read_result;
+  uint64_t read_start = metrics_now_ns();
+
+  while ((read_result = line_reader_next(&reader, &line_buffer, &line_length)) > 0) {
+    // username:score 형태 파싱
+    char *colon_pos = strchr(line_buffer, ':');
+    if (colon_pos == NULL || colon_pos == line_buffer || colon_pos - line_buffer >= MAX_ID_LEN) {
+      continue;  // 잘못된 형식의 줄은 건너뛰기
+    }
+
+    *colon_pos = '\0';  // username 부분 분리
+    char *score_part = colon_pos + 1;
+
+    char *endptr;
+    long score_value = strtol(score_part, &endptr, 10);
+    if (endptr != score_part && *endptr == '\0') {  // 성공적으로 파싱됨
+      visitor(line_buffer, (int)score_value, ctx);
+      count++;
+    }
+  }
+  if (read_result < 0) {
+    LOG_ERROR("Failed to read scores file: %m");
+    count = -1;
+  } else if (end_offset) {
+    *end_offset = (uint64_t)st.st_size;
+  }
+
+  metrics_record_db(METRIC_DB_READ, metrics_now_ns() - read_start);
+
+  line_reader_free(&reader);
+  flock(fd, LOCK_UN);  // 락 해제
+  close(fd);
+  pthread_mutex_unlock(&store->scores_file_mutex);
+  return count;
+}
+
+static int text_score_log_size(void *state, uint64_t *size) {
+  TextStorage *store = (TextStorage *)state;
+  struct stat st;
+  if (stat(store->scores_path, &st) != 0) {
+    if (errno == ENOENT) {
+      *size = 0;
+      return 0;
+    }
+    return -1;
+  }
+  *size = (uint64_t)st.st_size;
+  return 0;
+}
+
+static int text_score_log_fingerprint(void *state, uint64_t offset, uint64_t *fingerprint) {
+  TextStorage *store = (TextStorage *)state;
+  int fd = open(store->scores_path, O_RDONLY);
+  if (fd == -1) {
+    return -1;
+  }
+  int result = storage_fingerprint_fd(fd, offset, fingerprint);
+  close(fd);
+  return result;
+}
+
+const StorageEngine storage_text_engine = {
+    .name = "text",
+    .open = text_open,
+    .close = text_close,
+    .find_user = text_find_user,
+    .add_user = text_add_user,
+    .append_scores = text_append_scores,
+    .for_each_score = text_for_each_score,
+    .score_log_size = text_score_log_size,
+    .score_log_fingerprint = text_score_log_fingerprint,
+};
@@ -0,0 +1,74 @@
+// server/src/user_index.c
+#include "user_index.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "hash_util.h"
+#include "server_log.h"
+
+#define LOG_MODULE "USER_INDEX"
+
+#define USER_INDEX_INITIAL_CAPACITY 1024 /* 2의 거듭제곱 */
+#define USER_INDEX_MAX_LOAD_PERCENT 70
+
+// username 이 있는 슬롯, 없으면 삽입할 빈 슬롯 위치 반환
+static size_t user_index_probe(const UserIndex* index, const char* username) {
+  size_t mask = index->capacity - 1;
+  size_t pos = hash_string_fnv1a(username) & mask;
+  while (index->slots[pos].username[0] != '\0' && strcmp(index->slots[pos].username, username) != 0) {
+    pos = (pos + 1) & mask;
+  }
+  return pos;
+}
+
+static int user_index_resize(UserIndex* index, size_t new_capacity) {
+  UserData* new_slots = calloc(new_capacity, sizeof(UserData));
+  if (!new_slots) {
+    LOG_ERROR("calloc for user index failed: %m");
+    return -1;
+  }
+
+  UserIndex grown = {new_slots, new_capacity, 0};
+  for (size_t i = 0; i < index->capacity; i++) {
+    if (index->slots[i].username[0] != '\0') {
+      grown.slots[user_index_probe(&grown, index->slots[i].username)] = index->slots[i];
+      grown.count++;
+    }
+  }
+
+  free(index->slots);
+  *index = grown;
+  return 0;
+}
+
+int user_index_init(UserIndex* index) {
+  memset(index, 0, sizeof(*index));
+  return user_index_resize(index, USER_INDEX_INITIAL_CAPACITY);
+}
+
+const UserData* user_index_find(const UserIndex* index, const char* username) {
+  const UserData* slot = &index->slots[user_index_probe(index, username)];
+  return slot->username[0] != '\0' ? slot : NULL;
+}
+
+int user_index_insert(UserIndex* index, const UserData* user) {
+  if ((index->count + 1) * 100 > index->capacity * USER_INDEX_MAX_LOAD_PERCENT) {
+    if (user_index_resize(index, index->capacity * 2) != 0) {
+      return -1;
+    }
+  }
+
+  size_t pos = user_index_probe(index, user->username);
+  if (index->slots[pos].username[0] != '\0') {
+    return 0;
+  }
+  index->slots[pos] = *user;
+  index->count++;
+  return 1;
+}
+
+void user_index_free(UserIndex* index) {
+  free(index->slots);
+  memset(index, 0, sizeof(*index));
+}
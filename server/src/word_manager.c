@@ -1,21 +1,50 @@
 /********************************************************************
   server/src/word_manager.c
-  ─ words.txt(UTF-8) → g_wordlist 로드
+  ─ words.txt(UTF-8) → 불변 단어 목록(WordList) 로드 / 리로드
 
    1) 파일이 없으면 data/words.txt 를 새로 만들고 기본 단어 목록 저장
    2) 파일이 있지만 내용이 비어 있으면 기본 목록으로 채움
+   3) 실행 중 파일이 바뀌면 새 목록을 만들어 포인터 교체로 게시
  ********************************************************************/
 #include "word_manager.h"
 
+#include <ctype.h>
 #include <errno.h> /* ENOENT 확인용 */
 #include <fcntl.h> /* open() 플래그들 */
+#include <libgen.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdbool.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <sys/mman.h>
 #include <sys/stat.h> /* stat() */
-#include <unistd.h>   /* read(), write(), close() */
+#include <time.h>
+#include <unistd.h> /* read(), write(), close() */
 
-/* 전역 단어 리스트 (프로토콜 정의) */
-WordListResponse g_wordlist;
+#include "server_log.h"
+#include "wire_codec.h"
+
+#define LOG_MODULE "WORD_MANAGER"
+
+/*
+ * 현재 게시된 목록과 읽기 구간 카운터 (SRCU 방식)
+ * - 읽는 쪽: 현재 epoch 의 카운터를 올리고 포인터를 읽은 뒤, 다 쓰면 같은 카운터를 내림 (락 없음)
+ * - 게시하는 쪽: 포인터를 교체한 뒤 epoch 를 두 번 넘기며 각 카운터가 0 이 되길 기다렸다가 이전 목록 해제
+ *   (epoch 를 넘기면 새 읽기는 다른 카운터로 가므로 읽기가 계속 들어와도 기다림이 끝남)
+ * 게시는 시작 시 로드와 감시 스레드만 하므로 게시하는 쪽끼리는 겹치지 않음
+ */
+typedef struct {
+  unsigned long count;
+  char pad[64 - sizeof(unsigned long)]; /* 두 카운터를 다른 캐시 라인에 */
+} ReaderCount;
+
+static WordList* current_list = NULL;
+static ReaderCount reader_counts[2];
+static unsigned int reader_epoch = 0;
 
 /* ─── 기본 단어 목록 (원하면 자유롭게 수정) ─── */
 static const char* default_words[] = {"hello", "world",  "rain",    "typing", "keyboard",  "program", "linux", "thread",
@@ -26,51 +55,24 @@ static const char* default_words[] = {"hello", "world",  "rain",    "typing", "k
  *  유틸리티 함수들
  * ------------------------------------------------------------- */
 
-// 한 줄씩 읽기 위한 함수
-static ssize_t read_line_direct(int fd, char* buffer, size_t buffer_size) {
-  size_t pos = 0;
-  char ch;
-  ssize_t bytes_read;
-
-  while (pos < buffer_size - 1) {
-    bytes_read = read(fd, &ch, 1);
-    if (bytes_read == 0) {     // EOF
-      if (pos == 0) return 0;  // 아무것도 읽지 못함
-      break;
-    }
-    if (bytes_read < 0) {  // 에러
-      return -1;
-    }
-
-    if (ch == '\n') {
-      break;
-    }
-
-    buffer[pos++] = ch;
-  }
-
-  buffer[pos] = '\0';
-  return pos;
-}
-
 // 기본 단어 목록을 파일에 쓰기
 static int write_default_words_to_file(const char* path) {
   int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
   if (fd == -1) {
-    perror("[WORD_MANAGER] Failed to create default words file");
+    LOG_ERROR("Failed to create default words file: %m");
     return -1;
   }
 
   for (size_t i = 0; i < DEFAULT_WORD_COUNT; ++i) {
     if (dprintf(fd, "%s\n", default_words[i]) <= 0) {
-      perror("[WORD_MANAGER] Failed to write default word");
+      LOG_ERROR("Failed to write default word: %m");
       close(fd);
       return -1;
     }
   }
 
   if (close(fd) != 0) {
-    perror("[WORD_MANAGER] Failed to close default words file");
+    LOG_ERROR("Failed to close default words file: %m");
     return -1;
   }
 
@@ -86,9 +88,372 @@ static int is_file_empty(const char* path) {
   return (st.st_size == 0) ? 1 : 0;
 }
 
+/* ---------------------------------------------------------------
+ *  목록 만들기 / 게시
+ * ------------------------------------------------------------- */
+
+static void free_word_list(WordList* list) {
+  if (!list) return;
+  free(list->packed);
+  free(list->offsets);
+  free(list->difficulty);
+  free(list->by_band_length);
+  free(list);
+}
+
+// 압축 저장소 끝에 단어 하나 추가 (용량은 packed_cap / offsets_cap 에 유지)
+static int append_packed_word(WordList* list, size_t* packed_cap, int* offsets_cap, const char* word, size_t len, uint8_t difficulty) {
+  if (list->packed_len + 1 + len > *packed_cap) {
+    size_t new_cap = *packed_cap ? *packed_cap * 2 : 4096;
+    while (new_cap < list->packed_len + 1 + len) new_cap *= 2;
+    uint8_t* grown = realloc(list->packed, new_cap);
+    if (!grown) return -1;
+    list->packed = grown;
+    *packed_cap = new_cap;
+  }
+  if (list->count + 2 > *offsets_cap) {
+    int new_cap = *offsets_cap ? *offsets_cap * 2 : 256;
+    uint32_t* grown = realloc(list->offsets, sizeof(uint32_t) * new_cap);
+    if (!grown) return -1;
+    list->offsets = grown;
+    uint8_t* grown_difficulty = realloc(list->difficulty, new_cap);
+    if (!grown_difficulty) return -1;
+    list->difficulty = grown_difficulty;
+    *offsets_cap = new_cap;
+  }
+
+  list->offsets[list->count] = (uint32_t)list->packed_len;
+  list->difficulty[list->count] = difficulty;
+  list->packed[list->packed_len++] = (uint8_t)len;
+  memcpy(list->packed + list->packed_len, word, len);
+  list->packed_len += len;
+  list->count++;
+  list->offsets[list->count] = (uint32_t)list->packed_len;
+  return 0;
+}
+
+// 난이도 점수가 없는 단어: 글자 수, 드문 글자, 기호로 추정 (UTF-8 한 글자는 한 번만 셈)
+static uint8_t estimate_difficulty(const char* word, size_t len) {
+  int score = 0;
+  for (size_t i = 0; i < len; i++) {
+    unsigned char c = (unsigned char)word[i];
+    if ((c & 0xC0) == 0x80) continue;  // UTF-8 이어지는 바이트
+    score += 12;
+    if (c != '\0' && c < 0x80 && strchr("jqxzkvwyJQXZKVWY", c) != NULL) {
+      score += 16;
+    } else if (c < 0x80 && !isalpha(c)) {
+      score += 24;
+    }
+  }
+  return (uint8_t)(score > 255 ? 255 : score);
+}
+
+// "단어<TAB>점수" 의 점수 부분 (0~255 정수가 아니면 추정값 사용)
+static uint8_t parse_difficulty(const char* text, size_t len, const char* word, size_t word_len) {
+  int score = 0;
+  if (len == 0 || len > 3) return estimate_difficulty(word, word_len);
+  for (size_t i = 0; i < len; i++) {
+    if (!isdigit((unsigned char)text[i])) return estimate_difficulty(word, word_len);
+    score = score * 10 + (text[i] - '0');
+  }
+  return (uint8_t)(score > 255 ? 255 : score);
+}
+
+static int word_index_key(int band, size_t len) { return band * MAX_WORD_STR_LEN + (int)len; }
+
+// (난이도 구간, 길이) 색인을 계수 정렬로 만듦 (같은 키 안에서는 파일 순서 유지)
+static int build_word_index(WordList* list) {
+  list->by_band_length = malloc(sizeof(uint32_t) * (list->count > 0 ? list->count : 1));
+  if (!list->by_band_length) return -1;
+
+  uint32_t* start = list->index_start;
+  memset(start, 0, sizeof(list->index_start));
+  for (int i = 0; i < list->count; i++) {
+    size_t len = list->offsets[i + 1] - list->offsets[i] - 1;
+    start[word_index_key(WORD_DIFFICULTY_BAND(list->difficulty[i]), len) + 1]++;
+  }
+  for (int k = 0; k < WORD_INDEX_KEYS; k++) {
+    start[k + 1] += start[k];
+  }
+
+  uint32_t fill[WORD_INDEX_KEYS];
+  memcpy(fill, start, sizeof(fill));
+  for (int i = 0; i < list->count; i++) {
+    size_t len = list->offsets[i + 1] - list->offsets[i] - 1;
+    list->by_band_length[fill[word_index_key(WORD_DIFFICULTY_BAND(list->difficulty[i]), len)]++] = (uint32_t)i;
+  }
+  return 0;
+}
+
+/*
+ * 열린 파일을 mmap 으로 읽어 새 목록을 만듦 (게시 전이므로 다른 스레드는 보지 못함)
+ * 한 줄에 단어 하나, 선택적으로 "단어<TAB>난이도(0~255)"
+ * 큰 사전도 read 복사 없이 페이지 캐시에서 바로 아레나로 옮기고 바로 해제
+ * (읽는 도중 파일이 잘리면 SIGBUS 가 날 수 있으므로 실행 중 교체는 rename 을 권장)
+ * 반환값: 목록 (단어가 0 개일 수 있음), 실패 시 NULL
+ */
+static WordList* read_word_list(int fd) {
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    LOG_ERROR("fstat failed: %m");
+    return NULL;
+  }
+
+  WordList* list = calloc(1, sizeof(WordList));
+  if (!list) return NULL;
+
+  size_t size = (size_t)st.st_size;
+  const char* data = NULL;
+  if (size > 0) {
+    data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED) {
+      LOG_ERROR("mmap failed: %m");
+      free(list);
+      return NULL;
+    }
+    madvise((void*)data, size, MADV_SEQUENTIAL);
+  }
+
+  size_t packed_cap = 0;
+  int offsets_cap = 0;
+  const char* end = data + size;
+  for (const char* line = data; line < end;) {
+    const char* newline = memchr(line, '\n', (size_t)(end - line));
+    size_t line_length = (size_t)((newline ? newline : end) - line);
+    const char* next = newline ? newline + 1 : end;
+    if (line_length > 0 && line[line_length - 1] == '\r') line_length--;
+
+    const char* tab = memchr(line, '\t', line_length);
+    size_t word_length = tab ? (size_t)(tab - line) : line_length;
+
+    /* 빈 줄이 아니고 유효한 길이면 추가 */
+    if (word_length > 0 && word_length < MAX_WORD_STR_LEN && memchr(line, '\0', word_length) == NULL) {
+      uint8_t difficulty =
+          tab ? parse_difficulty(tab + 1, line_length - word_length - 1, line, word_length) : estimate_difficulty(line, word_length);
+      if (append_packed_word(list, &packed_cap, &offsets_cap, line, word_length, difficulty) != 0) {
+        LOG_ERROR("Failed to grow word store: %m");
+        munmap((void*)data, size);
+        free_word_list(list);
+        return NULL;
+      }
+      /* 기존 고정 크기 응답에는 앞쪽 단어만 */
+      if (list->legacy.count < MAX_WORDLIST_WORDS) {
+        memcpy(list->legacy.words[list->legacy.count], line, word_length);
+        list->legacy.words[list->legacy.count][word_length] = '\0';
+        list->legacy.count++;
+      }
+    }
+    line = next;
+  }
+  if (data) munmap((void*)data, size);
+
+  if (build_word_index(list) != 0) {
+    LOG_ERROR("Failed to build word index: %m");
+    free_word_list(list);
+    return NULL;
+  }
+  list->etag = wire_wordlist_etag(list->packed, list->packed_len);
+  return list;
+}
+
+// 모든 읽기 구간이 fresh 게시 이후의 것이 될 때까지 대기
+static void wait_for_readers(void) {
+  for (int i = 0; i < 2; i++) {
+    unsigned int old_slot = __atomic_fetch_add(&reader_epoch, 1, __ATOMIC_SEQ_CST) & 1;
+    while (__atomic_load_n(&reader_counts[old_slot].count, __ATOMIC_SEQ_CST) != 0) {
+      usleep(100);
+    }
+  }
+}
+
+// 새 목록 게시 후 이전 목록을 읽는 쪽이 모두 끝나면 해제
+static void publish_word_list(WordList* fresh) {
+  static uint64_t generation = 0;
+  fresh->generation = ++generation;  // 게시는 로드/감시 스레드에서 차례로만 일어남
+  WordList* old = __atomic_exchange_n(&current_list, fresh, __ATOMIC_SEQ_CST);
+  if (old) {
+    wait_for_readers();
+    free_word_list(old);
+  }
+}
+
+const WordList* word_list_acquire(int* read_slot) {
+  int slot = (int)(__atomic_load_n(&reader_epoch, __ATOMIC_SEQ_CST) & 1);
+  __atomic_add_fetch(&reader_counts[slot].count, 1, __ATOMIC_SEQ_CST);
+  *read_slot = slot;
+  return __atomic_load_n(&current_list, __ATOMIC_SEQ_CST);
+}
+
+void word_list_release(int read_slot) { __atomic_sub_fetch(&reader_counts[read_slot].count, 1, __ATOMIC_RELEASE); }
+
+const uint8_t* word_list_packed_range(const WordList* list, int start, size_t max_bytes, int* count, size_t* bytes) {
+  *count = 0;
+  *bytes = 0;
+  if (start < 0 || start >= list->count) {
+    return NULL;
+  }
+
+  // offsets 는 증가 수열이므로 max_bytes 안에 들어가는 마지막 단어를 이진 탐색
+  const uint32_t* offsets = list->offsets;
+  int lo = start, hi = list->count;
+  while (lo < hi) {
+    int mid = lo + (hi - lo + 1) / 2;
+    if (offsets[mid] - offsets[start] <= max_bytes) {
+      lo = mid;
+    } else {
+      hi = mid - 1;
+    }
+  }
+
+  *count = lo - start;
+  *bytes = offsets[lo] - offsets[start];
+  return list->packed + offsets[start];
+}
+
+// 표본 추출용 난수 (스레드마다 따로, xorshift64*)
+static uint64_t sample_rand(void) {
+  static __thread uint64_t state = 0;
+  if (state == 0) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    state = ((uint64_t)ts.tv_nsec << 20) ^ (uint64_t)ts.tv_sec ^ (uint64_t)(uintptr_t)&state;
+    if (state == 0) state = 0x9E3779B97F4A7C15ULL;
+  }
+  state ^= state >> 12;
+  state ^= state << 25;
+  state ^= state >> 27;
+  return state * 0x2545F4914F6CDD1DULL;
+}
+
+/* Floyd 표본 추출에서 이미 고른 위치 (열린 주소 집합, 값 + 1 을 저장하고 0 은 빈 칸) */
+#define SAMPLE_SET_SIZE (WORD_SAMPLE_MAX * 2)
+
+static bool sample_set_insert(uint32_t* set, uint32_t value) {
+  uint32_t pos = (value * 2654435761u) & (SAMPLE_SET_SIZE - 1);
+  while (set[pos] != 0) {
+    if (set[pos] == value + 1) return false;
+    pos = (pos + 1) & (SAMPLE_SET_SIZE - 1);
+  }
+  set[pos] = value + 1;
+  return true;
+}
+
+int word_list_sample(const WordList* list, int band, int min_len, int max_len, uint32_t* out, int max_count, uint32_t* available) {
+  if (min_len < 1) min_len = 1;
+  if (max_len <= 0 || max_len > MAX_WORD_STR_LEN - 1) max_len = MAX_WORD_STR_LEN - 1;
+  if (max_count > WORD_SAMPLE_MAX) max_count = WORD_SAMPLE_MAX;
+
+  // 구간마다 길이 범위는 색인에서 연속 구간 하나 → 구간들을 이어 붙인 가상 범위 [0, total) 에서 뽑음
+  uint32_t range_start[WORD_BAND_COUNT], range_len[WORD_BAND_COUNT];
+  int ranges = 0;
+  uint32_t total = 0;
+  for (int b = 0; b < WORD_BAND_COUNT && min_len <= max_len; b++) {
+    if (band != WORD_BAND_ANY && band != b) continue;
+    uint32_t begin = list->index_start[word_index_key(b, (size_t)min_len)];
+    uint32_t end = list->index_start[word_index_key(b, (size_t)max_len) + 1];
+    if (end > begin) {
+      range_start[ranges] = begin;
+      range_len[ranges] = end - begin;
+      total += end - begin;
+      ranges++;
+    }
+  }
+  *available = total;
+
+  int picked = max_count < 0 ? 0 : (uint32_t)max_count < total ? max_count : (int)total;
+  if ((uint32_t)picked == total) {
+    for (int i = 0; i < picked; i++) out[i] = (uint32_t)i;
+  } else {
+    // Floyd: 위치 picked 개를 중복 없이 (total 에 비례한 메모리 없이)
+    uint32_t set[SAMPLE_SET_SIZE] = {0};
+    int n = 0;
+    for (uint32_t j = total - (uint32_t)picked; j < total; j++) {
+      uint32_t t = (uint32_t)(sample_rand() % (j + 1));
+      if (!sample_set_insert(set, t)) {
+        t = j;  // t 를 이미 골랐으면 j (이번 단계에서 처음 후보가 된 위치)
+        sample_set_insert(set, j);
+      }
+      out[n++] = t;
+    }
+  }
+
+  // Floyd 결과는 순서가 치우치므로 섞은 뒤 가상 위치 → 단어 번호
+  for (int i = picked - 1; i > 0; i--) {
+    int j = (int)(sample_rand() % (uint64_t)(i + 1));
+    uint32_t tmp = out[i];
+    out[i] = out[j];
+    out[j] = tmp;
+  }
+  for (int i = 0; i < picked; i++) {
+    uint32_t v = out[i];
+    int r = 0;
+    while (v >= range_len[r]) v -= range_len[r++];
+    out[i] = list->by_band_length[range_start[r] + v];
+  }
+  return picked;
+}
+
+static uint32_t gcd_u32(uint32_t a, uint32_t b) {
+  while (b != 0) {
+    uint32_t t = a % b;
+    a = b;
+    b = t;
+  }
+  return a;
+}
+
+// 새 순열: size 와 서로소인 step, 임의의 시작 offset
+static void word_stream_shuffle(WordStreamCursor* cursor) {
+  cursor->position = 0;
+  if (cursor->size <= 1) {
+    cursor->step = 1;
+    cursor->offset = 0;
+    return;
+  }
+  uint32_t step = 1 + (uint32_t)(sample_rand() % (cursor->size - 1));
+  while (gcd_u32(step, cursor->size) != 1) {
+    step = step + 1 < cursor->size ? step + 1 : 1;
+  }
+  cursor->step = step;
+  cursor->offset = (uint32_t)(sample_rand() % cursor->size);
+}
+
+void word_stream_reset(WordStreamCursor* cursor, const WordList* list, int band) {
+  // 색인은 구간 순으로 정렬되어 있어 한 구간 (모든 길이) 은 연속 구간 하나, 전체는 [0, count)
+  uint32_t begin = 0, end = (uint32_t)list->count;
+  if (band >= 0 && band < WORD_BAND_COUNT) {
+    begin = list->index_start[word_index_key(band, 0)];
+    end = list->index_start[word_index_key(band + 1, 0)];
+  } else {
+    band = WORD_BAND_ANY;
+  }
+  cursor->generation = list->generation;
+  cursor->band = band;
+  cursor->begin = begin;
+  cursor->size = end - begin;
+  word_stream_shuffle(cursor);
+}
+
+int word_stream_next(WordStreamCursor* cursor, const WordList* list, uint32_t* out, int max_count, uint32_t* available) {
+  if (cursor->generation != list->generation) {
+    word_stream_reset(cursor, list, cursor->generation == 0 ? WORD_BAND_ANY : cursor->band);
+  }
+  *available = cursor->size;
+  if (cursor->size == 0 || max_count <= 0) return 0;
+  if (max_count > WORD_SAMPLE_MAX) max_count = WORD_SAMPLE_MAX;
+
+  for (int i = 0; i < max_count; i++) {
+    if (cursor->position == cursor->size) word_stream_shuffle(cursor);
+    uint32_t pos = (uint32_t)(((uint64_t)cursor->position * cursor->step + cursor->offset) % cursor->size);
+    cursor->position++;
+    out[i] = list->by_band_length[cursor->begin + pos];
+  }
+  return max_count;
+}
+
 /* ---------------------------------------------------------------
  *  load_wordlist_from_file
- *  - path 위치의 텍스트 파일을 한 줄씩 읽어 단어 배열에 저장
+ *  - path 위치의 텍스트 파일을 한 줄씩 읽어 단어 목록을 만들고 게시
  *  - 파일이 없거나(ENOENT) 0개 읽힌 경우 → 기본 단어 목록을
  *    파일에 써 넣고 다시 읽는다.
  *  - 성공 시 읽은 단어 개수(>=1), 실패 시 음수 반환
@@ -98,7 +463,7 @@ reload:
   // 파일 존재 및 크기 확인
   if (is_file_empty(path) == 1) {
     // 파일이 비어있으면 기본 목록으로 채우고 다시 로드
-    printf("[WORD_MANAGER] Empty words file detected. Writing default words.\n");
+    LOG_WARN("Empty words file detected. Writing default words.");
     if (write_default_words_to_file(path) != 0) {
       return -1;
     }
@@ -108,50 +473,180 @@ reload:
   if (fd == -1) {
     /* 파일이 없으면 새로 만들고 기본 목록 기록 */
     if (errno == ENOENT) {
-      printf("[WORD_MANAGER] Words file not found. Creating with default words.\n");
+      LOG_WARN("Words file not found. Creating with default words.");
       if (write_default_words_to_file(path) != 0) {
         return -1;
       }
       /* 다시 읽기 시도 */
       fd = open(path, O_RDONLY);
       if (fd == -1) {
-        perror("[WORD_MANAGER] Failed to reopen created words file");
+        LOG_ERROR("Failed to reopen created words file: %m");
         return -1;
       }
     } else {
-      perror("[WORD_MANAGER] Failed to open words file");
+      LOG_ERROR("Failed to open words file: %m");
       return -1; /* 기타 에러 */
     }
   }
 
-  g_wordlist.count = 0;
-  char line_buffer[MAX_WORD_STR_LEN + 2];  // 단어 + 개행 + null
-  ssize_t line_length;
-
-  while (g_wordlist.count < MAX_WORDLIST_WORDS && (line_length = read_line_direct(fd, line_buffer, sizeof(line_buffer))) > 0) {
-    /* --- 줄 끝 개행‧CR 제거 --- */
-    char* nl = strpbrk(line_buffer, "\r\n");
-    if (nl) *nl = '\0';
-
-    /* 빈 줄이 아니고 유효한 길이면 추가 */
-    if (line_buffer[0] != '\0' && strlen(line_buffer) < MAX_WORD_STR_LEN) {
-      strncpy(g_wordlist.words[g_wordlist.count], line_buffer, MAX_WORD_STR_LEN - 1);
-      g_wordlist.words[g_wordlist.count][MAX_WORD_STR_LEN - 1] = '\0';
-      g_wordlist.count++;
-    }
-  }
-
+  WordList* list = read_word_list(fd);
   close(fd);
+  if (!list) {
+    return -1;
+  }
 
   /* 읽은 단어가 0개라면 → 기본 목록 파일에 덮어쓰고 다시 로드 */
-  if (g_wordlist.count == 0) {
-    printf("[WORD_MANAGER] No valid words loaded. Writing default words and retrying.\n");
+  if (list->count == 0) {
+    free_word_list(list);
+    LOG_WARN("No valid words loaded. Writing default words and retrying.");
     if (write_default_words_to_file(path) != 0) {
       return -1;
     }
     goto reload;
   }
 
-  printf("[WORD_MANAGER] Successfully loaded %d words from %s\n", g_wordlist.count, path);
-  return g_wordlist.count; /* ≥1 보장 */
-}
\ No newline at end of file
+  int count = list->count;
+  LOG_INFO("Successfully loaded %d words from %s (etag %016llx)", count, path, (unsigned long long)list->etag);
+  publish_word_list(list);
+  return count; /* ≥1 보장 */
+}
+
+/* ---------------------------------------------------------------
+ *  리로드 감시 스레드
+ * ------------------------------------------------------------- */
+
+static char watch_path[1024];
+static pthread_t watcher_thread;
+static bool watcher_running = false;
+static bool watcher_stop = false;
+static int wake_fd = -1; /* 리로드 요청 / 정지 알림 */
+
+// 실행 중 리로드: 시작 시 로드와 달리 파일을 고쳐 쓰지 않고, 쓸 만한 목록이 아니면 기존 목록 유지
+static void reload_word_list(void) {
+  int fd = open(watch_path, O_RDONLY);
+  if (fd == -1) {
+    LOG_WARN("Reload skipped, cannot open words file: %m");
+    return;
+  }
+  WordList* list = read_word_list(fd);
+  close(fd);
+
+  if (!list || list->count == 0) {
+    LOG_WARN("Reload skipped, no valid words in %s (keeping current list)", watch_path);
+    free_word_list(list);
+    return;
+  }
+  if (list->etag == current_list->etag && list->count == current_list->count &&
+      memcmp(list->difficulty, current_list->difficulty, (size_t)list->count) == 0) {
+    free_word_list(list);  // 내용이 같으면 클라이언트 캐시를 깨지 않도록 그대로 둠
+    return;
+  }
+
+  LOG_INFO("Reloaded %d words from %s (etag %016llx)", list->count, watch_path, (unsigned long long)list->etag);
+  publish_word_list(list);
+}
+
+// inotify 이벤트 중 감시하는 파일 이름이 있는지 확인 (읽을 이벤트가 없을 때까지 모두 소비)
+static bool drain_inotify_events(int inotify_fd, const char* file_name) {
+  char buf[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+  bool matched = false;
+  ssize_t len;
+  while ((len = read(inotify_fd, buf, sizeof(buf))) > 0) {
+    for (char* p = buf; p < buf + len;) {
+      const struct inotify_event* ev = (const struct inotify_event*)p;
+      if (ev->len > 0 && strcmp(ev->name, file_name) == 0) {
+        matched = true;
+      }
+      p += sizeof(struct inotify_event) + ev->len;
+    }
+  }
+  return matched;
+}
+
+static void* wordlist_watcher_func(void* arg) {
+  (void)arg;
+
+  // 파일 자체가 아니라 디렉터리를 감시해야 rename 으로 교체되는 경우도 잡힘
+  char dir_buf[sizeof(watch_path)], name_buf[sizeof(watch_path)];
+  snprintf(dir_buf, sizeof(dir_buf), "%s", watch_path);
+  snprintf(name_buf, sizeof(name_buf), "%s", watch_path);
+  const char* dir = dirname(dir_buf);
+  const char* file_name = basename(name_buf);
+
+  int inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (inotify_fd != -1 && inotify_add_watch(inotify_fd, dir, IN_CLOSE_WRITE | IN_MOVED_TO) == -1) {
+    close(inotify_fd);
+    inotify_fd = -1;
+  }
+  if (inotify_fd == -1) {
+    LOG_WARN("inotify unavailable, reload on SIGHUP only: %m");
+  }
+
+  struct pollfd fds[2] = {{wake_fd, POLLIN, 0}, {inotify_fd, POLLIN, 0}};
+  while (!__atomic_load_n(&watcher_stop, __ATOMIC_ACQUIRE)) {
+    if (poll(fds, inotify_fd != -1 ? 2 : 1, -1) < 0) {
+      if (errno == EINTR) continue;
+      LOG_ERROR("poll failed: %m");
+      break;
+    }
+
+    bool reload = false;
+    uint64_t value;
+    if ((fds[0].revents & POLLIN) && read(wake_fd, &value, sizeof(value)) == sizeof(value)) {
+      reload = true;
+    }
+    if (inotify_fd != -1 && (fds[1].revents & POLLIN) && drain_inotify_events(inotify_fd, file_name)) {
+      reload = true;
+    }
+    if (reload && !__atomic_load_n(&watcher_stop, __ATOMIC_ACQUIRE)) {
+      reload_word_list();
+    }
+  }
+
+  if (inotify_fd != -1) close(inotify_fd);
+  return NULL;
+}
+
+int start_wordlist_watcher(const char* path) {
+  snprintf(watch_path, sizeof(watch_path), "%s", path);
+  wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (wake_fd == -1) {
+    LOG_ERROR("eventfd failed: %m");
+    return -1;
+  }
+
+  __atomic_store_n(&watcher_stop, false, __ATOMIC_RELEASE);
+  if (pthread_create(&watcher_thread, NULL, wordlist_watcher_func, NULL) != 0) {
+    LOG_ERROR("Failed to create watcher thread: %m");
+    close(wake_fd);
+    wake_fd = -1;
+    return -1;
+  }
+  watcher_running = true;
+  LOG_INFO("Watching %s for changes (SIGHUP also reloads).", path);
+  return 0;
+}
+
+void request_wordlist_reload(void) {
+  /* eventfd 에 write 만 하므로 시그널 핸들러에서 안전 */
+  uint64_t one = 1;
+  if (wake_fd != -1) {
+    ssize_t ignored = write(wake_fd, &one, sizeof(one));
+    (void)ignored;
+  }
+}
+
+void stop_wordlist_watcher(void) {
+  if (watcher_running) {
+    __atomic_store_n(&watcher_stop, true, __ATOMIC_RELEASE);
+    request_wordlist_reload();
+    pthread_join(watcher_thread, NULL);
+    watcher_running = false;
+  }
+  if (wake_fd != -1) {
+    close(wake_fd);
+    wake_fd = -1;
+  }
+
+  free_word_list(__atomic_exchange_n(&current_list, NULL, __ATOMIC_SEQ_CST));
+}
@@ -0,0 +1,129 @@
+// server/src/worker_pool.c
+#include "worker_pool.h"
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "server_log.h"
+
+#define LOG_MODULE "WORKER_POOL"
+
+#define MAX_WORKER_THREADS 256
+
+typedef struct {
+  WorkerTaskFunc func;
+  void* arg;
+} WorkerTask;
+
+/* 여러 생산자(리액터) / 여러 소비자(워커)가 공유하는 고정 크기 원형 큐 */
+static WorkerTask* task_queue = NULL;
+static int queue_capacity = 0;
+static int queue_head = 0;
+static int queue_count = 0;
+
+static pthread_mutex_t queue_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t queue_not_empty = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t queue_not_full = PTHREAD_COND_INITIALIZER;
+static bool pool_running = false;
+
+static pthread_t workers[MAX_WORKER_THREADS];
+static int worker_count = 0;
+
+static void* worker_thread_func(void* arg) {
+  (void)arg;
+
+  while (1) {
+    pthread_mutex_lock(&queue_mutex);
+    while (queue_count == 0 && pool_running) {
+      pthread_cond_wait(&queue_not_empty, &queue_mutex);
+    }
+    if (queue_count == 0 && !pool_running) {
+      pthread_mutex_unlock(&queue_mutex);
+      break;  // 정지 요청 + 남은 작업 없음
+    }
+
+    WorkerTask task = task_queue[queue_head];
+    queue_head = (queue_head + 1) % queue_capacity;
+    queue_count--;
+    pthread_cond_signal(&queue_not_full);
+    pthread_mutex_unlock(&queue_mutex);
+
+    task.func(task.arg);
+  }
+  return NULL;
+}
+
+int worker_pool_start(int num_workers, int capacity) {
+  if (num_workers < 1) num_workers = 1;
+  if (num_workers > MAX_WORKER_THREADS) num_workers = MAX_WORKER_THREADS;
+  if (capacity < 1) capacity = 1;
+
+  task_queue = calloc(capacity, sizeof(WorkerTask));
+  if (!task_queue) {
+    LOG_ERROR("calloc for task queue failed: %m");
+    return -1;
+  }
+  queue_capacity = capacity;
+  queue_head = 0;
+  queue_count = 0;
+  pool_running = true;
+
+  for (worker_count = 0; worker_count < num_workers; worker_count++) {
+    if (pthread_create(&workers[worker_count], NULL, worker_thread_func, NULL) != 0) {
+      LOG_ERROR("pthread_create() error: %m");
+      break;
+    }
+  }
+
+  if (worker_count == 0) {
+    pool_running = false;
+    free(task_queue);
+    task_queue = NULL;
+    return -1;
+  }
+
+  LOG_INFO("Started %d worker(s), queue capacity %d.", worker_count, queue_capacity);
+  return 0;
+}
+
+int worker_pool_submit(WorkerTaskFunc func, void* arg) {
+  pthread_mutex_lock(&queue_mutex);
+  while (queue_count == queue_capacity && pool_running) {
+    pthread_cond_wait(&queue_not_full, &queue_mutex);
+  }
+  if (!pool_running) {
+    pthread_mutex_unlock(&queue_mutex);
+    return -1;
+  }
+
+  int tail = (queue_head + queue_count) % queue_capacity;
+  task_queue[tail].func = func;
+  task_queue[tail].arg = arg;
+  queue_count++;
+  pthread_cond_signal(&queue_not_empty);
+  pthread_mutex_unlock(&queue_mutex);
+  return 0;
+}
+
+void worker_pool_stop(void) {
+  pthread_mutex_lock(&queue_mutex);
+  if (!pool_running) {
+    pthread_mutex_unlock(&queue_mutex);
+    return;
+  }
+  pool_running = false;
+  pthread_cond_broadcast(&queue_not_empty);
+  pthread_cond_broadcast(&queue_not_full);
+  pthread_mutex_unlock(&queue_mutex);
+
+  for (int i = 0; i < worker_count; i++) {
+    pthread_join(workers[i], NULL);
+  }
+  worker_count = 0;
+
+  free(task_queue);
+  task_queue = NULL;
+  queue_capacity = 0;
+  LOG_INFO("All workers stopped.");
+}